@@ -0,0 +1,484 @@
+/******************************************************************************
+*                                                                             *
+*                                                                             *
+*                                                                             *
+*******************************************************************************
+*                                                                             *
+* Project     :   SCHEDULER SIMULATOR
+*                                                                             *
+* File Name   :  batch.c                                                      *
+*                                                                             *
+* Description :  Headless batch runs (PC build only). Runs a range of test    *
+*                cases set up from the command line, without the terminal,   *
+*                and returns an exit code for the calling script.            *
+*                                                                             *
+*                Usage: SchedSim [options]                                    *
+*                  -c first[-last]  test cases to run (default all)           *
+*                  -a algorithm     override the test case algorithm          *
+*                  -d duration      override the test case duration           *
+*                  -o prefix        prefix for the results file names, up to  *
+*                                   82 characters                             *
+*                  -l file          log file (default log.txt)                *
+*                  -t               tick by tick, not event driven            *
+*                  -p               heap ready queue                          *
+*                  -w               timing wheel idle and waiting queues      *
+*                  -b               binary trace, "Test case nnn.trc"         *
+*                  -r               change only binary trace                  *
+*                  -q               quiet, verbose messages off               *
+*                  -g               debug messages on                         *
+*                  -h               this help                                 *
+*                                                                             *
+*******************************************************************************
+* Modification record:                                                        *
+*                                                                             *
+* Date     |Who| Description                                                  *
+* 17-10-26 |JRO| Created                                                      *
+* 17-10-26 |JRO| Task table freed at the end of the run                       *
+* 17-10-26 |JRO| Added -p option - heap ready queue                           *
+* 17-10-26 |JRO| Added -w option - timing wheel idle and waiting queues       *
+* 17-10-26 |JRO| Added -b option - binary results trace                       *
+* 17-10-26 |JRO| Added -r option - change only binary trace                   *
+* 17-10-26 |JRO| -o prefix limited to what the results file name holds        *
+*          |   |                                                              *
+*                                                                             *
+******************************************************************************/
+#include "globals.h"
+#include "messages_out.h"
+#include "task.h"          /* task object                   */
+#include "scheduler.h"     /* main scheduler                */
+#include "test.h"          /* test manager                  */
+#include "test_case.h"     /* test case container           */
+#include "context.h"       /* simulation context            */
+#include "batch.h"         /* interface file                */
+
+#ifndef DEV_SYSTEM
+	/*lint -e85 has dimension 0 */
+    #include <stdio.h>     /* gcc output libraries          */
+	/*lint +e85 has dimension 0 */
+    #include <stdlib.h>    /* strtoul()                     */
+    #include <string.h>    /* strlen()                      */
+
+/* batch run settings, from the command line */
+struct batch_options_type
+{
+    U8      first_test_case;           /* first test case to run      */
+    U8      last_test_case;            /* last test case to run       */
+    U32     algorithm;                 /* algorithm, 0 for test case  */
+    U32     duration;                  /* duration, 0 for test case   */
+    S8     *results_prefix;            /* results file name prefix    */
+    boolean event_mode;                /* event driven time advance   */
+    q_kind_type ready_q_kind;          /* ready queue list or heap    */
+    q_kind_type release_q_kind;        /* idle/waiting list or wheel  */
+    S8     *results_extension;         /* results file name extension */
+    boolean help;                      /* help asked for              */
+};
+
+static struct sim_context_type batch_context;
+
+/******************************************************************************
+*  PRIVATE FUNCTION PROTOTYPES
+******************************************************************************/
+static boolean read_options( const S32 argc, S8 *argv[],
+                             struct batch_options_type *options );
+static boolean read_number( const S8 *arg, const U32 min, const U32 max,
+                            U32 *value );
+static boolean read_range( const S8 *arg, struct batch_options_type *options );
+static S32 run_test_case( const U8 test_case,
+                          const struct batch_options_type *options );
+static void print_usage( void );
+
+#endif /* DEV_SYSTEM */
+
+
+/******************************************************************************
+*                              PUBLIC FUNCTIONS
+******************************************************************************/
+
+
+/******************************************************************************
+*  Function    : BAT_run
+*  Description : runs the test cases requested on the command line
+*  Parameters  : argc - number of command line arguments
+*                argv - command line arguments
+*  Returns     : BAT_EXIT_OK, BAT_EXIT_USAGE or BAT_EXIT_OUTPUT
+******************************************************************************/
+S32 BAT_run( const S32 argc, S8 *argv[] )
+{
+#ifndef DEV_SYSTEM
+    struct batch_options_type options;
+    S32 status = BAT_EXIT_OK;
+    U8  test_case;
+
+    if( read_options( argc, argv, &options ) is FALSE )
+    {
+        print_usage();
+        status = BAT_EXIT_USAGE;
+    }
+    else if( options.help is TRUE )
+    {
+        print_usage();
+    }
+    else
+    {
+        for( test_case=options.first_test_case;
+             test_case<=options.last_test_case;
+             test_case++ )
+        {
+            if( run_test_case( test_case, &options ) is_not BAT_EXIT_OK )
+            {
+                status = BAT_EXIT_OUTPUT;
+            }
+        }
+
+        TSK_close( &batch_context );
+        SCH_close( &batch_context );
+    }
+
+    return( status );
+#else
+    return( BAT_EXIT_USAGE );
+#endif
+
+} /* BAT_run() */
+
+
+/******************************************************************************
+*                            PRIVATE FUNCTIONS
+******************************************************************************/
+
+#ifndef DEV_SYSTEM
+
+/******************************************************************************
+*  Function    : read_options
+*  Description : private helper - reads the command line into the batch
+*                options, applying message options straight away
+*  Parameters  : argc    - number of command line arguments
+*                argv    - command line arguments
+*                options - returned batch options
+*  Returns     : FALSE if the command line is not valid
+******************************************************************************/
+static boolean read_options( const S32 argc, S8 *argv[],
+                             struct batch_options_type *options )
+{
+    const U32 max_duration = 0xffff;
+    const U32 max_prefix   = MAX_NAME_LEN - sizeof( "Test case nnn.ext" );
+    boolean valid = TRUE;
+    S32 index;
+
+    /* defaults - run all test cases as set up */
+    options->first_test_case = ONE_CPV;
+    options->last_test_case  = MAX_TEST_CASES - ONE_CPV;
+    options->algorithm       = ZERO_CPV;
+    options->duration        = ZERO_CPV;
+    options->results_prefix  = (S8*)"";
+    options->event_mode      = TRUE;
+    options->ready_q_kind    = Q_LIST;
+    options->release_q_kind  = Q_LIST;
+    options->results_extension = (S8*)"txt";
+    options->help            = FALSE;
+
+    for( index=ONE_CPV; (index<argc)and(valid is TRUE); index++ )
+    {
+        if( (argv[index][ZERO_CPV] is_not '-') or
+            (argv[index][ONE_CPV] is '\0') or
+            (argv[index][TWO_CPV] is_not '\0') )
+        {
+            valid = FALSE;
+        }
+        else
+        {
+            switch( argv[index][ONE_CPV] )
+            {
+                /* options with a value */
+                case 'c':
+                case 'a':
+                case 'd':
+                case 'o':
+                case 'l':
+                    if( (index + ONE_CPV) >= argc )
+                    {
+                        valid = FALSE;
+                    }
+                    else
+                    {
+                        index++;
+
+                        switch( argv[index - ONE_CPV][ONE_CPV] )
+                        {
+                            case 'c':
+                                valid = read_range( argv[index], options );
+                                break;
+                            case 'a':
+                                valid = read_number( argv[index], ONE_CPV,
+                                                     (U32)ALG_MAX_ALG,
+                                                     &options->algorithm );
+                                break;
+                            case 'd':
+                                valid = read_number( argv[index], ONE_CPV,
+                                                     max_duration,
+                                                     &options->duration );
+                                break;
+                            case 'o':
+                                /* the results file name must fit the */
+                                /* results name kept by messages_out  */
+                                if( (U32)strlen( argv[index] ) > max_prefix )
+                                {
+                                    valid = FALSE;
+                                }
+                                else
+                                {
+                                    options->results_prefix = argv[index];
+                                }
+                                break;
+                            default:
+                                MESS_OUT_name_log_file( argv[index] );
+                                break;
+                        }
+                    }
+                    break;
+
+                case 't':
+                    options->event_mode = FALSE;
+                    break;
+
+                case 'p':
+                    options->ready_q_kind = Q_HEAP;
+                    break;
+
+                case 'w':
+                    options->release_q_kind = Q_WHEEL;
+                    break;
+
+                case 'b':
+                    MESS_OUT_set_trace_mode( TRC_MODE_BINARY );
+                    options->results_extension = (S8*)"trc";
+                    break;
+
+                case 'r':
+                    MESS_OUT_set_trace_mode( TRC_MODE_CHANGES );
+                    options->results_extension = (S8*)"trc";
+                    break;
+
+                case 'q':
+                    MESS_OUT_set_verbose_mode( FALSE );
+                    break;
+
+                case 'g':
+                    MESS_OUT_set_debug_mode( TRUE );
+                    break;
+
+                case 'h':
+                    options->help = TRUE;
+                    break;
+
+                default:
+                    valid = FALSE;
+                    break;
+            } /* end of switch( argv[index][ONE_CPV] ) */
+        }
+
+        if( valid is FALSE )
+        {
+            MESS_OUT_message_S2( (S8*)"BAT_run(): bad option",
+                                 argv[index],
+                                 MESSAGE_OP_ERROR );
+        }
+    }
+
+    return( valid );
+
+} /* read_options() */
+
+
+/******************************************************************************
+*  Function    : read_number
+*  Description : private helper - reads a decimal number from an argument
+*  Parameters  : arg   - argument string
+*                min   - minimum valid value
+*                max   - maximum valid value
+*                value - returned number
+*  Returns     : TRUE if arg is a number between min and max
+******************************************************************************/
+static boolean read_number( const S8 *arg, const U32 min, const U32 max,
+                            U32 *value )
+{
+    char *end;
+    boolean valid = FALSE;
+
+    *value = (U32)strtoul( (const char*)arg, &end, TEN_CPV );
+
+    if( (end is_not (char*)arg) and (*end is '\0') and
+        (*value >= min) and (*value <= max) )
+    {
+        valid = TRUE;
+    }
+
+    return( valid );
+
+} /* read_number() */
+
+
+/******************************************************************************
+*  Function    : read_range
+*  Description : private helper - reads a test case number, or a first and
+*                last test case number as first-last
+*  Parameters  : arg     - argument string
+*                options - batch options to update
+*  Returns     : TRUE if the range is valid
+******************************************************************************/
+static boolean read_range( const S8 *arg, struct batch_options_type *options )
+{
+    const U32 max_case = MAX_TEST_CASES - ONE_CPV;
+    char *end;
+    U32 first;
+    U32 last;
+    boolean valid = FALSE;
+
+    first = (U32)strtoul( (const char*)arg, &end, TEN_CPV );
+
+    if( end is_not (char*)arg )
+    {
+        if( *end is '\0' )
+        {
+            /* single test case */
+            last  = first;
+            valid = TRUE;
+        }
+        else if( *end is '-' )
+        {
+            valid = read_number( (S8*)(end + ONE_CPV), first, max_case, &last );
+        }
+    }
+
+    if( (valid is TRUE) and (first >= ONE_CPV) and (last <= max_case) )
+    {
+        options->first_test_case = (U8)first;
+        options->last_test_case  = (U8)last;
+    }
+    else
+    {
+        valid = FALSE;
+    }
+
+    return( valid );
+
+} /* read_range() */
+
+
+/******************************************************************************
+*  Function    : run_test_case
+*  Description : private helper - loads, runs and reports one test case,
+*                then prints a one line summary to the screen
+*  Parameters  : test_case - test case number
+*                options   - batch options
+*  Returns     : BAT_EXIT_OK, or BAT_EXIT_OUTPUT if the results file could
+*                not be written
+******************************************************************************/
+static S32 run_test_case( const U8 test_case,
+                          const struct batch_options_type *options )
+{
+    struct sim_context_type *ctx = &batch_context;
+    S8 file_name[MAX_LINE_LEN];
+    FILE *file_ptr;
+    S32 status = BAT_EXIT_OK;
+
+    /* start a new results file for the test case */
+    (void)sprintf( file_name, "%sTest case %03d.%s",
+                   options->results_prefix, test_case,
+                   options->results_extension );
+
+    file_ptr = fopen( file_name, (S8*)"w" );
+
+    if( file_ptr is NULL )
+    {
+        MESS_OUT_message_S2( (S8*)"BAT_run(): unable to write",
+                             file_name,
+                             MESSAGE_OP_ERROR );
+        status = BAT_EXIT_OUTPUT;
+    }
+    else
+    {
+        (void)fclose( file_ptr );
+
+        MESS_OUT_rename_results_file( file_name );
+
+        /* queues are switched when they are reset */
+        ctx->ready_q_kind   = options->ready_q_kind;
+        ctx->release_q_kind = options->release_q_kind;
+
+        TST_new_test( ctx, test_case );
+
+        /* command line overrides */
+        ctx->event_mode = options->event_mode;
+        if( options->algorithm > ZERO_CPV )
+        {
+            SCH_set_algorithm( ctx, (algorithm_type)(options->algorithm - ONE_CPV) );
+        }
+        if( options->duration > ZERO_CPV )
+        {
+            ctx->test_duration = options->duration;
+        }
+
+        /* report test conditions */
+        MESS_OUT_message( (S8*)"Test case:", MESSAGE_OP_RESULTS );
+        TSC_report_test_case( test_case, MESSAGE_OP_RESULTS );
+        TSC_report_test_case_notes( test_case );
+        MESS_OUT_message( (S8*)"Algorithm:", MESSAGE_OP_RESULTS );
+        SCH_what_algorithm( ctx, MESSAGE_OP_RESULTS );
+        MESS_OUT_message_1( (S8*)"Test duration:",
+                            ctx->test_duration,
+                            MESSAGE_OP_RESULTS );
+
+        TSK_start_of_test( ctx );       /* warn task object             */
+
+        TST_run_simulation( ctx );      /* run to the end of the test   */
+
+        TSK_end_of_test( ctx );         /* end of test reports          */
+
+        /* summary line */
+        MESS_OUT_message_4( (S8*)"Test case", test_case,
+                            (S8*)"missed deadlines",
+                            ctx->test_case_report_values[TST_DEADLN_MIS].value,
+                            (S8*)"met deadlines",
+                            ctx->test_case_report_values[TST_DEADLN_MET].value,
+                            (S8*)"achieved util (%)",
+                            ctx->test_case_report_values[TST_UTILITY].value,
+                            MESSAGE_OP_INFO );
+    }
+
+    return( status );
+
+} /* run_test_case() */
+
+
+/******************************************************************************
+*  Function    : print_usage
+*  Description : private helper - prints the command line options
+*  Parameters  : none
+*  Returns     : none
+******************************************************************************/
+static void print_usage( void )
+{
+    MESS_OUT_message( (S8*)"Usage: SchedSim [options]", MESSAGE_OP_INFO );
+    MESS_OUT_message( (S8*)"  no options      - interactive terminal", MESSAGE_OP_INFO );
+    MESS_OUT_message( (S8*)"  -c first[-last] - test cases to run (default all)", MESSAGE_OP_INFO );
+    MESS_OUT_message( (S8*)"  -a algorithm    - override test case algorithm", MESSAGE_OP_INFO );
+    MESS_OUT_message( (S8*)"  -d duration     - override test case duration", MESSAGE_OP_INFO );
+    MESS_OUT_message( (S8*)"  -o prefix       - prefix for results file names", MESSAGE_OP_INFO );
+    MESS_OUT_message( (S8*)"  -l file         - log file (default log.txt)", MESSAGE_OP_INFO );
+    MESS_OUT_message( (S8*)"  -t              - tick by tick, not event driven", MESSAGE_OP_INFO );
+    MESS_OUT_message( (S8*)"  -p              - heap ready queue, a list for MUF and ADAP_03-07", MESSAGE_OP_INFO );
+    MESS_OUT_message( (S8*)"  -w              - timing wheel idle and waiting queues", MESSAGE_OP_INFO );
+    MESS_OUT_message( (S8*)"  -b              - binary trace, see TraceConv", MESSAGE_OP_INFO );
+    MESS_OUT_message( (S8*)"  -r              - change only binary trace", MESSAGE_OP_INFO );
+    MESS_OUT_message( (S8*)"  -q              - quiet, verbose messages off", MESSAGE_OP_INFO );
+    MESS_OUT_message( (S8*)"  -g              - debug messages on", MESSAGE_OP_INFO );
+    MESS_OUT_message( (S8*)"  -h              - this help", MESSAGE_OP_INFO );
+    MESS_OUT_message_3( (S8*)"Exit codes: ok", BAT_EXIT_OK,
+                        (S8*)"usage", BAT_EXIT_USAGE,
+                        (S8*)"results file", BAT_EXIT_OUTPUT,
+                        MESSAGE_OP_INFO );
+
+} /* print_usage() */
+
+#endif /* DEV_SYSTEM */
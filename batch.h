@@ -0,0 +1,31 @@
+/******************************************************************************
+*                                                                             *
+*                                                                             *
+*                                                                             *
+*******************************************************************************
+*                                                                             *
+* Project     :   SCHEDULER SIMULATOR
+*                                                                             *
+* File Name   :  batch.h                                                      *
+*                                                                             *
+* Description :  Interface file for batch.c                                   *
+*                                                                             *
+*******************************************************************************
+* Modification record:                                                        *
+*                                                                             *
+* Date     |Who| Description                                                  *
+* 17-10-26 |JRO| Created                                                      *
+*          |   |                                                              *
+*                                                                             *
+******************************************************************************/
+#ifndef _BATCH_H_
+#define _BATCH_H_
+
+/* batch run exit codes */
+#define BAT_EXIT_OK         0     /* all test cases run               */
+#define BAT_EXIT_USAGE      1     /* bad command line                 */
+#define BAT_EXIT_OUTPUT     2     /* a results file could not be made */
+
+S32 BAT_run( const S32 argc, S8 *argv[] );
+
+#endif /* _BATCH_H_ */
@@ -0,0 +1,678 @@
+/******************************************************************************
+*                                                                             *
+*                                                                             *
+*                                                                             *
+*******************************************************************************
+*                                                                             *
+* Project     :   SCHEDULER SIMULATOR
+*                                                                             *
+* File Name   :  bench.c                                                      *
+*                                                                             *
+* Description :  Scheduler benchmark (PC only), built on its own from         *
+*                SchedBench.msp with the simulator sources less main.c.       *
+*                Runs every written algorithm against synthetic task sets     *
+*                of 8, 64, 512 and 4096 tasks at several utilisations, and    *
+*                reports simulated ticks per second, scheduler decisions      *
+*                (SCH_start() calls) per second and peak memory.              *
+*                                                                             *
+*                The task sets are made from a fixed seed, so a run is the    *
+*                same on every build and the results files can be compared    *
+*                across commits. Each run writes a change only binary trace   *
+*                to a scratch file, which is removed at the end.              *
+*                                                                             *
+*                Usage: SchedBench [options]                                  *
+*                  -a algorithm     benchmark one algorithm (default all)     *
+*                  -s tasks         largest task set (default 4096)           *
+*                  -d duration      test duration (default longest period)    *
+*                  -o name          results files name.csv and name.json      *
+*                                   (default bench)                           *
+*                  -t               tick by tick, not event driven            *
+*                  -p               heap ready queue                          *
+*                  -w               timing wheel idle and waiting queues      *
+*                  -h               this help                                 *
+*                                                                             *
+*******************************************************************************
+* Modification record:                                                        *
+*                                                                             *
+* Date     |Who| Description                                                  *
+* 17-10-26 |JRO| Created                                                      *
+*          |   |                                                              *
+*                                                                             *
+******************************************************************************/
+#include "globals.h"
+#include "initialise.h"
+#include "messages_out.h"
+#include "task.h"          /* task object                   */
+#include "scheduler.h"     /* main scheduler                */
+#include "test.h"          /* test manager                  */
+#include "context.h"       /* simulation context            */
+
+/*lint -e85 has dimension 0 */
+#include <stdio.h>         /* gcc output libraries          */
+/*lint +e85 has dimension 0 */
+#include <stdlib.h>        /* strtoul()                     */
+#include <time.h>          /* clock_gettime()               */
+#ifdef _WIN32
+    #include <windows.h>   /* peak working set              */
+    #include <psapi.h>
+#else
+    #include <sys/resource.h> /* getrusage()                */
+#endif
+
+/* exit codes */
+#define BENCH_EXIT_OK       0     /* all runs made                    */
+#define BENCH_EXIT_USAGE    1     /* bad command line                 */
+#define BENCH_EXIT_OUTPUT   2     /* results files could not be made  */
+
+#define BENCH_SIZES         4     /* task set sizes                   */
+#define BENCH_UTILS         4     /* task set utilisations            */
+#define BENCH_SEED          12345U /* task set generator seed         */
+#define BENCH_MIN_PERIOD    100   /* shortest base period             */
+#define BENCH_MIN_SECONDS   0.2   /* a run is repeated to at least... */
+#define BENCH_MAX_RUNS      1000  /* ...or this many times            */
+
+/* task set sizes, smallest first so the peak memory follows the size */
+static const U32 bench_sizes[BENCH_SIZES] = { 8, 64, 512, 4096 };
+
+/* task set utilisations (%), the last overloads the processor */
+static const U32 bench_utils[BENCH_UTILS] = { 50, 80, 100, 120 };
+
+/* algorithm names for the results files, in algorithm_type order */
+static const char* const bench_alg_names[ALG_MAX_ALG] =
+{
+    "CYC", "RR", "RM", "IRM", "DRM", "EDF", "SPT", "LLF", "MLLF",
+    "MUF", "MMUF", "MMMUF", "D_STAR", "DD_STAR", "D_OVER", "RM_RTO",
+    "EDF_RTO", "EDF_BWP", "ADAP_01", "ADAP_02", "ADAP_03", "ADAP_04",
+    "ADAP_05", "ADAP_06", "ADAP_07"
+};
+
+static const S8* trace_name = (S8*)"Bench trace.trc";
+
+/* benchmark settings, from the command line */
+struct bench_options_type
+{
+    U32     algorithm;                 /* algorithm, 0 for all        */
+    U32     max_tasks;                 /* largest task set to run     */
+    U32     duration;                  /* duration, 0 for default     */
+    S8     *results_name;              /* results file name           */
+    boolean event_mode;                /* event driven time advance   */
+    q_kind_type ready_q_kind;          /* ready queue list or heap    */
+    q_kind_type release_q_kind;        /* idle/waiting list or wheel  */
+    boolean help;                      /* help asked for              */
+};
+
+/* results of one run */
+struct bench_result_type
+{
+    algorithm_type algorithm;          /* algorithm run               */
+    U32     tasks;                     /* tasks in the set            */
+    U32     util;                      /* utilisation asked for (%)   */
+    double  set_util;                  /* utilisation made (%)        */
+    U32     runs;                      /* times the set was run       */
+    U32     ticks;                     /* simulated ticks, all runs   */
+    U32     decisions;                 /* SCH_start() calls, all runs */
+    double  seconds;                   /* run time, all runs          */
+    U32     peak_kb;                   /* process peak memory         */
+    U32     missed;                    /* missed deadlines, last run  */
+    U32     met;                       /* met deadlines, last run     */
+    q_kind_type ready_q_kind;          /* ready queue used, last run  */
+};
+
+static struct sim_context_type bench_context;
+static U32 bench_random;               /* task set generator state    */
+
+/******************************************************************************
+*  PRIVATE FUNCTION PROTOTYPES
+******************************************************************************/
+static boolean read_options( const S32 argc, char *argv[],
+                             struct bench_options_type *options );
+static boolean read_number( const char *arg, const U32 min, const U32 max,
+                            U32 *value );
+static void run_bench( const algorithm_type algorithm, const U32 tasks,
+                       const U32 util, const struct bench_options_type *options,
+                       struct bench_result_type *result );
+static double make_task_set( struct sim_context_type *ctx, const U32 tasks,
+                             const U32 util, U32 *longest_period );
+static U32 next_random( void );
+static double read_seconds( void );
+static U32 read_peak_kb( void );
+static void write_result( FILE *csv, FILE *json, const boolean first,
+                          const struct bench_result_type *result,
+                          const struct bench_options_type *options );
+static void print_usage( void );
+
+
+/******************************************************************************
+*  Function    : main
+*  Description : runs the benchmark set up on the command line
+*  Parameters  : argc - number of command line arguments
+*                argv - command line arguments
+*  Returns     : BENCH_EXIT_OK, BENCH_EXIT_USAGE or BENCH_EXIT_OUTPUT
+******************************************************************************/
+S32 main( S32 argc, char *argv[] )
+{
+    struct bench_options_type options;
+    struct bench_result_type result;
+    S8 file_name[MAX_NAME_LEN];
+    FILE *csv;
+    FILE *json;
+    boolean first = TRUE;
+    S32 status = BENCH_EXIT_OK;
+    U32 size;
+    U32 util;
+    U32 alg;
+
+    INIT_initialise();    /* initialise objects */
+
+    /* the trace is written, but as little of it as there can be */
+    MESS_OUT_set_verbose_mode( FALSE );
+    MESS_OUT_set_trace_mode( TRC_MODE_CHANGES );
+
+    if( read_options( argc, argv, &options ) is FALSE )
+    {
+        print_usage();
+        status = BENCH_EXIT_USAGE;
+    }
+    else if( options.help is TRUE )
+    {
+        print_usage();
+    }
+    else
+    {
+        (void)sprintf( file_name, "%s.csv", options.results_name );
+        csv = fopen( file_name, "w" );
+        (void)sprintf( file_name, "%s.json", options.results_name );
+        json = fopen( file_name, "w" );
+
+        if( (csv is NULL) or (json is NULL) )
+        {
+            MESS_OUT_message_S2( (S8*)"SchedBench: unable to write",
+                                 file_name,
+                                 MESSAGE_OP_ERROR );
+            status = BENCH_EXIT_OUTPUT;
+        }
+        else
+        {
+            (void)fprintf( csv, "algorithm,name,tasks,util,set_util,mode,ready_q,release_q,"
+                                "runs,ticks,decisions,seconds,ticks_per_sec,decisions_per_sec,"
+                                "peak_kb,missed,met\n" );
+            (void)fprintf( json, "[\n" );
+
+            for( size=ZERO_CPV; size<BENCH_SIZES; size++ )
+            {
+                for( util=ZERO_CPV; util<BENCH_UTILS; util++ )
+                {
+                    for( alg=ZERO_CPV; alg<(U32)ALG_MAX_ALG; alg++ )
+                    {
+                        if( (bench_sizes[size] <= options.max_tasks) and
+                            (bench_sizes[size] <= TSK_MAX_TASKS) and
+                            ((options.algorithm is ZERO_CPV) or (options.algorithm is (alg + ONE_CPV))) and
+                            (SCH_algorithm_supported( (algorithm_type)alg ) is TRUE) )
+                        {
+                            run_bench( (algorithm_type)alg, bench_sizes[size],
+                                       bench_utils[util], &options, &result );
+                            write_result( csv, json, first, &result, &options );
+                            first = FALSE;
+                        }
+                    }
+                }
+            }
+
+            (void)fprintf( json, "\n]\n" );
+        }
+
+        if( csv is_not NULL )
+        {
+            (void)fclose( csv );
+        }
+        if( json is_not NULL )
+        {
+            (void)fclose( json );
+        }
+
+        TSK_close( &bench_context );
+        SCH_close( &bench_context );
+    }
+
+    INIT_closedown();     /* shut things down   */
+    (void)remove( trace_name );
+
+    return( status );
+
+} /* main() */
+
+
+/******************************************************************************
+*                            PRIVATE FUNCTIONS
+******************************************************************************/
+
+
+/******************************************************************************
+*  Function    : read_options
+*  Description : private helper - reads the command line into the benchmark
+*                options
+*  Parameters  : argc    - number of command line arguments
+*                argv    - command line arguments
+*                options - returned benchmark options
+*  Returns     : FALSE if the command line is not valid
+******************************************************************************/
+static boolean read_options( const S32 argc, char *argv[],
+                             struct bench_options_type *options )
+{
+    boolean valid = TRUE;
+    S32 index;
+
+    /* defaults - every algorithm on every task set */
+    options->algorithm      = ZERO_CPV;
+    options->max_tasks      = bench_sizes[BENCH_SIZES - ONE_CPV];
+    options->duration       = ZERO_CPV;
+    options->results_name   = (S8*)"bench";
+    options->event_mode     = TRUE;
+    options->ready_q_kind   = Q_LIST;
+    options->release_q_kind = Q_LIST;
+    options->help           = FALSE;
+
+    for( index=ONE_CPV; (index<argc)and(valid is TRUE); index++ )
+    {
+        if( (argv[index][ZERO_CPV] is_not '-') or
+            (argv[index][ONE_CPV] is '\0') or
+            (argv[index][TWO_CPV] is_not '\0') )
+        {
+            valid = FALSE;
+        }
+        else
+        {
+            switch( argv[index][ONE_CPV] )
+            {
+                /* options with a value */
+                case 'a':
+                case 's':
+                case 'd':
+                case 'o':
+                    if( (index + ONE_CPV) >= argc )
+                    {
+                        valid = FALSE;
+                    }
+                    else
+                    {
+                        index++;
+
+                        switch( argv[index - ONE_CPV][ONE_CPV] )
+                        {
+                            case 'a':
+                                valid = read_number( argv[index], ONE_CPV,
+                                                     (U32)ALG_MAX_ALG,
+                                                     &options->algorithm );
+                                break;
+                            case 's':
+                                valid = read_number( argv[index], ONE_CPV,
+                                                     TSK_MAX_TASKS,
+                                                     &options->max_tasks );
+                                break;
+                            case 'd':
+                                valid = read_number( argv[index], ONE_CPV,
+                                                     0x7fffffffU,
+                                                     &options->duration );
+                                break;
+                            default:
+                                options->results_name = (S8*)argv[index];
+                                break;
+                        }
+                    }
+                    break;
+
+                case 't':
+                    options->event_mode = FALSE;
+                    break;
+
+                case 'p':
+                    options->ready_q_kind = Q_HEAP;
+                    break;
+
+                case 'w':
+                    options->release_q_kind = Q_WHEEL;
+                    break;
+
+                case 'h':
+                    options->help = TRUE;
+                    break;
+
+                default:
+                    valid = FALSE;
+                    break;
+            } /* end of switch( argv[index][ONE_CPV] ) */
+        }
+
+        if( valid is FALSE )
+        {
+            MESS_OUT_message_S2( (S8*)"SchedBench: bad option",
+                                 (S8*)argv[index],
+                                 MESSAGE_OP_ERROR );
+        }
+    }
+
+    return( valid );
+
+} /* read_options() */
+
+
+/******************************************************************************
+*  Function    : read_number
+*  Description : private helper - reads a decimal number from an argument
+*  Parameters  : arg   - argument string
+*                min   - minimum valid value
+*                max   - maximum valid value
+*                value - returned number
+*  Returns     : TRUE if arg is a number between min and max
+******************************************************************************/
+static boolean read_number( const char *arg, const U32 min, const U32 max,
+                            U32 *value )
+{
+    char *end;
+    boolean valid = FALSE;
+
+    *value = (U32)strtoul( arg, &end, TEN_CPV );
+
+    if( (end is_not arg) and (*end is '\0') and
+        (*value >= min) and (*value <= max) )
+    {
+        valid = TRUE;
+    }
+
+    return( valid );
+
+} /* read_number() */
+
+
+/******************************************************************************
+*  Function    : run_bench
+*  Description : private helper - makes a task set, runs one algorithm on it
+*                to the end of the test and times the run. Short runs are
+*                repeated, from a new copy of the set, until they add up to
+*                BENCH_MIN_SECONDS or BENCH_MAX_RUNS runs.
+*  Parameters  : algorithm - algorithm to run
+*                tasks     - tasks in the set
+*                util      - task set utilisation (%)
+*                options   - benchmark options
+*                result    - returned results of the run
+*  Returns     : none
+******************************************************************************/
+static void run_bench( const algorithm_type algorithm, const U32 tasks,
+                       const U32 util, const struct bench_options_type *options,
+                       struct bench_result_type *result )
+{
+    struct sim_context_type *ctx = &bench_context;
+    U32 longest_period;
+    double start;
+
+    result->runs      = ZERO_CPV;
+    result->ticks     = ZERO_CPV;
+    result->decisions = ZERO_CPV;
+    result->seconds   = 0.0;
+
+    do
+    {
+        /* scratch trace, a new file each run */
+        (void)remove( trace_name );
+        MESS_OUT_rename_results_file( trace_name );
+
+        /* queues are switched when they are reset */
+        ctx->ready_q_kind   = options->ready_q_kind;
+        ctx->release_q_kind = options->release_q_kind;
+
+        TST_reset_test( ctx );
+
+        ctx->event_mode = options->event_mode;
+        SCH_set_algorithm( ctx, algorithm );
+
+        result->set_util = make_task_set( ctx, tasks, util, &longest_period );
+
+        /* long enough for every task to run a full period */
+        ctx->test_duration = ( options->duration > ZERO_CPV ) ? options->duration
+                                                              : longest_period;
+
+        TSK_start_of_test( ctx );       /* warn task object             */
+
+        start = read_seconds();
+        TST_run_simulation( ctx );      /* run to the end of the test   */
+        result->seconds += read_seconds() - start;
+
+        result->runs++;
+        result->ticks     += ctx->test_duration;
+        result->decisions += ctx->latency.count;
+
+    } while(    ( result->seconds < BENCH_MIN_SECONDS )
+            and ( result->runs < BENCH_MAX_RUNS ) );
+
+    result->algorithm = algorithm;
+    result->tasks     = tasks;
+    result->util      = util;
+    result->peak_kb   = read_peak_kb();
+    result->missed    = ctx->test_case_report_values[TST_DEADLN_MIS].value;
+    result->met       = ctx->test_case_report_values[TST_DEADLN_MET].value;
+    result->ready_q_kind = ctx->ready_q.q_kind;
+
+    MESS_OUT_message_4( (S8*)"Algorithm", (U32)algorithm + ONE_CPV,
+                        (S8*)"tasks", tasks,
+                        (S8*)"util (%)", util,
+                        (S8*)"ticks per second",
+                        ( result->seconds > 0.0 ) ? (U32)( result->ticks / result->seconds ) : ZERO_CPV,
+                        MESSAGE_OP_INFO );
+
+} /* run_bench() */
+
+
+/******************************************************************************
+*  Function    : make_task_set
+*  Description : private helper - loads a synthetic task set of periodic
+*                tasks, released together at time 0 with deadlines equal to
+*                their periods. Periods are spread over four times a base
+*                period that grows with the set, so that even the smallest
+*                task share is at least a tick. Shares are spread half to one
+*                and a half times the mean, priorities are rate monotonic
+*                and all periods are flexible.
+*  Parameters  : ctx            - simulation context
+*                tasks          - tasks in the set
+*                util           - task set utilisation (%)
+*                longest_period - returned longest task period
+*  Returns     : utilisation of the task set made (%), after rounding to
+*                whole ticks
+******************************************************************************/
+static double make_task_set( struct sim_context_type *ctx, const U32 tasks,
+                             const U32 util, U32 *longest_period )
+{
+    const U32 base = ( (TWO_CPV * tasks) > BENCH_MIN_PERIOD ) ? (TWO_CPV * tasks)
+                                                              : BENCH_MIN_PERIOD;
+    double set_util = 0.0;
+    task_id_type task;
+    U32 period;
+    U32 duration;
+    U8  priority;
+
+    bench_random = BENCH_SEED;
+    *longest_period = ZERO_CPV;
+
+    if( TSK_size_task_table( ctx, tasks ) is TRUE )
+    {
+        for( task=ONE_CPV; task<=tasks; task++ )
+        {
+            period   = base + ( next_random() % ((THREE_CPV * base) + ONE_CPV) );
+            duration = ( (util * period * (50U + (next_random() % 101U))) +
+                         (ONE_HUNDRED_CPV * ONE_HUNDRED_CPV * tasks / TWO_CPV) ) /
+                       ( ONE_HUNDRED_CPV * ONE_HUNDRED_CPV * tasks );
+            duration = ( duration < ONE_CPV ) ? ONE_CPV : duration;
+            duration = ( duration > period ) ? period : duration;
+            priority = (U8)( ONE_CPV + (((period - base) * 254U) / (THREE_CPV * base)) );
+
+            {
+                /* any non zero id loads the task. Every task is period
+                   flexible (spare 2, and spare 1 which SCH_queue_task()
+                   copies over it), so the adaptive algorithms always have
+                   a task to remove or double in overload */
+                const struct stored_task_data_type data =
+                    { 1, 0, duration, period, period, priority, 1, 1, 1, 0, 0 };
+
+                TSK_set_task( &data, ctx->tasks[task], &TSK_STATS(task) );
+            }
+            SCH_queue_task( ctx, task );
+
+            set_util += ( 100.0 * duration ) / period;
+            if( period > *longest_period )
+            {
+                *longest_period = period;
+            }
+        }
+    }
+
+    return( set_util );
+
+} /* make_task_set() */
+
+
+/******************************************************************************
+*  Function    : next_random
+*  Description : private helper - task set generator, a linear congruential
+*                generator so the sets are the same on every build
+*  Parameters  : none
+*  Returns     : next random number, 15 bits
+******************************************************************************/
+static U32 next_random( void )
+{
+    bench_random = ( bench_random * 1103515245U ) + 12345U;
+
+    return( (bench_random >> 16) & 0x7fffU );
+
+} /* next_random() */
+
+
+/******************************************************************************
+*  Function    : read_seconds
+*  Description : private helper - reads a monotonic wall clock. The CLK_
+*                clock is 32 bits of nanoseconds, too short for a long run.
+*  Parameters  : none
+*  Returns     : time in seconds
+******************************************************************************/
+static double read_seconds( void )
+{
+    struct timespec now;
+
+    (void)clock_gettime( CLOCK_MONOTONIC, &now );
+
+    return( (double)now.tv_sec + ((double)now.tv_nsec / 1.0e9) );
+
+} /* read_seconds() */
+
+
+/******************************************************************************
+*  Function    : read_peak_kb
+*  Description : private helper - reads the peak memory of the process so
+*                far. It only ever grows, so the task sets are run smallest
+*                first.
+*  Parameters  : none
+*  Returns     : peak memory in kilobytes, 0 if it cannot be read
+******************************************************************************/
+static U32 read_peak_kb( void )
+{
+    U32 peak_kb = ZERO_CPV;
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS counters;
+
+    if( GetProcessMemoryInfo( GetCurrentProcess(), &counters, sizeof( counters ) ) )
+    {
+        peak_kb = (U32)( counters.PeakWorkingSetSize / 1024U );
+    }
+#else
+    struct rusage usage;
+
+    if( getrusage( RUSAGE_SELF, &usage ) is ZERO_CPV )
+    {
+        peak_kb = (U32)usage.ru_maxrss;    /* kilobytes on Linux */
+    }
+#endif
+
+    return( peak_kb );
+
+} /* read_peak_kb() */
+
+
+/******************************************************************************
+*  Function    : write_result
+*  Description : private helper - writes the results of a run as a CSV line
+*                and a JSON object
+*  Parameters  : csv     - CSV results file
+*                json    - JSON results file
+*                first   - TRUE for the first run, no comma before it
+*                result  - results of the run
+*                options - benchmark options
+*  Returns     : none
+******************************************************************************/
+static void write_result( FILE *csv, FILE *json, const boolean first,
+                          const struct bench_result_type *result,
+                          const struct bench_options_type *options )
+{
+    const char *mode      = ( options->event_mode is TRUE ) ? "event" : "tick";
+    const char *ready_q   = ( result->ready_q_kind is Q_HEAP ) ? "heap" : "list";
+    const char *release_q = ( options->release_q_kind is Q_WHEEL ) ? "wheel" : "list";
+    double ticks_per_sec     = 0.0;
+    double decisions_per_sec = 0.0;
+
+    if( result->seconds > 0.0 )
+    {
+        ticks_per_sec     = result->ticks / result->seconds;
+        decisions_per_sec = result->decisions / result->seconds;
+    }
+
+    (void)fprintf( csv, "%u,%s,%u,%u,%.1f,%s,%s,%s,%u,%u,%u,%.6f,%.0f,%.0f,%u,%u,%u\n",
+                   (U32)result->algorithm + ONE_CPV,
+                   bench_alg_names[result->algorithm],
+                   result->tasks, result->util, result->set_util,
+                   mode, ready_q, release_q,
+                   result->runs, result->ticks, result->decisions, result->seconds,
+                   ticks_per_sec, decisions_per_sec,
+                   result->peak_kb, result->missed, result->met );
+
+    (void)fprintf( json, "%s  {\"algorithm\": %u, \"name\": \"%s\", \"tasks\": %u, "
+                         "\"util\": %u, \"set_util\": %.1f, \"mode\": \"%s\", "
+                         "\"ready_q\": \"%s\", \"release_q\": \"%s\", "
+                         "\"runs\": %u, \"ticks\": %u, \"decisions\": %u, \"seconds\": %.6f, "
+                         "\"ticks_per_sec\": %.0f, \"decisions_per_sec\": %.0f, "
+                         "\"peak_kb\": %u, \"missed\": %u, \"met\": %u}",
+                   ( first is TRUE ) ? "" : ",\n",
+                   (U32)result->algorithm + ONE_CPV,
+                   bench_alg_names[result->algorithm],
+                   result->tasks, result->util, result->set_util,
+                   mode, ready_q, release_q,
+                   result->runs, result->ticks, result->decisions, result->seconds,
+                   ticks_per_sec, decisions_per_sec,
+                   result->peak_kb, result->missed, result->met );
+
+    /* a run at a time, so a long benchmark can be watched */
+    (void)fflush( csv );
+    (void)fflush( json );
+
+} /* write_result() */
+
+
+/******************************************************************************
+*  Function    : print_usage
+*  Description : private helper - prints the command line options
+*  Parameters  : none
+*  Returns     : none
+******************************************************************************/
+static void print_usage( void )
+{
+    MESS_OUT_message( (S8*)"Usage: SchedBench [options]", MESSAGE_OP_INFO );
+    MESS_OUT_message( (S8*)"  -a algorithm    - benchmark one algorithm (default all)", MESSAGE_OP_INFO );
+    MESS_OUT_message( (S8*)"  -s tasks        - largest task set (default 4096)", MESSAGE_OP_INFO );
+    MESS_OUT_message( (S8*)"  -d duration     - test duration (default longest period)", MESSAGE_OP_INFO );
+    MESS_OUT_message( (S8*)"  -o name         - results files name.csv and name.json", MESSAGE_OP_INFO );
+    MESS_OUT_message( (S8*)"  -t              - tick by tick, not event driven", MESSAGE_OP_INFO );
+    MESS_OUT_message( (S8*)"  -p              - heap ready queue, a list for MUF and ADAP_03-07", MESSAGE_OP_INFO );
+    MESS_OUT_message( (S8*)"  -w              - timing wheel idle and waiting queues", MESSAGE_OP_INFO );
+    MESS_OUT_message( (S8*)"  -h              - this help", MESSAGE_OP_INFO );
+    MESS_OUT_message_3( (S8*)"Exit codes: ok", BENCH_EXIT_OK,
+                        (S8*)"usage", BENCH_EXIT_USAGE,
+                        (S8*)"results files", BENCH_EXIT_OUTPUT,
+                        MESSAGE_OP_INFO );
+
+} /* print_usage() */
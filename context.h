@@ -0,0 +1,115 @@
+/******************************************************************************
+*                                                                             *
+*                                                                             *
+*                                                                             *
+*******************************************************************************
+*                                                                             *
+* Project     :   SCHEDULER SIMULATOR                                         *
+*                                                                             *
+* File Name   :  context.h                                                    *
+*                                                                             *
+* Description :  Simulation context. Holds all the state of one simulation   *
+*                run - task control blocks, scheduler queues, system time    *
+*                and test report values - so that several simulations can    *
+*                run side by side. The SCH_, TSK_ and TST_ entry points take  *
+*                a pointer to the context they work on.                       *
+*                                                                             *
+*******************************************************************************
+* Modification record:                                                        *
+*                                                                             *
+* date     |Aut| Description                                                  *
+* 17-10-26 |JRO| Created                                                      *
+* 17-10-26 |JRO| Task table sized at run time                                 *
+* 17-10-26 |JRO| running_task_id widened to task_id_type                      *
+* 17-10-26 |JRO| Added ready queue heap                                       *
+* 17-10-26 |JRO| Added idle and waiting timing wheels                         *
+* 17-10-26 |JRO| Added running task set utility total                         *
+* 17-10-26 |JRO| Added scheduling policy pointer                              *
+* 17-10-26 |JRO| Queue headers and policy left out of single algorithm builds *
+* 17-10-26 |JRO| Added task statistics table                                  *
+* 17-10-26 |JRO| Added scheduler time histogram                               *
+* 17-10-26 |JRO| Added scheduler phase profile, see SCH_PROFILE               *
+*          |   |                                                              *
+*                                                                             *
+******************************************************************************/
+#ifndef _CONTEXT_H_
+#define _CONTEXT_H_
+
+#include "task.h"
+#include "scheduler.h"
+#include "q_utils.h"
+#include "test.h"
+#include "latency.h"
+
+/* test case report variable */
+struct test_case_report_values_type
+{
+    S8   name[MAX_LINE_LEN];   /* name of parameter  */
+    U32  value;                /* value of parameter */
+};
+
+/* scheduling policy of an algorithm, see scheduler.c */
+struct sch_policy_type;
+
+/* simulation context */
+struct sim_context_type
+{
+    /* TASK OBJECT */
+    struct task_type  *task_array;               /* task control blocks       */
+    struct task_type **tasks;                    /* pointers to task_array[]  */
+    struct task_stats_type *task_stats;          /* task statistics, by id    */
+    U32               num_tasks;                 /* tasks in the set, 1 to n  */
+    U32               max_tasks;                 /* tasks the table can hold  */
+    S8               *report_line;               /* scheduler report words    */
+    task_id_type      running_task_id;           /* running task, 0 if none   */
+    boolean           task_error;                /* deadline overrun reported */
+
+    /* SCHEDULER OBJECT */
+    algorithm_type    algorithm;                 /* scheduling algorithm      */
+#ifndef SCH_SINGLE_ALGORITHM
+    const struct sch_policy_type *policy;        /* policy of the algorithm   */
+#endif
+    struct task_type  readys;                    /* ready queue header        */
+    struct task_type *ready_tasks;
+    struct task_type  idles;                     /* idle queue header         */
+    struct task_type *idle_tasks;
+    struct task_type  waits;                     /* waiting queue header      */
+    struct task_type *waiting_tasks;
+    struct task_type  skippeds;                  /* skipped queue header      */
+    struct task_type *skipped_tasks;
+    struct task_type  removeds;                  /* removed queue header      */
+    struct task_type *removed_tasks;
+#if SCH_DOUBLED_QUEUE
+    struct task_type  doubleds;                  /* doubled periods header    */
+#endif
+    struct task_type *doubled_periods;           /* NULL if not built         */
+#if SCH_LST_QUEUE
+    struct task_type  lsts;                      /* LST queue header          */
+#endif
+    struct task_type *lst_tasks;                 /* NULL if not built         */
+    struct task_q_type ready_q;                  /* ready queue heap          */
+    q_kind_type       ready_q_kind;              /* ready queue list or heap  */
+    struct task_wheel_type idle_wheel;           /* idle queue timing wheel   */
+    struct task_wheel_type waiting_wheel;        /* waiting queue wheel       */
+    q_kind_type       release_q_kind;            /* idle/waiting list or wheel*/
+    U32               task_set_util;             /* sum of task utility shares*/
+    U32               stale_utils;               /* tasks with stale task_util*/
+#if SCH_PROFILE
+    struct sch_profile_type profile;             /* SCH_start() phase profile */
+#endif
+
+    /* TEST OBJECT */
+    U32               timeval;                   /* system time               */
+    mode_type         mode;                      /* simulator mode            */
+    U32               test_duration;             /* timer tick length of test */
+    U8                test_num;                  /* loaded test case          */
+    boolean           event_mode;                /* event driven time advance */
+    struct test_case_report_values_type
+                      test_case_report_values[TST_MAX_TST];
+    struct lat_histogram_type latency;           /* SCH_start() times         */
+};
+
+/* context driven by the terminal, defined in test.c */
+extern struct sim_context_type sim_context;
+
+#endif /* _CONTEXT_H_ */
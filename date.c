@@ -16,6 +16,7 @@
 *                                                                             *
 * Date     |Aut| Description                                                  *
 * 23-09-05 |JRO| Created                                                      *
+* 17-10-26 |JRO| Local time made in the caller's buffer, for sweep threads    *
 *          |   |                                                              *
 *                                                                             *
 ******************************************************************************/
@@ -141,8 +142,14 @@ static struct tm * get_time_struct( struct tm *loctime )
 	/* Get the current time */
 	curtime = time( NULL );
 
-	/* Convert it to local time representation */
-   	loctime = localtime( &curtime );
+	/* Convert it to local time representation, into loctime. The C
+	   library localtime() has one buffer shared by the sweep threads */
+#ifdef _WIN32
+	/* the Windows runtime keeps that buffer per thread */
+	*loctime = *localtime( &curtime );
+#else
+	(void)localtime_r( &curtime, loctime );
+#endif
 
 	return loctime;
 
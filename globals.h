@@ -20,6 +20,10 @@
 * 10-04-05 |JRO| Added MLLF scheduler                                         *
 * 15-04-05 |JRO| Added MUF scheduler                                          *
 * 16-04-05 |JRO| Added RTO skip scheduler                                     *
+* 17-10-26 |JRO| mode, test_duration & test_num moved to context.h            *
+* 17-10-26 |JRO| Added THREAD_LOCAL storage class for the parallel sweep      *
+* 17-10-26 |JRO| NUM_OF_TASKS is now the default task table size              *
+* 17-10-26 |JRO| Added task_id_type, width set by TASK_ID_BITS                *
 *          |   |                                                              *
 *                                                                             *
 ******************************************************************************/
@@ -42,7 +46,7 @@
 /* other global defines */
 #define MAX_LINE_LEN    500       /* standard test line           */
 #define MAX_NAME_LEN    100       /* standard name string length  */
-#define NUM_OF_TASKS      8       /* number of scheduler tasks    */
+#define NUM_OF_TASKS      8       /* default task table size      */
 #define MAX_TEST_CASES   62       /* number of test cases         */
 
 #define version_num "Version: 10.12"
@@ -97,6 +101,36 @@ typedef enum
     #define NULL 0
 #endif
 
+/* per thread storage class, PC sweep workers each get their own copy */
+#ifndef DEV_SYSTEM
+    #define THREAD_LOCAL __thread
+#else
+    #define THREAD_LOCAL
+#endif
+
+/* task id type - task table index and scheduler queue link */
+/* TASK_ID_BITS may be 8, 16 or 32, set on the command line  */
+#ifndef TASK_ID_BITS
+    #ifdef DEV_SYSTEM
+        #define TASK_ID_BITS  8      /* compact links for target RAM  */
+    #else
+        #define TASK_ID_BITS  32
+    #endif
+#endif
+
+#if(TASK_ID_BITS == 8)
+    typedef U8  task_id_type;
+    #define MAX_TASK_ID   0xffU
+#elif(TASK_ID_BITS == 16)
+    typedef U16 task_id_type;
+    #define MAX_TASK_ID   0xffffU
+#elif(TASK_ID_BITS == 32)
+    typedef U32 task_id_type;
+    #define MAX_TASK_ID   0x00ffffffU    /* table size, not link limit */
+#else
+    #error TASK_ID_BITS must be 8, 16 or 32
+#endif
+
 /* simulator modes */
 typedef enum
 {
@@ -105,10 +139,4 @@ typedef enum
     MODE_ABORT         /* abort to main   */
 }mode_type;
 
-extern mode_type mode; /* defined in test.c */
-
-/* timer tick length of test */
-extern U32 test_duration;
-extern U8  test_num;
-
 #endif  /* _GLOBALS_H_ */
@@ -16,6 +16,10 @@
 *                                                                             *
 * date    |Auth| Description                                                  *
 * 18-03-05|JRO | Created                                                      *
+* 17-10-26|JRO | Initialises the terminal's simulation context                *
+* 17-10-26|JRO | Frees the terminal's task table at closedown                 *
+* 17-10-26|JRO | Frees the terminal's ready queue heap at closedown           *
+* 17-10-26|JRO | Debug message through MESS_OUT_DEBUG()                       *
 *         |    |                                                              *
 *                                                                             *
 ******************************************************************************/
@@ -28,6 +32,7 @@
 #include "test.h"
 #include "scheduler.h"
 #include "q_utils.h"
+#include "context.h"
 
 #ifdef DEV_SYSTEM  /* CONDITIONAL COMPILE - Keil Development System */
 #include "serial.h"
@@ -46,16 +51,12 @@ void INIT_initialise( void )
         SER_init();                 /* serial object               */
     #endif
 
-	/* default globals */
-    mode              = MODE_TERMINAL; /* set simulator mode       */
-    test_duration     = TEN_CPV;    /* default test length         */
-
 	/* general initialisation */
     MESS_OUT_initialise();          /* message output              */
-    TSK_init();                     /* initialise task object      */
-    TST_init();                     /* initialise test object      */
+    TSK_init( &sim_context );       /* initialise task object      */
+    TST_init( &sim_context );       /* initialise test object      */
 /*	TASK_SET_init();	*/			/* task set object             */
-    SCH_init();                     /* scheduler object            */
+    SCH_init( &sim_context );       /* scheduler object            */
     TIM_init();                     /* timer object and interrupts */
 	QUTIL_init();					/* queue utilities             */
     CLK_init();                     /* clock object                */
@@ -68,11 +69,11 @@ void INIT_initialise( void )
 ******************************************************************************/
 void INIT_soft_reset( void )
 {
-    MESS_OUT_message( (S8*)"INIT_soft_reset", MESSAGE_OP_DEBUG );
-    TST_soft_reset();
-    TSK_soft_reset();
-    SCH_soft_reset();
-    test_duration  = TEN_CPV;       /* default test length         */
+    MESS_OUT_DEBUG( MESS_OUT_message( (S8*)"INIT_soft_reset", MESSAGE_OP_DEBUG ) );
+    TST_soft_reset( &sim_context );
+    TSK_soft_reset( &sim_context );
+    SCH_soft_reset( &sim_context );
+    sim_context.test_duration  = TEN_CPV; /* default test length         */
 
 } /* INIT_soft_reset() */
 
@@ -83,6 +84,8 @@ void INIT_soft_reset( void )
 void INIT_closedown( void )
 {
 /*	TASK_SET_close();	 */    /* task set object             */
+	TSK_close( &sim_context ); /* task table                  */
+	SCH_close( &sim_context ); /* ready queue heap            */
 	MESS_OUT_close();        /* message out object          */
 	QUTIL_close();			 /* queue utilities             */
 
@@ -0,0 +1,251 @@
+/******************************************************************************
+*                                                                             *
+*                                                                             *
+*                                                                             *
+*******************************************************************************
+*                                                                             *
+* Project     :   SCHEDULER SIMULATOR
+*                                                                             *
+* File Name   :  latency.c                                                    *
+*                                                                             *
+* Description :  Scheduler time histogram. Each SCH_start() time goes into a  *
+*                log bucketed histogram: times below 2^LAT_SUB_BITS have a    *
+*                bucket each, above that every power of two is split into     *
+*                2^(LAT_SUB_BITS-1) buckets. The end of test report gives     *
+*                the percentiles and the slowest scheduler calls.             *
+*                Recording takes shifts and compares only, so it is cheap     *
+*                enough for the development system timer interrupt.           *
+*                                                                             *
+*******************************************************************************
+* Modification record:                                                        *
+*                                                                             *
+* Date     |Who| Description                                                  *
+* 17-10-26 |JRO| Created                                                      *
+*          |   |                                                              *
+*                                                                             *
+******************************************************************************/
+#include "globals.h"
+#include "messages_out.h"
+#include "utils.h"
+#include "latency.h"       /* interface file                */
+
+#define LAT_PER_MILLE       1000U  /* percentiles are given per mille     */
+#define LAT_PERCENTILES     4
+
+/* percentiles reported, per mille, and their report names */
+static const U32 lat_per_mille[LAT_PERCENTILES] = { 500U, 900U, 990U, 999U };
+static const S8* const lat_names[LAT_PERCENTILES] =
+{
+    (S8*)"Sched time p50   : ",
+    (S8*)"Sched time p90   : ",
+    (S8*)"Sched time p99   : ",
+    (S8*)"Sched time p99.9 : "
+};
+
+/******************************************************************************
+*  PRIVATE FUNCTION PROTOTYPES
+******************************************************************************/
+static U32 bucket_index( const U32 time );
+static U32 bucket_top( const U32 index );
+static U32 percentile( const struct lat_histogram_type *hist, const U32 per_mille );
+
+
+/******************************************************************************
+*                             PUBLIC FUNCTIONS
+******************************************************************************/
+
+
+/******************************************************************************
+*  Function    : LAT_reset
+*  Description : empties a histogram, ready for a new run
+*  Parameters  : hist - histogram
+*  Returns     : none
+******************************************************************************/
+void LAT_reset( struct lat_histogram_type *hist )
+{
+    U32 index;
+
+    for( index=ZERO_CPV; index<LAT_BUCKETS; index++ )
+    {
+        hist->buckets[index] = ZERO_CPV;
+    }
+
+    for( index=ZERO_CPV; index<LAT_WORST_TICKS; index++ )
+    {
+        hist->worst[index].time    = ZERO_CPV;
+        hist->worst[index].timeval = ZERO_CPV;
+    }
+
+    hist->count = ZERO_CPV;
+    hist->min   = ZERO_CPV;
+    hist->max   = ZERO_CPV;
+
+} /* LAT_reset() */
+
+
+/******************************************************************************
+*  Function    : LAT_record
+*  Description : adds a scheduler time to a histogram, and to the slowest
+*                calls if it is one of them
+*  Parameters  : hist    - histogram
+*                timeval - system time of the scheduler call
+*                time    - scheduler time, CLK_ clock units
+*  Returns     : none
+******************************************************************************/
+void LAT_record( struct lat_histogram_type *hist, const U32 timeval, const U32 time )
+{
+    U32 index;
+
+    hist->buckets[bucket_index( time )]++;
+
+    if( (hist->count is ZERO_CPV) or (time < hist->min) )
+    {
+        hist->min = time;
+    }
+    if( time > hist->max )
+    {
+        hist->max = time;
+    }
+    hist->count++;
+
+    /* slowest calls, slowest first */
+    if( time > hist->worst[LAT_WORST_TICKS - ONE_CPV].time )
+    {
+        index = LAT_WORST_TICKS - ONE_CPV;
+        while( (index > ZERO_CPV) and (time > hist->worst[index - ONE_CPV].time) )
+        {
+            hist->worst[index] = hist->worst[index - ONE_CPV];
+            index--;
+        }
+        hist->worst[index].time    = time;
+        hist->worst[index].timeval = timeval;
+    }
+
+} /* LAT_record() */
+
+
+/******************************************************************************
+*  Function    : LAT_report
+*  Description : reports the scheduler times at end of test, in CLK_ clock
+*                units. A percentile is given as the top of its bucket.
+*  Parameters  : hist - histogram
+*  Returns     : none
+******************************************************************************/
+void LAT_report( const struct lat_histogram_type *hist )
+{
+    U32 index;
+
+    if( hist->count > ZERO_CPV )
+    {
+        MESS_OUT_message_1( (S8*)"Sched time min   : ", hist->min, MESSAGE_OP_RESULTS );
+
+        for( index=ZERO_CPV; index<LAT_PERCENTILES; index++ )
+        {
+            MESS_OUT_message_1( lat_names[index],
+                                percentile( hist, lat_per_mille[index] ),
+                                MESSAGE_OP_RESULTS );
+        }
+
+        MESS_OUT_message_1( (S8*)"Sched time max   : ", hist->max, MESSAGE_OP_RESULTS );
+
+        for( index=ZERO_CPV; (index<LAT_WORST_TICKS)and(index<hist->count); index++ )
+        {
+            MESS_OUT_message_2( (S8*)"Worst sched time : ", hist->worst[index].time,
+                                (S8*)"at time", hist->worst[index].timeval,
+                                MESSAGE_OP_RESULTS );
+        }
+    }
+
+} /* LAT_report() */
+
+
+/******************************************************************************
+*                            PRIVATE FUNCTIONS
+******************************************************************************/
+
+
+/******************************************************************************
+*  Function    : bucket_index
+*  Description : private helper - finds the bucket of a scheduler time
+*  Parameters  : time - scheduler time
+*  Returns     : bucket index
+******************************************************************************/
+static U32 bucket_index( const U32 time )
+{
+    U32 shift = ZERO_CPV;
+
+    /* drop low bits until the time fits its power of two's buckets */
+    while( (time >> shift) >= (LAT_HALF_BUCKETS << ONE_CPV) )
+    {
+        shift++;
+    }
+
+    return( (LAT_HALF_BUCKETS * shift) + (time >> shift) );
+
+} /* bucket_index() */
+
+
+/******************************************************************************
+*  Function    : bucket_top
+*  Description : private helper - finds the longest time a bucket holds
+*  Parameters  : index - bucket index
+*  Returns     : longest scheduler time of the bucket
+******************************************************************************/
+static U32 bucket_top( const U32 index )
+{
+    U32 shift = ZERO_CPV;
+    U32 sub = index;
+
+    /* undo bucket_index() */
+    while( sub >= (LAT_HALF_BUCKETS << ONE_CPV) )
+    {
+        sub -= LAT_HALF_BUCKETS;
+        shift++;
+    }
+
+    return( (sub << shift) + ((ONE_CPV << shift) - ONE_CPV) );
+
+} /* bucket_top() */
+
+
+/******************************************************************************
+*  Function    : percentile
+*  Description : private helper - finds the time within which the given
+*                share of scheduler calls ran
+*  Parameters  : hist      - histogram
+*                per_mille - share of calls, per mille
+*  Returns     : top of the bucket holding the percentile, or the longest
+*                time if that is less
+******************************************************************************/
+static U32 percentile( const struct lat_histogram_type *hist, const U32 per_mille )
+{
+    struct UTL_div_type UTL_div;
+    U32 rank;
+    U32 seen = ZERO_CPV;
+    U32 index = ZERO_CPV;
+    U32 time;
+
+    /* rank of the percentile call, count * per_mille / 1000 rounded up, */
+    /* split so it cannot overflow                                        */
+    UTL_divide( hist->count, LAT_PER_MILLE, &UTL_div );
+    rank = UTL_div.quotient * per_mille;
+    UTL_divide( (UTL_div.remainder * per_mille) + (LAT_PER_MILLE - ONE_CPV),
+                LAT_PER_MILLE, &UTL_div );
+    rank += UTL_div.quotient;
+
+    if( rank is ZERO_CPV )
+    {
+        rank = ONE_CPV;
+    }
+
+    while( (index < LAT_BUCKETS) and ((seen + hist->buckets[index]) < rank) )
+    {
+        seen += hist->buckets[index];
+        index++;
+    }
+
+    time = bucket_top( index );
+
+    return( (time < hist->max) ? time : hist->max );
+
+} /* percentile() */
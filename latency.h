@@ -0,0 +1,60 @@
+/******************************************************************************
+*                                                                             *
+*                                                                             *
+*                                                                             *
+*******************************************************************************
+*                                                                             *
+* Project     :   SCHEDULER SIMULATOR
+*                                                                             *
+* File Name   :  latency.h                                                    *
+*                                                                             *
+* Description :  Interface file for latency.c                                 *
+*                                                                             *
+*******************************************************************************
+* Modification record:                                                        *
+*                                                                             *
+* Date     |Who| Description                                                  *
+* 17-10-26 |JRO| Created                                                      *
+*          |   |                                                              *
+*                                                                             *
+******************************************************************************/
+#ifndef _LATENCY_H_
+#define _LATENCY_H_
+
+/* bits of each scheduler time kept, the buckets are no wider than
+   1 / 2^(LAT_SUB_BITS - 1) of the times they hold. The development system
+   has less memory to spare */
+#ifndef LAT_SUB_BITS
+    #ifdef DEV_SYSTEM
+        #define LAT_SUB_BITS    3
+    #else
+        #define LAT_SUB_BITS    5
+    #endif
+#endif
+
+#define LAT_HALF_BUCKETS  (1U << (LAT_SUB_BITS - 1U))
+#define LAT_BUCKETS       (LAT_HALF_BUCKETS * (34U - LAT_SUB_BITS))
+#define LAT_WORST_TICKS   5     /* slowest scheduler calls reported       */
+
+/* a slow scheduler call */
+struct lat_tick_type
+{
+    U32 time;                   /* scheduler time, CLK_ clock units       */
+    U32 timeval;                /* system time of the call                */
+};
+
+/* scheduler time histogram of a simulation run */
+struct lat_histogram_type
+{
+    U32 buckets[LAT_BUCKETS];   /* scheduler calls, by time               */
+    U32 count;                  /* scheduler calls                        */
+    U32 min;                    /* shortest scheduler time                */
+    U32 max;                    /* longest scheduler time                 */
+    struct lat_tick_type worst[LAT_WORST_TICKS]; /* slowest first         */
+};
+
+void LAT_reset( struct lat_histogram_type *hist );
+void LAT_record( struct lat_histogram_type *hist, const U32 timeval, const U32 time );
+void LAT_report( const struct lat_histogram_type *hist );
+
+#endif /* _LATENCY_H_ */
@@ -15,18 +15,43 @@
 *                                                                             *
 * date    |Auth| Description                                                  *
 * 10-03-05|JRO | Created                                                      *
+* 17-10-26|JRO | Runs the terminal's simulation context                       *
+* 17-10-26|JRO | Command line options select a headless batch run             *
 *         |    |                                                              *
 *                                                                             *
 ******************************************************************************/
 #include "globals.h"
 #include "initialise.h"
 #include "test.h"
+#include "context.h"
+#include "batch.h"
 
 
+#ifndef DEV_SYSTEM
+S32 main( S32 argc, char *argv[] )
+{
+    S32 status = BAT_EXIT_OK;
+
+    INIT_initialise();    /* initialise objects */
+
+    if( argc > ONE_CPV )
+    {
+        status = BAT_run( argc, (S8**)argv ); /* headless batch run */
+    }
+    else
+    {
+        TST_test( &sim_context ); /* run test           */
+    }
+
+    INIT_closedown();     /* shut things down   */
+    return( status ); 
+}
+#else
 S32 main( void )
 {
     INIT_initialise();    /* initialise objects */
-    TST_test();           /* run test           */
+    TST_test( &sim_context ); /* run test           */
     INIT_closedown();     /* shut things down   */
     return( 0 ); 
 }
+#endif
@@ -20,6 +20,18 @@
 *                                                                             *
 * Date     |Aut| Description                                                  *
 * 13-09-05 |JRO| Created, to replace out_res.c, with improved encapsulation.  *
+* 17-10-26 |JRO| Simulator mode read from sim_context                         *
+* 17-10-26 |JRO| Results file name and file pointers are per thread           *
+* 17-10-26 |JRO| Added mode setters and log file naming for batch runs        *
+* 17-10-26 |JRO| Task and scheduler reports take any number of tasks          *
+* 17-10-26 |JRO| Results and log files held open and buffered                 *
+* 17-10-26 |JRO| Results written by a writer thread fed through a ring buffer *
+* 17-10-26 |JRO| Added binary results trace, see trace.h                      *
+* 17-10-26 |JRO| Added change only binary trace                               *
+* 17-10-26 |JRO| Debug and verbose modes readable by MESS_OUT_LEVEL macros    *
+* 17-10-26 |JRO| Numbers formatted by UTL_format_dec() and UTL_format_int()   *
+* 17-10-26 |JRO| Results file name and its log message bounded to MAX_NAME_LEN*
+* 17-10-26 |JRO| Change only trace run written out before its overhead wraps  *
 *          |   |                                                              *
 *                                                                             *
 ******************************************************************************/
@@ -32,14 +44,15 @@
 /***************************************/ 
 #include "serial.h"
 #include "rt_clock.h"
+#include "utils.h"
 #include "messages_out.h"
 
 
 /******************************************************************************
 *                            PRIVATE DATA TYPES								  *
 ******************************************************************************/
-static boolean debug_mode;
-static boolean verbose_mode;
+boolean MESS_OUT_debug_mode;
+boolean MESS_OUT_verbose_mode;
 
 
 /******************************************************************************
@@ -47,10 +60,6 @@ static boolean verbose_mode;
 ******************************************************************************/
 static void putstr( const S8 *p );
 static void build_dec( const U32 num, S8 *num_string );
-static void build_dec8( const U8 num, S8 *num_string );
-static void build_dec16( const U16 num, S8 *num_string );
-static void build_dec32( const U32 num, S8 *num_string );
-static S8 dec2str( const U32 num );
 
 
 /******************************************************************************
@@ -59,8 +68,8 @@ static S8 dec2str( const U32 num );
 void MESS_OUT_initialise( void )
 {
 	/* initialise defaults reporting modes */
-	debug_mode          = FALSE; 
-	verbose_mode        = TRUE;
+	MESS_OUT_debug_mode          = FALSE; 
+	MESS_OUT_verbose_mode        = TRUE;
 	
 } /* MESS_OUT_initialise() */
 
@@ -78,9 +87,9 @@ void MESS_OUT_message( const S8* const message, const message_class class )
 {
 	U32 temp_time;
 
-	if( ((class is MESSAGE_OP_VERBOSE)and(verbose_mode is FALSE))
+	if( ((class is MESSAGE_OP_VERBOSE)and(MESS_OUT_verbose_mode is FALSE))
 	     or 
-		((class is MESSAGE_OP_DEBUG)and(debug_mode is FALSE)) )
+		((class is MESSAGE_OP_DEBUG)and(MESS_OUT_debug_mode is FALSE)) )
 	{
 		/* do nothing */
 	}
@@ -114,9 +123,9 @@ void MESS_OUT_message_S2( const S8* const message1, const S8* const message2,
 {
 	U32 temp_time;
 
-	if( ((class is MESSAGE_OP_VERBOSE)and(verbose_mode is FALSE))
+	if( ((class is MESSAGE_OP_VERBOSE)and(MESS_OUT_verbose_mode is FALSE))
 	     or 
-		((class is MESSAGE_OP_DEBUG)and(debug_mode is FALSE)) )
+		((class is MESSAGE_OP_DEBUG)and(MESS_OUT_debug_mode is FALSE)) )
 	{
 		/* do nothing */
 	}
@@ -167,9 +176,9 @@ void MESS_OUT_message_1( const S8* const message, const U32 num,
 	S8 num_string[13];
 	U32 temp_time;
 
-	if( ((class is MESSAGE_OP_VERBOSE)and(verbose_mode is FALSE))
+	if( ((class is MESSAGE_OP_VERBOSE)and(MESS_OUT_verbose_mode is FALSE))
 	     or 
-		((class is MESSAGE_OP_DEBUG)and(debug_mode is FALSE)) )
+		((class is MESSAGE_OP_DEBUG)and(MESS_OUT_debug_mode is FALSE)) )
 	{
 		/* do nothing */
 	}
@@ -215,9 +224,9 @@ void MESS_OUT_message_2( const S8* const message_1, const U32 num_1,
 	S8 num_string[13];
 	U32 temp_time;
 
-	if( ((class is MESSAGE_OP_VERBOSE)and(verbose_mode is FALSE))
+	if( ((class is MESSAGE_OP_VERBOSE)and(MESS_OUT_verbose_mode is FALSE))
 	     or 
-		((class is MESSAGE_OP_DEBUG)and(debug_mode is FALSE)) )
+		((class is MESSAGE_OP_DEBUG)and(MESS_OUT_debug_mode is FALSE)) )
 	{
 		/* do nothing */
 	}
@@ -276,9 +285,9 @@ void MESS_OUT_message_3( const S8* const message_1, const U32 num_1,
 	S8 num_string[13];
 	U32 temp_time;
 
-	if( ((class is MESSAGE_OP_VERBOSE)and(verbose_mode is FALSE))
+	if( ((class is MESSAGE_OP_VERBOSE)and(MESS_OUT_verbose_mode is FALSE))
 	     or 
-		((class is MESSAGE_OP_DEBUG)and(debug_mode is FALSE)) )
+		((class is MESSAGE_OP_DEBUG)and(MESS_OUT_debug_mode is FALSE)) )
 	{
 		/* do nothing */
 	}
@@ -347,9 +356,9 @@ void MESS_OUT_message_4( const S8* const message_1, const U32 num_1,
 	S8 num_string[13];
 	U32 temp_time;
 
-	if( ((class is MESSAGE_OP_VERBOSE)and(verbose_mode is FALSE))
+	if( ((class is MESSAGE_OP_VERBOSE)and(MESS_OUT_verbose_mode is FALSE))
 	     or 
-		((class is MESSAGE_OP_DEBUG)and(debug_mode is FALSE)) )
+		((class is MESSAGE_OP_DEBUG)and(MESS_OUT_debug_mode is FALSE)) )
 	{
 		/* do nothing */
 	}
@@ -408,45 +417,31 @@ void MESS_OUT_message_4( const S8* const message_1, const U32 num_1,
 
 /******************************************************************************
 *  Description : outputs a report string of task parameters to output
-*  Parameters  : param           : title string
-*                task_1 - task_7 : task states.
+*  Parameters  : param  : title string
+*                values : task parameters, one per task
+*                count  : number of values
 ******************************************************************************/
 void MESS_OUT_task_report(  const S8* const param,
-							const U32 task_1,
-							const U32 task_2,
-							const U32 task_3,
-							const U32 task_4,
-							const U32 task_5,
-							const U32 task_6,
-							const U32 task_7 )
+							const U32 *values,
+							const U32 count )
 {
 	S8 num_string[13];
 	U32 temp_time;
+	U32 index;
 
 	/* stop timer */
 	temp_time = CLK_end_timer();
 
 	putstr( param );
-	build_dec16( task_1, num_string );
-	putstr( (S8*)num_string );
-	putstr( (S8*)"   " );
-	build_dec16( task_2, num_string );
-	putstr( (S8*)num_string );
-	putstr( (S8*)"   " );
-	build_dec16( task_3, num_string );
-	putstr( (S8*)num_string );
-	putstr( (S8*)"   " );
-	build_dec16( task_4, num_string );
-	putstr( (S8*)num_string );
-	putstr( (S8*)"   " );
-	build_dec16( task_5, num_string );
-	putstr( (S8*)num_string );
-	putstr( (S8*)"   " );
-	build_dec16( task_6, num_string );
-	putstr( (S8*)num_string );
-	putstr( (S8*)"   " );
-	build_dec16( task_7, num_string );
-	putstr( (S8*)num_string );
+	for( index=0; index<count; index++ )
+	{
+		if( index > 0 )
+		{
+			putstr( (S8*)"   " );
+		}
+		(void)UTL_format_dec( num_string, (U16)values[index], FIVE_CPV, '0' );
+		putstr( (S8*)num_string );
+	}
 	putstr( (S8*)"\n" );
 
 	/* restart timer */
@@ -455,21 +450,63 @@ void MESS_OUT_task_report(  const S8* const param,
 } /* MESS_OUT_task_report() */
 
 
+/******************************************************************************
+*  Description : outputs a task number header line for tasks first to last
+*  Parameters  : head      : string before the task numbers
+*                first     : first task number
+*                last      : last task number
+*                tail      : string after the task numbers
+*                underline : TRUE to print the underline, not the numbers
+******************************************************************************/
+void MESS_OUT_task_header(  const S8* const head,
+							const U32 first,
+							const U32 last,
+							const S8* const tail,
+							const boolean underline )
+{
+	S8 num_string[13];
+	U32 temp_time;
+	U32 index;
+
+	/* stop timer */
+	temp_time = CLK_end_timer();
+
+	putstr( head );
+	for( index=first; index<=last; index++ )
+	{
+		if( index > first )
+		{
+			putstr( (S8*)"  " );
+		}
+		if( underline is TRUE )
+		{
+			putstr( (S8*)"======" );
+		}
+		else
+		{
+			putstr( (S8*)"TASK-" );
+			(void)UTL_format_dec( num_string, (U16)index, FIVE_CPV, '0' );
+			putstr( (S8*)num_string );
+		}
+	}
+	putstr( tail );
+	putstr( (S8*)"\n" );
+
+	/* restart timer */
+	CLK_start_timer( temp_time );
+
+} /* MESS_OUT_task_header() */
+
+
 /******************************************************************************
 *  Description : outputs a scheduler report to the output
-*  Parameters  : param           : title string
-*                task_1 - task_7 : task states.
-*                timestamp       : scheduler execution time
-*                overrun         : Overrun error flag
+*  Parameters  : time       : system time
+*                task_words : task states, one report word per task
+*                timestamp  : scheduler execution time
+*                overrun    : Overrun error flag
 ******************************************************************************/
 void MESS_OUT_scheduler_report( const U32 time,
-								const S8* const task_1,
-								const S8* const task_2,
-								const S8* const task_3,
-								const S8* const task_4,
-								const S8* const task_5,
-								const S8* const task_6,
-								const S8* const task_7,
+								const S8* const task_words,
 								const U32 timestamp,
 								const S8* const overrun )
 {
@@ -479,17 +516,11 @@ void MESS_OUT_scheduler_report( const U32 time,
 	/* stop timer */
 	temp_time = CLK_end_timer();
 
-	build_dec16( time, num_string );
+	(void)UTL_format_dec( num_string, (U16)time, FIVE_CPV, '0' );
 	putstr( (S8*)num_string );
 	putstr( (S8*)" " );
-	putstr( task_1 );
-	putstr( task_2 );
-	putstr( task_3 );
-	putstr( task_4 );
-	putstr( task_5 );
-	putstr( task_6 );
-	putstr( task_7 );
-	build_dec16( timestamp, num_string );
+	putstr( task_words );
+	(void)UTL_format_dec( num_string, (U16)timestamp, FIVE_CPV, '0' );
 	putstr( (S8*)num_string );
 	putstr( (S8*)"  " );
 	putstr( overrun );
@@ -504,15 +535,15 @@ void MESS_OUT_scheduler_report( const U32 time,
 /*****************************************************************************/
 void MESS_OUT_toggle_debug_mode( void )
 {
-	if( debug_mode is FALSE )
+	if( MESS_OUT_debug_mode is FALSE )
 	{
  		MESS_OUT_message( "Debug mode ON",  MESSAGE_OP_INFO );
-		debug_mode = TRUE;
+		MESS_OUT_debug_mode = TRUE;
 	}
 	else
 	{
  		MESS_OUT_message( "Debug mode OFF", MESSAGE_OP_INFO );
-		debug_mode = FALSE;
+		MESS_OUT_debug_mode = FALSE;
 	}
 
 } /* MESS_OUT_toggle_debug_mode() */
@@ -520,20 +551,36 @@ void MESS_OUT_toggle_debug_mode( void )
 /*****************************************************************************/
 void MESS_OUT_toggle_verbose_mode( void )
 {
-	if( verbose_mode is FALSE )
+	if( MESS_OUT_verbose_mode is FALSE )
 	{
  		MESS_OUT_message( "Verbose mode ON",  MESSAGE_OP_INFO );
-		verbose_mode = TRUE;
+		MESS_OUT_verbose_mode = TRUE;
 	}
 	else
 	{
  		MESS_OUT_message( "Verbose mode OFF", MESSAGE_OP_INFO );
-		verbose_mode = FALSE;
+		MESS_OUT_verbose_mode = FALSE;
 	}
 
 } /* MESS_OUT_toggle_verbose_mode() */
 
 
+/*****************************************************************************/
+void MESS_OUT_set_debug_mode( const boolean mode )
+{
+	MESS_OUT_debug_mode = mode;
+
+} /* MESS_OUT_set_debug_mode() */
+
+
+/*****************************************************************************/
+void MESS_OUT_set_verbose_mode( const boolean mode )
+{
+	MESS_OUT_verbose_mode = mode;
+
+} /* MESS_OUT_set_verbose_mode() */
+
+
 /******************************************************************************
 *  Description : dummy functions
 ******************************************************************************/
@@ -541,6 +588,22 @@ void MESS_OUT_toggle_screen_results_mode( void ){}
 void MESS_OUT_report_status( const message_class class ){}
 void MESS_OUT_report_duration( void ){}
 void MESS_OUT_rename_results_file( const S8* const file_name ){}
+void MESS_OUT_name_log_file( const S8* const file_name ){}
+void MESS_OUT_flush( void ){}
+void MESS_OUT_set_trace_mode( const trace_mode_type mode ){}
+void MESS_OUT_scheduler_trace( const U32 time, const U8* const codes,
+                               const U32 count, const U32 timestamp,
+                               const U32 running, const boolean overrun ){}
+
+
+/******************************************************************************
+*  Description : the development system only has the text trace
+******************************************************************************/
+trace_mode_type MESS_OUT_trace_mode( void )
+{
+	return( TRC_MODE_TEXT );
+
+} /* MESS_OUT_trace_mode() */
 
 
 /******************************************************************************
@@ -549,160 +612,31 @@ void MESS_OUT_rename_results_file( const S8* const file_name ){}
 
 
 /******************************************************************************
-*  Description : builds string representation of decimal number
-*  Notes       : Maximum length of 8 bit number is 255
+*  Description : builds string representation of decimal number, zero
+*                padded to the digits of the smallest type that holds it
+*  Notes       : 3 digits up to 255, 5 up to 65535, else 10
 *  Parameters  : num - number to be converted
 ******************************************************************************/
-static void build_dec( const U32 num, const S8* num_string )
+static void build_dec( const U32 num, S8 *num_string )
 {
-	/* who we gonna call */
+	U32 width;
 
 	if( num > 0x0000ffff )
 	{
-		build_dec32( num, num_string );
+		width = TEN_CPV;
 	}
 	else if( num > 0x000000ff )
 	{
-		build_dec16( (U16)num, num_string );
+		width = FIVE_CPV;
 	}
 	else
 	{
-		build_dec8( (U8)num, num_string );
+		width = THREE_CPV;
 	}
 
-} /* build_dec8() */
-
-
-/******************************************************************************
-*  Description : builds string representation of decimal number
-*  Notes       : Maximum length of 8 bit number is 255
-*  Parameters  : num - number to be converted
-******************************************************************************/
-static void build_dec8( const U8 num, S8 *num_string )
-{
-	U8 num_dec;
-	num_dec = num;
-
-	num_string[0] = dec2str( num_dec / 100 );
-	num_dec %= ONE_HUNDRED_CPV;
-	num_string[ONE_CPV] = dec2str( num_dec / 10 );
-	num_dec %= TEN_CPV;
-	num_string[TWO_CPV] = dec2str( num_dec );
-	num_string[THREE_CPV] = '\0';
-
-} /* build_dec8() */
-
+	(void)UTL_format_dec( num_string, num, width, '0' );
 
-/******************************************************************************
-*  Notes       : Maximum length of 16 bit number is 65535
-******************************************************************************/
-static void build_dec16( const U16 num, S8 *num_string )
-{
-	U16 num_dec;
-	num_dec = num;
-
-	num_string[0] = dec2str( num_dec /10000 );
-	num_dec %= 10000;
-	num_string[ONE_CPV] = dec2str( num_dec /1000 );
-	num_dec %= 1000;
-	num_string[TWO_CPV] = dec2str( num_dec /100 );
-	num_dec %= ONE_HUNDRED_CPV;
-	num_string[THREE_CPV] = dec2str( num_dec /10 );
-	num_dec %= TEN_CPV;
-	num_string[FOUR_CPV] = dec2str( num_dec );
-	num_string[FIVE_CPV] = '\0';
-
-} /* build_dec16() */
-
-
-/******************************************************************************
-*  Description : builds string representation of decimal number
-*  Notes       : Maximum length of 32 bit number is 4294967295
-*  Parameters  : num - number to be converted
-******************************************************************************/
-static void build_dec32( const U32 num, S8 *num_string )
-{
-	U32 num_dec;
-	num_dec = num;
-
-	num_string[ZERO_CPV] = dec2str( num_dec / 1000000000 );
-	num_dec %= 1000000000;
-	num_string[ONE_CPV] = dec2str( num_dec /100000000 );
-	num_dec %= 100000000;
-	num_string[TWO_CPV] = dec2str( num_dec /10000000 );
-	num_dec %= 10000000;
-	num_string[THREE_CPV] = dec2str( num_dec /1000000 );
-	num_dec %= 1000000;
-	num_string[FOUR_CPV] = dec2str( num_dec /100000 );
-	num_dec %= 100000;
-	num_string[FIVE_CPV] = dec2str( num_dec /10000 );
-	num_dec %= 10000;
-	num_string[SIX_CPV] = dec2str( num_dec /1000 );
-	num_dec %= 1000;
-	num_string[SEVEN_CPV] = dec2str( num_dec /100 );
-	num_dec %= ONE_HUNDRED_CPV;
-	num_string[EIGHT_CPV] = dec2str( num_dec /10 );
-	num_dec %= TEN_CPV;
-	num_string[NINE_CPV] = dec2str( num_dec );
-	num_string[TEN_CPV] = '\0';
-
-} /* build_dec32() */
-
-
-/******************************************************************************
-*  Description : used by build_dec. Returns char of number between 0 and 9
-*  Parameters  : num - number to be converted
-*  Returns     : char to input num
-******************************************************************************/
-static S8 dec2str( const U32 num )
-{
-	S8 return_char = NULL;
-
-	switch( num )
-	{
-	case 0:
-		return_char = '0';
-		break;
-
-	case 1:
-		return_char = '1';
-		break;
-
-	case 2:
-		return_char = '2';
-		break;
-
-	case 3:
-		return_char = '3';
-		break;
-
-	case 4:
-		return_char = '4';
-		break;
-
-	case 5:
-		return_char = '5';
-		break;
-
-	case 6:
-		return_char = '6';
-		break;
-
-	case 7:
-		return_char = '7';
-		break;
-
-	case 8:
-		return_char = '8';
-		break;
-
-	case 9:
-		return_char = '9';
-		break;
-	}
-
-	return( return_char );
-}
+} /* build_dec() */
 
 
 /******************************************************************************
@@ -728,32 +662,129 @@ static void putstr( const S8 *p )
 /*lint +e85 has dimension 0 */
 #include <io.h>
 #include <string.h>
+#include <stdlib.h>
 #include "date.h"
 #include "rt_clock.h"
+#include "utils.h"
 #include "messages_out.h"
+#include "context.h"
+#if MESS_OUT_ASYNC
+#include <pthread.h>            /* results writer thread        */
+#include <sched.h>
+#include <time.h>
+#endif
 
 
 /******************************************************************************
 *                            PRIVATE DATA TYPES								  *
 ******************************************************************************/
-static const S8* log_name = (S8*)"log.txt";
-static S8 results_name[MAX_NAME_LEN]; 
-static FILE* log_ptr;
-static FILE* results_ptr;
-static boolean debug_mode;
-static boolean verbose_mode;
+static S8 log_name[MAX_NAME_LEN] = "log.txt";
+static THREAD_LOCAL S8 results_name[MAX_NAME_LEN]; 
+static THREAD_LOCAL FILE* log_ptr;
+static THREAD_LOCAL FILE* results_ptr;
+boolean MESS_OUT_debug_mode;
+boolean MESS_OUT_verbose_mode;
 static boolean screen_results_mode;
+static trace_mode_type trace_mode = TRC_MODE_TEXT;
+static THREAD_LOCAL U32 trace_tasks;  /* tasks in the binary trace tick records */
+
+/* change only trace - the last tick record written, and the ticks since
+   that have repeated it */
+struct trace_run_type
+{
+	U8      *codes;         /* task report codes of the last tick      */
+	U32      time;          /* time of the last tick, repeats included */
+	U32      running;       /* running task of the last tick           */
+	U32      ticks;         /* repeated ticks not yet written          */
+	U32      overhead;      /* total overhead of the repeated ticks    */
+	boolean  valid;         /* a tick record to repeat                 */
+};
+
+static THREAD_LOCAL struct trace_run_type trace_run;
 
 #define TIME_STR_SIZE 250
+#define RESULTS_BUFFER_SIZE 65536  /* results written in blocks this size */
+
+/* the results file is written a line per tick, so it is held open through
+   a large buffer rather than opened and closed for every line */
+static THREAD_LOCAL S8 results_buffer[RESULTS_BUFFER_SIZE];
+
+#if MESS_OUT_ASYNC
+#define RING_SLOTS      1024       /* records in the results ring, power of 2 */
+#define RING_TEXT_SIZE  120        /* characters carried by one record        */
+#define RING_IDLE_NS    100000     /* writer sleep when the ring is empty     */
+
+/* results ring record kinds */
+typedef enum
+{
+	RING_TEXT,          /* text or binary trace bytes, value long */
+	RING_REPORT_HEAD,   /* scheduler report time                  */
+	RING_REPORT_TAIL,   /* scheduler report timestamp and overrun */
+	RING_FLUSH,         /* write out the file buffer              */
+	RING_STOP           /* writer thread to finish                */
+}ring_kind_type;
+
+/* results ring record - fixed size, long lines are sent as several */
+struct ring_record_type
+{
+	ring_kind_type kind;
+	U32            value;                        /* length, time or stamp */
+	boolean        last;                         /* text ends the line    */
+	S8             text[RING_TEXT_SIZE + ONE_CPV];
+};
+
+/* single producer, single consumer ring between a simulation thread and
+   its results writer. head is only written by the simulation thread and
+   tail only by the writer, so neither needs a lock */
+struct results_ring_type
+{
+	struct ring_record_type records[RING_SLOTS];
+	U32            head;      /* records written, simulation thread */
+	U32            tail;      /* records read, writer thread        */
+	FILE          *file;      /* results file the writer writes to  */
+	pthread_t      writer;    /* writer thread                      */
+	boolean        running;   /* TRUE while the writer is running   */
+};
+
+static THREAD_LOCAL struct results_ring_type results_ring;
+#endif
 
 
 /******************************************************************************
 *                       PRIVATE FUNCTION PROTOTYPES				     		  *
 ******************************************************************************/
-static void close_file( FILE* file_ptr, const S8* const time_str );
+static FILE* results_file( void );
+static FILE* log_file( void );
+static void results_text( const S8* const text, const boolean end_of_line );
+static void results_data( const U8* const data, const U32 length );
+static void results_progress( void );
+static U32 put_text( S8 *line, const S8* const text );
+static U32 put_message_number( S8 *line, const S8* const message, const U32 num );
+static void write_report_head( FILE *file, const U32 time );
+static void write_report_tail( FILE *file, const U32 timestamp, const S8* const overrun );
+static boolean trace_repeats( const U32 time, const U8* const codes,
+                              const U32 count, const U32 running,
+                              const boolean overrun );
+static void trace_end_run( void );
+static void results_report( const U32 time, const S8* const task_words,
+                            const U32 timestamp, const S8* const overrun );
+static void flush_results( void );
+static void close_results( void );
+#if MESS_OUT_ASYNC
+static void start_writer( void );
+static void stop_writer( void );
+static void *results_writer( void *arg );
+static struct ring_record_type *ring_next( void );
+static void ring_publish( void );
+static void ring_bytes( const U8* const data, const U32 length,
+                        const boolean end_of_line );
+#endif
+static void close_file( FILE** file_ptr );
 static void error_message( const S8* const message, const S8* const time_str );
 static void debug_message( const S8* const message, const S8* const time_str );
 static void results_message( const S8* const message );
+static void results_line( const S8* const head, const S8* const body,
+                          const S8* const tail );
 static void info_message( const S8* const message, const boolean cr );
 static void log_message( const S8* const message, const S8* const time_str );
 static void verbose_message( const S8* const message );
@@ -773,8 +804,8 @@ void MESS_OUT_initialise( void )
 	S8 time_str[TIME_STR_SIZE];
 
 	/* initialise reporting mode defaults */
-	debug_mode          = FALSE; 
-	verbose_mode        = TRUE;
+	MESS_OUT_debug_mode          = FALSE; 
+	MESS_OUT_verbose_mode        = TRUE;
 	screen_results_mode = FALSE;
 	
 	/* start stamp timer */
@@ -815,7 +846,7 @@ void MESS_OUT_message( const S8* const message, const message_class class )
 
 		case MESSAGE_OP_INFO :
 			info_message( message, TRUE );
-			if( debug_mode is TRUE )
+			if( MESS_OUT_debug_mode is TRUE )
 			{
 				debug_message( message, time_str );			
 			} 
@@ -823,7 +854,7 @@ void MESS_OUT_message( const S8* const message, const message_class class )
 
 		case MESSAGE_OP_INFO_NOCR :
 			info_message( message, FALSE );
-			if( debug_mode is TRUE )
+			if( MESS_OUT_debug_mode is TRUE )
 			{
 				debug_message( message, time_str );			
 			} 
@@ -835,7 +866,7 @@ void MESS_OUT_message( const S8* const message, const message_class class )
 			break;
 
 		case MESSAGE_OP_VERBOSE :
-			if( verbose_mode is TRUE )
+			if( MESS_OUT_verbose_mode is TRUE )
 			{
 				verbose_message( message );
 
@@ -847,7 +878,7 @@ void MESS_OUT_message( const S8* const message, const message_class class )
 			break;
 
 		case MESSAGE_OP_DEBUG :
-			if( debug_mode is TRUE )
+			if( MESS_OUT_debug_mode is TRUE )
 			{
 				info_message( message, TRUE );
 				debug_message( message, time_str );
@@ -882,15 +913,37 @@ void MESS_OUT_rename_results_file( const S8* const file_name )
 
 	DATE_get_time( time_str );	
 	
-	(void)sprintf( results_name, (S8*)"%s", file_name ); 
+	/* write out the old file before the name changes */
+	close_results();
+
+	(void)sprintf( results_name, (S8*)"%.*s", MAX_NAME_LEN - ONE_CPV, file_name ); 
 	
 	/* log renaming */
-	(void)sprintf( message, (S8*)"Results file named %s", file_name );
+	(void)sprintf( message, (S8*)"Results file named %.*s",
+				   MAX_NAME_LEN - TWENTY_CPV, file_name );
 	MESS_OUT_message(message, MESSAGE_OP_LOG );
 
 } /* MESS_OUT_launch_results_file() */
 
 
+/******************************************************************************
+*  Description : Names the log file, replacing the default log.txt
+******************************************************************************/
+void MESS_OUT_name_log_file( const S8* const file_name )
+{
+	S8 message[MAX_NAME_LEN + FIFTEEN_CPV];
+
+	(void)sprintf( message, (S8*)"Log file named %s", file_name );
+	MESS_OUT_message( message, MESSAGE_OP_LOG );
+
+	/* write out the old log before the name changes */
+	close_file( &log_ptr );
+
+	(void)sprintf( log_name, (S8*)"%.*s", MAX_NAME_LEN - ONE_CPV, file_name ); 
+
+} /* MESS_OUT_name_log_file() */
+
+
 /******************************************************************************
 *  Description : two message strings
 *  Parameters  : message1 - first message string
@@ -920,7 +973,7 @@ void MESS_OUT_message_1( const S8* const message, const U32 num,
 {
 	S8 full_message[TWO_HUNDRED_CPV];
 
-	sprintf( full_message, (S8*)"%s %d", message, num );
+	(void)put_message_number( full_message, message, num );
 
 	MESS_OUT_message( full_message, class );
 
@@ -940,8 +993,11 @@ void MESS_OUT_message_2( const S8* const message_1, const U32 num_1,
                          const message_class class )
 {
 	S8 full_message[TWO_HUNDRED_CPV];
+	U32 pos;
 
-	sprintf( full_message, (S8*)"%s %d %s %d", message_1, num_1, message_2, num_2 );
+	pos  = put_message_number( full_message, message_1, num_1 );
+	full_message[pos++] = ' ';
+	(void)put_message_number( &full_message[pos], message_2, num_2 );
 
 	MESS_OUT_message( full_message, class );
 
@@ -949,7 +1005,7 @@ void MESS_OUT_message_2( const S8* const message_1, const U32 num_1,
 
 
 /******************************************************************************
-*  Description : message with two numbers
+*  Description : message with three numbers
 *  Parameters  : message_1 - the message
 *                num_1     - number parameter
 *                message_2 - the message
@@ -964,9 +1020,13 @@ void MESS_OUT_message_3( const S8* const message_1, const U32 num_1,
                          const message_class class )
 {
 	S8 full_message[TWO_HUNDRED_CPV];
+	U32 pos;
 
-	sprintf( full_message, (S8*)"%s %d %s %d %s %d", 
-	         message_1, num_1, message_2, num_2, message_3, num_3 );
+	pos  = put_message_number( full_message, message_1, num_1 );
+	full_message[pos++] = ' ';
+	pos += put_message_number( &full_message[pos], message_2, num_2 );
+	full_message[pos++] = ' ';
+	(void)put_message_number( &full_message[pos], message_3, num_3 );
 
 	MESS_OUT_message( full_message, class );
 
@@ -974,7 +1034,7 @@ void MESS_OUT_message_3( const S8* const message_1, const U32 num_1,
 
 
 /******************************************************************************
-*  Description : message with two numbers
+*  Description : message with four numbers
 *  Parameters  : message_1 - the message
 *                num_1     - number parameter
 *                message_2 - the message
@@ -992,44 +1052,49 @@ void MESS_OUT_message_4( const S8* const message_1, const U32 num_1,
                          const message_class class )
 {
 	S8 full_message[TWO_HUNDRED_CPV];
+	U32 pos;
 
-	sprintf( full_message, (S8*)"%s %d %s %d %s %d %s %d", 
-	         message_1, num_1, message_2, num_2, 
-	         message_3, num_3, message_4, num_4 );
+	pos  = put_message_number( full_message, message_1, num_1 );
+	full_message[pos++] = ' ';
+	pos += put_message_number( &full_message[pos], message_2, num_2 );
+	full_message[pos++] = ' ';
+	pos += put_message_number( &full_message[pos], message_3, num_3 );
+	full_message[pos++] = ' ';
+	(void)put_message_number( &full_message[pos], message_4, num_4 );
 
 	MESS_OUT_message( full_message, class );
-}
+
+} /* MESS_OUT_message_4() */
+
 
 /******************************************************************************
 *  Description : outputs a scheduler report to the output
-*  Parameters  : param          : title string
-*                task_1 - task_7: task states.
+*  Parameters  : param  : title string
+*                values : task parameters, one per task
+*                count  : number of values, no more than fit on a line
 ******************************************************************************/
 void MESS_OUT_task_report(  const S8* const param,
-							const U32 task_1,
-							const U32 task_2,
-							const U32 task_3,
-							const U32 task_4,
-							const U32 task_5,
-							const U32 task_6,
-							const U32 task_7 )
+							const U32 *values,
+							const U32 count )
 {
 	S8 line[MAX_LINE_LEN];
 	U32 temp_time;
+	U32 index;
+	U32 pos;
 
 	/* stop timer */
 	temp_time = CLK_end_timer();
 
 	/* build a line */
-	sprintf(    line, (S8*)"%s%6d  %6d  %6d  %6d  %6d  %6d  %6d",
-				param,
-				task_1,
-				task_2,
-				task_3,
-				task_4,
-				task_5,
-				task_6,
-				task_7 );
+	pos = put_text( line, param );
+	for( index=0; index<count; index++ )
+	{
+		if( index is_not 0 )
+		{
+			pos += put_text( &line[pos], (S8*)"  " );
+		}
+		pos += UTL_format_int( &line[pos], (S32)values[index], SIX_CPV, ' ' );
+	}
 
 	/* send line to be copied to results file */
 	results_message( line );
@@ -1043,48 +1108,100 @@ void MESS_OUT_task_report(  const S8* const param,
 	CLK_start_timer( temp_time );
 } 
 
+/******************************************************************************
+*  Description : outputs a task number header line for tasks first to last
+*  Parameters  : head      : string before the task numbers
+*                first     : first task number
+*                last      : last task number
+*                tail      : string after the task numbers
+*                underline : TRUE to print the underline, not the numbers
+*  Notes       : the line grows with the task set, so is written a column
+*                at a time
+******************************************************************************/
+void MESS_OUT_task_header(  const S8* const head,
+							const U32 first,
+							const U32 last,
+							const S8* const tail,
+							const boolean underline )
+{
+	S8 name[MAX_NAME_LEN];
+	S8 column[MAX_NAME_LEN + TWO_CPV];
+	U32 temp_time;
+	U32 index;
+
+	/* stop timer */
+	temp_time = CLK_end_timer();
+
+	if( results_file() is_not NULL )
+	{
+		results_text( head, FALSE );
+		if( screen_results_mode is TRUE )
+		{
+			printf( (S8*)"%s", head );
+		}
+
+		for( index=first; index<=last; index++ )
+		{
+			/* six character column, two spaces apart */
+			if( underline is TRUE )
+			{
+				sprintf( name, (S8*)"======" );
+			}
+			else if( index < 10 )
+			{
+				sprintf( name, (S8*)"TASK-%d", index );
+			}
+			else
+			{
+				sprintf( name, (S8*)"T%d", index );
+			}
+
+			sprintf( column, (S8*)"%s%6s", (index is first) ? "" : "  ", name );
+			results_text( column, FALSE );
+			if( screen_results_mode is TRUE )
+			{
+				printf( (S8*)"%s", column );
+			}
+		}
+
+		results_text( tail, TRUE );
+		if( screen_results_mode is TRUE )
+		{
+			printf( (S8*)"%s\n", tail );
+		}
+	}
+
+	/* restart timer */
+	CLK_start_timer( temp_time );
+
+} /* MESS_OUT_task_header() */
+
 /******************************************************************************
 *  Description : outputs a report string of task states to output
-*  Parameters  : time : system time
-*                task_1 - task_7: task states.
-*                timestamp      : scheduler execution time
-*                overrun        : Overrun error flag
+*  Parameters  : time       : system time
+*                task_words : task states, one report word per task
+*                timestamp  : scheduler execution time
+*                overrun    : Overrun error flag
+*  Notes       : the task words grow with the task set, so are not copied
+*                into a fixed line buffer. The line is formatted by the
+*                results writer, not here
 ******************************************************************************/
 void MESS_OUT_scheduler_report( const U32 time,
-								const S8* const task_1,
-								const S8* const task_2,
-								const S8* const task_3,
-								const S8* const task_4,
-								const S8* const task_5,
-								const S8* const task_6,
-								const S8* const task_7,
+								const S8* const task_words,
 								const U32 timestamp,
 								const S8* const overrun )
 {
-	S8 line[MAX_LINE_LEN];
 	U32 temp_time;
 
 	/* stop timer */
 	temp_time = CLK_end_timer();
 
-	sprintf( line, (S8*)"%05d %s%s%s%s%s%s%s %05d   %s",
-		time,
-		task_1,
-		task_2,
-		task_3,
-		task_4,
-		task_5,
-		task_6,
-		task_7,
-		timestamp,
-		overrun );
-
 	/* send line to be copied to results file */
-	results_message( line );
+	results_report( time, task_words, timestamp, overrun );
 
 	if( screen_results_mode is TRUE )
 	{
-		info_message( line, TRUE );
+		printf( (S8*)"%05d %s %05d   %s\n", time, task_words, timestamp, overrun );
 	}
 
 	/* restart timer */
@@ -1093,6 +1210,118 @@ void MESS_OUT_scheduler_report( const U32 time,
 } /* MESS_OUT_scheduler_report() */
 
 
+/******************************************************************************
+*  Description : outputs a scheduler report to a binary trace, as a record
+*                of task report codes rather than a line of report words
+*  Parameters  : time      : system time
+*                codes     : task report codes, one per task
+*                count     : number of tasks
+*                timestamp : scheduler execution time
+*                running   : running task, 0 if none
+*                overrun   : TRUE if a task has overrun its deadline
+******************************************************************************/
+void MESS_OUT_scheduler_trace( const U32 time, const U8* const codes,
+                               const U32 count, const U32 timestamp,
+                               const U32 running, const boolean overrun )
+{
+	U8 record[TRC_TICK_HEAD_SIZE];
+	U32 size;
+	U32 temp_time;
+	U32 index;
+
+	/* stop timer */
+	temp_time = CLK_end_timer();
+
+	if( results_file() is_not NULL )
+	{
+		results_progress();
+
+		if( trace_repeats( time, codes, count, running, overrun ) is TRUE )
+		{
+			/* change only trace - just count the tick. A run whose total
+			   overhead would wrap is written out and a new one started */
+			if( trace_run.overhead > ((U32)0xFFFFFFFF - timestamp) )
+			{
+				trace_end_run();
+			}
+
+			trace_run.time = time;
+			trace_run.ticks++;
+			trace_run.overhead += timestamp;
+		}
+		else
+		{
+			trace_end_run();
+
+			/* the tick records carry a code per task */
+			if( count is_not trace_tasks )
+			{
+				record[ZERO_CPV] = (U8)TRC_REC_TASKS;
+				size = ONE_CPV + TRC_put_number( &record[ONE_CPV], count );
+				results_data( record, size );
+				trace_tasks = count;
+
+				free( trace_run.codes );
+				trace_run.codes = NULL;
+				trace_run.valid = FALSE;
+				if( trace_mode is TRC_MODE_CHANGES )
+				{
+					trace_run.codes = (U8*)malloc( count );
+				}
+			}
+
+			size = TRC_tick_head( record, time, timestamp, running, overrun );
+			results_data( record, size );
+			results_data( codes, count );
+
+			if( trace_run.codes is_not NULL )
+			{
+				/* the tick to compare the next ones with */
+				(void)memcpy( trace_run.codes, codes, count );
+				trace_run.time    = time;
+				trace_run.running = running;
+				trace_run.valid   = TRUE;
+			}
+		}
+	}
+
+	if( screen_results_mode is TRUE )
+	{
+		printf( (S8*)"%05d ", time );
+		for( index=ZERO_CPV; index<count; index++ )
+		{
+			printf( (S8*)"%s", TRC_word( codes[index] ) );
+		}
+		printf( (S8*)" %05d   %s\n", timestamp, (overrun is TRUE) ? "OVERRUN" : "" );
+	}
+
+	/* restart timer */
+	CLK_start_timer( temp_time );
+
+} /* MESS_OUT_scheduler_trace() */
+
+
+/******************************************************************************
+*  Description : Access function to set the results trace format, for
+*                results files opened from now on
+******************************************************************************/
+void MESS_OUT_set_trace_mode( const trace_mode_type mode )
+{
+	trace_mode = mode;
+
+} /* MESS_OUT_set_trace_mode() */
+
+
+/******************************************************************************
+*  Description : Access function to get the results trace format
+******************************************************************************/
+trace_mode_type MESS_OUT_trace_mode( void )
+{
+	return( trace_mode );
+
+} /* MESS_OUT_trace_mode() */
+
+
 /******************************************************************************
 *  Description : Close down stuff goes in here
 ******************************************************************************/
@@ -1114,9 +1343,9 @@ void MESS_OUT_close( void )
 	/* opening message */
  	log_message( end_message_str, date_str );
 
-	/* close any opened file, though should be already closed */
-	close_file( log_ptr, date_str );
-	close_file( results_ptr, date_str );
+	/* write out and close the files */
+	close_file( &log_ptr );
+	close_results();
 
 } /* MESS_OUT_close() */
 
@@ -1130,24 +1359,24 @@ void MESS_OUT_toggle_debug_mode( void )
 	S8 time_str[TIME_STR_SIZE];	
 	DATE_get_time( time_str );
 
-	if( debug_mode is FALSE )
+	if( MESS_OUT_debug_mode is FALSE )
 	{
  		info_message( (S8*)"Debug mode ON", TRUE );
  		log_message(  (S8*)"Debug mode ON", time_str );		
-		debug_mode = TRUE;
+		MESS_OUT_debug_mode = TRUE;
 	}
 	else
 	{
  		info_message( (S8*)"Debug mode OFF", TRUE );
  		log_message(  (S8*)"Debug mode OFF", time_str );		
-		debug_mode = FALSE;
+		MESS_OUT_debug_mode = FALSE;
 	}
 
 } /* MESS_OUT_toggle_debug_mode() */
 
 
 /******************************************************************************
-*  Description : Access function to toggle verbose_mode messaging
+*  Description : Access function to toggle MESS_OUT_verbose_mode messaging
 ******************************************************************************/
 void MESS_OUT_toggle_verbose_mode( void )
 {
@@ -1155,17 +1384,17 @@ void MESS_OUT_toggle_verbose_mode( void )
 	S8 time_str[TIME_STR_SIZE];	
 	DATE_get_time( time_str );
 
-	if( verbose_mode is FALSE )
+	if( MESS_OUT_verbose_mode is FALSE )
 	{
  		info_message( (S8*)"Verbose mode ON", TRUE );
  		log_message(  (S8*)"Verbose mode ON", time_str );		
-		verbose_mode = TRUE;
+		MESS_OUT_verbose_mode = TRUE;
 	}
 	else
 	{
  		info_message( (S8*)"Verbose mode OFF", TRUE );
  		log_message(  (S8*)"Verbose mode OFF", time_str );		
-		verbose_mode = FALSE;
+		MESS_OUT_verbose_mode = FALSE;
 	}
 
 } /* MESS_OUT_toggle_verbose_mode() */
@@ -1196,6 +1425,26 @@ void MESS_OUT_toggle_screen_results_mode( void )
 } /* MESS_OUT_toggle_screen_results_mode() */
 
 
+/******************************************************************************
+*  Description : Access function to set debug messaging on or off
+******************************************************************************/
+void MESS_OUT_set_debug_mode( const boolean mode )
+{
+	MESS_OUT_debug_mode = mode;
+
+} /* MESS_OUT_set_debug_mode() */
+
+
+/******************************************************************************
+*  Description : Access function to set verbose messaging on or off
+******************************************************************************/
+void MESS_OUT_set_verbose_mode( const boolean mode )
+{
+	MESS_OUT_verbose_mode = mode;
+
+} /* MESS_OUT_set_verbose_mode() */
+
+
 /******************************************************************************
 *  Description : Report status of system
 ******************************************************************************/
@@ -1203,7 +1452,7 @@ void MESS_OUT_report_status( const message_class class )
 {
 	MESS_OUT_message( (S8*)"Status:", class );
 
-	if( verbose_mode is TRUE )
+	if( MESS_OUT_verbose_mode is TRUE )
 	{
 	 	MESS_OUT_message( (S8*)"Verbose mode ON",  class );
 	}
@@ -1212,7 +1461,7 @@ void MESS_OUT_report_status( const message_class class )
 	 	MESS_OUT_message( (S8*)"Verbose mode OFF", class );
 	}
 
-	if( debug_mode is TRUE )
+	if( MESS_OUT_debug_mode is TRUE )
 	{
 	 	MESS_OUT_message( (S8*)"Debug mode ON",  class );
 	}
@@ -1251,47 +1500,607 @@ void MESS_OUT_report_duration( void )
 } /* MESS_OUT_report_duration() */
 
 
+/******************************************************************************
+*  Description : Writes out and closes this thread's results and log files,
+*                called at the end of each test. The files are opened again
+*                by the next message written to them.
+******************************************************************************/
+void MESS_OUT_flush( void )
+{
+	close_results();
+	close_file( &log_ptr );
+
+} /* MESS_OUT_flush() */
+
+
 /******************************************************************************
 *                            PRIVATE FUNCTIONS								  *
 ******************************************************************************/
 
 
 /******************************************************************************
-*  Description : closes a file - should not be needed
+*  Description : returns the results file, opening it if it is not open.
+*                The file is fully buffered, so lines are only written out
+*                when the buffer fills, the file is renamed, the test ends
+*                or an error is reported. With MESS_OUT_ASYNC a writer
+*                thread is started to write to it. A binary trace is opened
+*                as a binary file.
+*  Returns     : results file, or NULL if it cannot be opened
+******************************************************************************/
+static FILE* results_file( void )
+{
+	boolean new_trace;
+
+	if( results_ptr is NULL )
+	{
+		results_ptr = fopen( results_name,
+		                     (trace_mode is_not TRC_MODE_TEXT) ? (S8*)"ab" : (S8*)"a" );
+
+		if( results_ptr is_not NULL )
+		{
+			(void)setvbuf( results_ptr, results_buffer, _IOFBF, RESULTS_BUFFER_SIZE );
+
+			/* an empty file starts a new binary trace */
+			new_trace = ( (trace_mode is_not TRC_MODE_TEXT) and
+			              (fseek( results_ptr, 0L, SEEK_END ) is ZERO_CPV) and
+			              (ftell( results_ptr ) is 0L) ) ? TRUE : FALSE;
+			trace_tasks = ZERO_CPV;
+			trace_run.valid = FALSE;
+
+			#if MESS_OUT_ASYNC
+			start_writer();
+			#endif
+
+			if( new_trace is TRUE )
+			{
+				results_data( (U8*)TRC_MAGIC, TRC_MAGIC_SIZE );
+			}
+		}
+	}
+
+	return( results_ptr );
+
+} /* results_file() */
+
+
+/******************************************************************************
+*  Description : returns the log file, opening it if it is not open.
+*                The log is shared by the sweep threads, so it is line
+*                buffered to keep each line in one write.
+*  Returns     : log file, or NULL if it cannot be opened
+******************************************************************************/
+static FILE* log_file( void )
+{
+	if( log_ptr is NULL )
+	{
+		log_ptr = fopen( log_name, (S8*)"a" );
+
+		if( log_ptr is_not NULL )
+		{
+			(void)setvbuf( log_ptr, NULL, _IOLBF, BUFSIZ );
+		}
+	}
+
+	return( log_ptr );
+
+} /* log_file() */
+
+
+/******************************************************************************
+*  Description : writes out and closes a file, if it is open
 ******************************************************************************/
-static void close_file( FILE* file_ptr, const S8* const time_str )
+static void close_file( FILE** file_ptr )
 {
 	/* close file if opened */
-	if( file_ptr is_not NULL )
+	if( *file_ptr is_not NULL )
 	{	
-		MESS_OUT_message( (S8*)"File closed", MESSAGE_OP_DEBUG );
-	   	(void)fclose( file_ptr );
-		file_ptr = NULL;
+	   	(void)fclose( *file_ptr );
+		*file_ptr = NULL;
 	}
 
 } /* close_file() */
 
+
+/******************************************************************************
+*  Description : writes text to the open results file, through the results
+*                ring if the writer is running
+*  Parameters  : text        - text to write
+*                end_of_line - TRUE to end the line after the text
+******************************************************************************/
+static void results_text( const S8* const text, const boolean end_of_line )
+{
+	U8 record[FIVE_CPV];
+	U32 length;
+
+	length = (U32)strlen( text );
+
+	if( trace_mode is_not TRC_MODE_TEXT )
+	{
+		/* text is carried in text records, after any held ticks */
+		trace_end_run();
+		record[ZERO_CPV] = (U8)((end_of_line is TRUE) ? TRC_REC_LINE : TRC_REC_TEXT);
+		(void)TRC_put_number( &record[ONE_CPV], length );
+		results_data( record, FIVE_CPV );
+		results_data( (U8*)text, length );
+	}
+	#if MESS_OUT_ASYNC
+	else if( results_ring.running is TRUE )
+	{
+		ring_bytes( (U8*)text, length, end_of_line );
+	}
+	#endif
+	else
+	{
+		(void)fputs( text, results_ptr );
+		if( end_of_line is TRUE )
+		{
+			(void)fputc( '\n', results_ptr );
+		}
+	}
+
+} /* results_text() */
+
+
+/******************************************************************************
+*  Description : writes bytes to the open results file, through the results
+*                ring if the writer is running
+*  Parameters  : data   - bytes to write
+*                length - number of bytes
+******************************************************************************/
+static void results_data( const U8* const data, const U32 length )
+{
+	#if MESS_OUT_ASYNC
+	if( results_ring.running is TRUE )
+	{
+		ring_bytes( data, length, FALSE );
+	}
+	else
+	#endif
+	{
+		(void)fwrite( data, ONE_CPV, length, results_ptr );
+	}
+
+} /* results_data() */
+
+
+/******************************************************************************
+*  Description : shows a results line is written, while a test runs
+******************************************************************************/
+static void results_progress( void )
+{
+	if( (screen_results_mode is_not TRUE) and (sim_context.mode is MODE_SIMULATION) )
+	{
+		/* send progress indicator to terminal */
+		info_message( (S8*)">", FALSE );
+	} 
+
+} /* results_progress() */
+
+
+/******************************************************************************
+*  Description : change only trace - checks whether a tick repeats the last
+*                tick record. It must follow on from it with the same
+*                running task and task report codes, and no deadline or
+*                overrun in it.
+*  Parameters  : time    : system time
+*                codes   : task report codes, one per task
+*                count   : number of tasks
+*                running : running task, 0 if none
+*                overrun : TRUE if a task has overrun its deadline
+*  Returns     : TRUE if only the tick count need be kept
+******************************************************************************/
+static boolean trace_repeats( const U32 time, const U8* const codes,
+                              const U32 count, const U32 running,
+                              const boolean overrun )
+{
+	boolean repeats = FALSE;
+	U32 index;
+
+	if( (trace_run.valid is TRUE) and
+	    (overrun is FALSE) and
+	    (count is trace_tasks) and
+	    (time is (trace_run.time + ONE_CPV)) and
+	    (running is trace_run.running) and
+	    (memcmp( codes, trace_run.codes, count ) is ZERO_CPV) )
+	{
+		repeats = TRUE;
+
+		for( index=ZERO_CPV; index<count; index++ )
+		{
+			if( (codes[index] & TRC_DEADLINE) is_not ZERO_CPV )
+			{
+				repeats = FALSE;
+			}
+		}
+	}
+
+	return( repeats );
+
+} /* trace_repeats() */
+
+
+/******************************************************************************
+*  Description : change only trace - writes the repeated ticks held since
+*                the last tick record, if any
+******************************************************************************/
+static void trace_end_run( void )
+{
+	U8 record[TRC_REPEAT_SIZE];
+	U32 size;
+
+	if( (trace_run.ticks > ZERO_CPV) and (results_ptr is_not NULL) )
+	{
+		size = TRC_repeat( record, trace_run.ticks, trace_run.overhead );
+		results_data( record, size );
+	}
+
+	trace_run.ticks    = ZERO_CPV;
+	trace_run.overhead = ZERO_CPV;
+
+} /* trace_end_run() */
+
+
+/******************************************************************************
+*  Description : writes a scheduler report line to the results file. With
+*                the writer running only the numbers and task words are
+*                passed on, the writer formats the line
+******************************************************************************/
+static void results_report( const U32 time, const S8* const task_words,
+                            const U32 timestamp, const S8* const overrun )
+{
+	#if MESS_OUT_ASYNC
+	struct ring_record_type *record;
+	#endif
+
+	if( results_file() is_not NULL )
+	{
+		results_progress();
+
+		#if MESS_OUT_ASYNC
+		if( results_ring.running is TRUE )
+		{
+			record = ring_next();
+			record->kind  = RING_REPORT_HEAD;
+			record->value = time;
+			ring_publish();
+
+			ring_bytes( (U8*)task_words, (U32)strlen( task_words ), FALSE );
+
+			record = ring_next();
+			record->kind  = RING_REPORT_TAIL;
+			record->value = timestamp;
+			(void)sprintf( record->text, (S8*)"%.*s", RING_TEXT_SIZE, overrun );
+			ring_publish();
+		}
+		else
+		#endif
+		{
+			write_report_head( results_ptr, time );
+			(void)fputs( task_words, results_ptr );
+			write_report_tail( results_ptr, timestamp, overrun );
+		}
+	}
+
+} /* results_report() */
+
+
+/******************************************************************************
+*  Description : copies text into a line being built
+*  Returns     : characters copied, not counting the terminating '\0'
+******************************************************************************/
+static U32 put_text( S8 *line, const S8* const text )
+{
+	U32 pos = ZERO_CPV;
+
+	while( (line[pos] = text[pos]) is_not '\0' )
+	{
+		pos++;
+	}
+
+	return( pos );
+
+} /* put_text() */
+
+
+/******************************************************************************
+*  Description : builds a message followed by a number, as "%s %d"
+*  Returns     : characters written, not counting the terminating '\0'
+******************************************************************************/
+static U32 put_message_number( S8 *line, const S8* const message, const U32 num )
+{
+	U32 pos;
+
+	pos = put_text( line, message );
+	line[pos++] = ' ';
+	pos += UTL_format_int( &line[pos], (S32)num, ZERO_CPV, ' ' );
+
+	return( pos );
+
+} /* put_message_number() */
+
+
+/******************************************************************************
+*  Description : writes the time at the start of a scheduler report line
+******************************************************************************/
+static void write_report_head( FILE *file, const U32 time )
+{
+	S8 head[TWELVE_CPV + TWO_CPV];
+	U32 pos;
+
+	pos = UTL_format_int( head, (S32)time, FIVE_CPV, '0' );
+	head[pos++] = ' ';
+
+	(void)fwrite( head, ONE_CPV, pos, file );
+
+} /* write_report_head() */
+
+
+/******************************************************************************
+*  Description : writes the scheduler execution time and overrun flag at
+*                the end of a scheduler report line
+******************************************************************************/
+static void write_report_tail( FILE *file, const U32 timestamp, const S8* const overrun )
+{
+	S8 tail[TWELVE_CPV + FIVE_CPV];
+	U32 pos;
+
+	tail[ZERO_CPV] = ' ';
+	pos  = ONE_CPV + UTL_format_int( &tail[ONE_CPV], (S32)timestamp, FIVE_CPV, '0' );
+	pos += put_text( &tail[pos], (S8*)"   " );
+
+	(void)fwrite( tail, ONE_CPV, pos, file );
+	(void)fputs( overrun, file );
+	(void)fputc( '\n', file );
+
+} /* write_report_tail() */
+
+
+/******************************************************************************
+*  Description : writes out everything sent to the results file so far,
+*                waiting for the writer to catch up if it is running
+******************************************************************************/
+static void flush_results( void )
+{
+	#if MESS_OUT_ASYNC
+	struct ring_record_type *record;
+	#endif
+
+	trace_end_run();
+
+	#if MESS_OUT_ASYNC
+	if( results_ring.running is TRUE )
+	{
+		record = ring_next();
+		record->kind = RING_FLUSH;
+		ring_publish();
+
+		while( __atomic_load_n( &results_ring.tail, __ATOMIC_ACQUIRE ) is_not results_ring.head )
+		{
+			(void)sched_yield();
+		}
+	}
+	else
+	#endif
+	if( results_ptr is_not NULL )
+	{
+		(void)fflush( results_ptr );
+	}
+
+} /* flush_results() */
+
+
+/******************************************************************************
+*  Description : stops the writer, if running, then writes out and closes
+*                the results file
+******************************************************************************/
+static void close_results( void )
+{
+	trace_end_run();
+
+	#if MESS_OUT_ASYNC
+	stop_writer();
+	#endif
+
+	close_file( &results_ptr );
+
+	free( trace_run.codes );
+	trace_run.codes = NULL;
+	trace_run.valid = FALSE;
+
+} /* close_results() */
+
+
+#if MESS_OUT_ASYNC
+/******************************************************************************
+*  Description : starts the results writer on the newly opened results file.
+*                If the thread cannot be started results are written on
+*                the calling thread as before.
+******************************************************************************/
+static void start_writer( void )
+{
+	results_ring.head = ZERO_CPV;
+	results_ring.tail = ZERO_CPV;
+	results_ring.file = results_ptr;
+
+	if( pthread_create( &results_ring.writer, NULL,
+	                    results_writer, &results_ring ) is ZERO_CPV )
+	{
+		results_ring.running = TRUE;
+	}
+	else
+	{
+		results_ring.running = FALSE;
+	}
+
+} /* start_writer() */
+
+
+/******************************************************************************
+*  Description : tells the results writer to finish once it has written
+*                everything in the ring, and waits for it
+******************************************************************************/
+static void stop_writer( void )
+{
+	struct ring_record_type *record;
+
+	if( results_ring.running is TRUE )
+	{
+		record = ring_next();
+		record->kind = RING_STOP;
+		ring_publish();
+
+		(void)pthread_join( results_ring.writer, NULL );
+		results_ring.running = FALSE;
+	}
+
+} /* stop_writer() */
+
+
+/******************************************************************************
+*  Description : results writer thread - takes records from the ring in
+*                order, formats them and writes them to the results file.
+*                Sleeps briefly whenever the ring is empty.
+*  Parameters  : arg - results ring of the simulation thread
+******************************************************************************/
+static void *results_writer( void *arg )
+{
+	struct results_ring_type *ring = (struct results_ring_type*)arg;
+	const struct timespec idle = { 0, RING_IDLE_NS };
+	struct ring_record_type *record;
+	boolean stop = FALSE;
+
+	while( stop is FALSE )
+	{
+		if( ring->tail is __atomic_load_n( &ring->head, __ATOMIC_ACQUIRE ) )
+		{
+			/* nothing to write */
+			(void)nanosleep( &idle, NULL );
+		}
+		else
+		{
+			record = &ring->records[ring->tail & (RING_SLOTS - ONE_CPV)];
+
+			switch( record->kind )
+			{
+				case RING_TEXT:
+					(void)fwrite( record->text, ONE_CPV, record->value, ring->file );
+					if( record->last is TRUE )
+					{
+						(void)fputc( '\n', ring->file );
+					}
+					break;
+
+				case RING_REPORT_HEAD:
+					write_report_head( ring->file, record->value );
+					break;
+
+				case RING_REPORT_TAIL:
+					write_report_tail( ring->file, record->value, record->text );
+					break;
+
+				case RING_FLUSH:
+					(void)fflush( ring->file );
+					break;
+
+				case RING_STOP:
+				default:
+					stop = TRUE;
+					break;
+			}
+
+			/* hand the slot back */
+			__atomic_store_n( &ring->tail, ring->tail + ONE_CPV, __ATOMIC_RELEASE );
+		}
+	}
+
+	return( NULL );
+
+} /* results_writer() */
+
+
+/******************************************************************************
+*  Description : returns the next free ring record, waiting for the writer
+*                to free one if the ring is full
+******************************************************************************/
+static struct ring_record_type *ring_next( void )
+{
+	while( (results_ring.head - __atomic_load_n( &results_ring.tail, __ATOMIC_ACQUIRE ))
+	       >= RING_SLOTS )
+	{
+		/* ring full - let the writer catch up */
+		(void)sched_yield();
+	}
+
+	return( &results_ring.records[results_ring.head & (RING_SLOTS - ONE_CPV)] );
+
+} /* ring_next() */
+
+
+/******************************************************************************
+*  Description : passes the record filled in after ring_next() to the writer
+******************************************************************************/
+static void ring_publish( void )
+{
+	__atomic_store_n( &results_ring.head, results_ring.head + ONE_CPV, __ATOMIC_RELEASE );
+
+} /* ring_publish() */
+
+
+/******************************************************************************
+*  Description : sends text or binary trace bytes to the writer, split over
+*                as many records as it needs
+*  Parameters  : data        - bytes to write
+*                length      - number of bytes
+*                end_of_line - TRUE to end the line after the text
+******************************************************************************/
+static void ring_bytes( const U8* const data, const U32 length,
+                        const boolean end_of_line )
+{
+	struct ring_record_type *record;
+	const U8 *next = data;
+	U32 left = length;
+	U32 size;
+
+	/* an empty line still needs its record */
+	if( (left > ZERO_CPV) or (end_of_line is TRUE) )
+	{
+		do
+		{
+			size = (left > RING_TEXT_SIZE) ? RING_TEXT_SIZE : left;
+
+			record = ring_next();
+			record->kind  = RING_TEXT;
+			record->value = size;
+			(void)memcpy( record->text, next, size );
+
+			next += size;
+			left -= size;
+			record->last = ((left is ZERO_CPV) and (end_of_line is TRUE)) ? TRUE : FALSE;
+
+			ring_publish();
+		}
+		while( left > ZERO_CPV );
+	}
+
+} /* ring_bytes() */
+#endif /* MESS_OUT_ASYNC */
+
  
 /******************************************************************************
 *  Description : Error message handler 
 ******************************************************************************/
 static void error_message( const S8* const message, const S8* const time_str )
 {
-	/* open the error log file */
-	log_ptr = fopen( log_name, (S8*)"a" );
-
-	if( log_ptr is_not NULL )
+	if( log_file() is_not NULL )
 	{
 		/* send messaeg to the log file */
 		(void)fprintf( log_ptr, (S8*)"ERROR %s : %s\n", time_str, message );
-
-		/* now close the log file */
-		(void)fclose( log_ptr );
-
-		/* clear the pointer */
-		log_ptr = NULL;
+		(void)fflush( log_ptr );
 	}
 
+	/* write out the results so far, they lead up to the error */
+	flush_results();
+
 } /* error_message() */
 
 
@@ -1300,19 +2109,10 @@ static void error_message( const S8* const message, const S8* const time_str )
 ******************************************************************************/
 static void debug_message( const S8* const message, const S8* const time_str )
 {
-	/* open the log file */
-	log_ptr = fopen( log_name, (S8*)"a" );
-
-	if( log_ptr is_not NULL )
+	if( log_file() is_not NULL )
 	{
 		/* send messaeg to the log file */
 		(void)fprintf( log_ptr, (S8*)"DEBUG %s : %s\n", time_str, message );
-
-		/* now close the log file */
-		(void)fclose( log_ptr );
-
-		/* clear the pointer */
-		log_ptr = NULL;
 	}
 
 } /* debug_message() */
@@ -1323,28 +2123,29 @@ static void debug_message( const S8* const message, const S8* const time_str )
 ******************************************************************************/
 static void results_message( const S8* const message )
 {
-	/* open the results file */
-	results_ptr = fopen( results_name, (S8*)"a" );
+	results_line( (S8*)"", message, (S8*)"" );
 
-	if( results_ptr is_not NULL )
-	{
-		if( (screen_results_mode is_not TRUE) and (mode is MODE_SIMULATION) )
-		{
-			/* send progress indicator to terminal */
-			info_message( (S8*)">", FALSE );
-		} 
-		
-		/* send message to the log file */
-		(void)fprintf( results_ptr, (S8*)"%s\n", message );
+} /* results_message() */  
 
-		/* now close the log file */
-		(void)fclose( results_ptr );
 
-		/* clear the pointer */
-		results_ptr = NULL;
+/******************************************************************************
+*  Description : Results line handler - writes a line built from three parts
+*                to the results file
+******************************************************************************/
+static void results_line( const S8* const head, const S8* const body,
+                          const S8* const tail )
+{
+	if( results_file() is_not NULL )
+	{
+		results_progress();
+		
+		/* send message to the results file */
+		results_text( head, FALSE );
+		results_text( body, FALSE );
+		results_text( tail, TRUE );
 	}
 
-} /* results_message() */  
+} /* results_line() */  
 
 
 /******************************************************************************
@@ -1369,19 +2170,10 @@ static void info_message( const S8* const message, const boolean cr )
 ******************************************************************************/
 static void log_message( const S8* const message, const S8* const time_str )
 {
-	/* open the log file */
-	log_ptr = fopen( log_name, (S8*)"a" );
-
-	if( log_ptr is_not NULL )
+	if( log_file() is_not NULL )
 	{
 		/* send messaeg to the log file */
 		(void)fprintf( log_ptr, (S8*)"LOG %s: %s\n", time_str, message );
-
-		/* now close the log file */
-		(void)fclose(  log_ptr );
-
-		/* clear the pointer */
-		log_ptr = NULL;
 	}
 
 } /* info_message() */
@@ -1392,19 +2184,10 @@ static void log_message( const S8* const message, const S8* const time_str )
 ******************************************************************************/
 static void verbose_message( const S8* const message )
 {
-	/* open the results file */
-	results_ptr = fopen( results_name, "a" );
-
-	if( results_ptr is_not NULL )
+	if( results_file() is_not NULL )
 	{
-		/* send message to the log file */
-		(void)fprintf( results_ptr, (S8*)"%s\n", message );
-
-		/* now close the log file */
-		(void)fclose( results_ptr );
-
-		/* clear the pointer */
-		results_ptr = NULL;
+		/* send message to the results file */
+		results_text( message, TRUE );
 	}
 
 } /* verbose_message() */
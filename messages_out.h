@@ -15,12 +15,62 @@
 *                                                                             *
 * date     |Aut| Description                                                  *
 * 18-11-05 |JRO| Created - porting from scheduler project                     *
+* 17-10-26 |JRO| Added mode setters and MESS_OUT_name_log_file()              *
+* 17-10-26 |JRO| Task and scheduler reports take any number of tasks          *
+* 17-10-26 |JRO| Added MESS_OUT_flush()                                       *
+* 17-10-26 |JRO| Added MESS_OUT_ASYNC build option                            *
+* 17-10-26 |JRO| Added binary results trace                                   *
+* 17-10-26 |JRO| Added MESS_OUT_LEVEL build option                            *
 *          |   |                                                              *
 *                                                                             *
 ******************************************************************************/
 #ifndef _MESSAGES_OUT_H_
 #define _MESSAGES_OUT_H_
 
+#include "trace.h"
+
+/* PC build: results are formatted and written by a writer thread, so the
+   simulation does not wait on the disk. Build with -DMESS_OUT_ASYNC=0 to
+   write them on the simulating thread */
+#ifndef MESS_OUT_ASYNC
+    #ifdef DEV_SYSTEM
+        #define MESS_OUT_ASYNC  0
+    #else
+        #define MESS_OUT_ASYNC  1
+    #endif
+#endif
+
+
+/* debug and verbose messages compiled in - the MESS_OUT_DEBUG() and
+   MESS_OUT_VERBOSE() calls above the build level compile to nothing. Build
+   with -DMESS_OUT_LEVEL=MESS_OUT_LEVEL_INFO for sweeps that want neither */
+#define MESS_OUT_LEVEL_INFO     0   /* info, log, error and results only  */
+#define MESS_OUT_LEVEL_VERBOSE  1   /* and verbose messages               */
+#define MESS_OUT_LEVEL_DEBUG    2   /* and debug messages                 */
+
+#ifndef MESS_OUT_LEVEL
+    #define MESS_OUT_LEVEL  MESS_OUT_LEVEL_DEBUG
+#endif
+
+/* wrap a debug or verbose message call, which is then only made if the
+   class is compiled in and switched on */
+#if MESS_OUT_LEVEL >= MESS_OUT_LEVEL_DEBUG
+    #define MESS_OUT_DEBUG( call ) \
+        do { if( MESS_OUT_debug_mode is TRUE ) { call; } } while( 0 )
+#else
+    #define MESS_OUT_DEBUG( call )      do { } while( 0 )
+#endif
+
+#if MESS_OUT_LEVEL >= MESS_OUT_LEVEL_VERBOSE
+    #define MESS_OUT_VERBOSE( call ) \
+        do { if( MESS_OUT_verbose_mode is TRUE ) { call; } } while( 0 )
+#else
+    #define MESS_OUT_VERBOSE( call )    do { } while( 0 )
+#endif
+
+extern boolean MESS_OUT_debug_mode;    /* debug messages switched on   */
+extern boolean MESS_OUT_verbose_mode;  /* verbose messages switched on */
+
 
 /* message classes */
 typedef enum
@@ -57,27 +107,30 @@ void MESS_OUT_message_4( const S8* const message_1, const U32 num_1,
 						 const S8* const message_4, const U32 num_4,
                          const message_class class );
 void MESS_OUT_task_report(  const S8* const param,
-							const U32 task_1,
-							const U32 task_2,
-							const U32 task_3,
-							const U32 task_4,
-							const U32 task_5,
-							const U32 task_6,
-							const U32 task_7 );
+							const U32 *values,
+							const U32 count );
+void MESS_OUT_task_header(  const S8* const head,
+							const U32 first,
+							const U32 last,
+							const S8* const tail,
+							const boolean underline );
 void MESS_OUT_scheduler_report( const U32 time,
-								const S8* const task_1,
-								const S8* const task_2,
-								const S8* const task_3,
-								const S8* const task_4,
-								const S8* const task_5,
-								const S8* const task_6,
-								const S8* const task_7,
+								const S8* const task_words,
 								const U32 timestamp,
 								const S8* const overrun );
 void MESS_OUT_toggle_debug_mode( void );		
 void MESS_OUT_toggle_verbose_mode( void );		
 void MESS_OUT_toggle_screen_results_mode( void );
+void MESS_OUT_set_debug_mode( const boolean mode );
+void MESS_OUT_set_verbose_mode( const boolean mode );
 void MESS_OUT_report_status( const message_class class );
 void MESS_OUT_report_duration( void );
 void MESS_OUT_rename_results_file( const S8* const file_name );
+void MESS_OUT_name_log_file( const S8* const file_name );
+void MESS_OUT_flush( void );
+void MESS_OUT_scheduler_trace( const U32 time, const U8* const codes,
+                               const U32 count, const U32 timestamp,
+                               const U32 running, const boolean overrun );
+void MESS_OUT_set_trace_mode( const trace_mode_type mode );
+trace_mode_type MESS_OUT_trace_mode( void );
 #endif /* _MESSAGES_OUT_H_ */
@@ -9,28 +9,95 @@
 *                                                                             *
 * Description :  This module contains queue utilities                         *
 *                                                                             *
+*                A heap queue keeps task ids in a d-ary heap, so insert,      *
+*                removal and re-keying are O(log n) against the O(n) list     *
+*                insert. Each task's key is taken when it is inserted, as     *
+*                the list places a task once, and ties are broken on insert   *
+*                order, last in first out or first in first out to match the  *
+*                linked list queues.                                          *
+*                                                                             *
+*                A timing wheel holds tasks waiting for their abs_dline, one  *
+*                slot per timer tick of the current turn of the wheel. Later  *
+*                turns have a slot each in a second level, and releases past  *
+*                that wait in an overflow list. Tasks move down a level as    *
+*                the cursor reaches them. Insert is O(1), the tasks due at a  *
+*                tick are found in its slot, and the earliest release is kept *
+*                so it is not searched for on every event.                    *
+*                                                                             *
 *******************************************************************************
 * Modification record:                                                        *
 *                                                                             *
 * Date     |Aut| Description                                                  *
 * 27-09-05 |JRO| Created                                                      *
+* 17-10-26 |JRO| Added heap ordered task queue                                *
+* 17-10-26 |JRO| Added timing wheel release queue                             *
+* 17-10-26 |JRO| Queues ordered by q_order_type instead of algorithm          *
+* 17-10-26 |JRO| Heap orders laxity and urgency on the time-relative key      *
+* 17-10-26 |JRO| Heap keys taken on insert and kept in the task, as the list  *
 *          |   |                                                              *
 *                                                                             *
 ******************************************************************************/
 #include "globals.h"
-/* #include "messages_out.h" */
+#include "messages_out.h"
+#include "task.h"
+#include "scheduler.h"
 #include "q_utils.h"
+#include "context.h"
 
+#ifndef DEV_SYSTEM
+	#include <stdlib.h>		/* heap allocation */
+#endif
 	
+/* wheel slot of a timer tick, and its turn of the wheel */
+#define WHEEL_SLOT( t )	((t) & (QUTIL_WHEEL_SLOTS - 1))
+#define WHEEL_TURN( t )	((t) / QUTIL_WHEEL_SLOTS)
+
+/* second level turn of a timer tick, and the list of its turn in that */
+#define WHEEL_EPOCH( t )		((t) / (QUTIL_WHEEL_SLOTS * QUTIL_WHEEL_TURNS))
+#define WHEEL_TURN_LIST( t )	(QUTIL_WHEEL_SLOTS + (WHEEL_TURN( t ) & (QUTIL_WHEEL_TURNS - 1)))
+
+/* list of the releases beyond the second level turn */
+#define WHEEL_OVERFLOW			(QUTIL_WHEEL_LISTS - 1)
+
 
 /******************************************************************************
 *                            PRIVATE DATA TYPES								  *
 ******************************************************************************/
 
+#ifdef DEV_SYSTEM
+/* fixed heap storage for the development system's one ready queue */
+static task_id_type dev_heap[NUM_OF_TASKS];
+#endif
+
 
 /******************************************************************************
 *                       PRIVATE FUNCTION PROTOTYPES				     		  *
 ******************************************************************************/
+static boolean heap_grow( struct task_q_type *q );
+static U32 heap_key( struct sim_context_type *ctx,
+					 const q_order_type q_order, const task_id_type task );
+static boolean precedes( struct sim_context_type *ctx,
+						 const q_order_type q_order,
+						 const task_id_type a, const task_id_type b );
+static void place( struct sim_context_type *ctx, struct task_q_type *q,
+				   const U32 index, const task_id_type task );
+static void sift_up( struct sim_context_type *ctx, struct task_q_type *q,
+					 U32 index );
+static void sift_down( struct sim_context_type *ctx, struct task_q_type *q,
+					   U32 index );
+static U32 best_child( struct sim_context_type *ctx, const struct task_q_type *q,
+					   const U32 index );
+static U32 wheel_list( const struct task_wheel_type *w, const U32 abs_dline );
+static void wheel_link( struct sim_context_type *ctx, struct task_wheel_type *w,
+						const U32 list, const task_id_type task, const task_id_type next );
+static void wheel_unlink( struct sim_context_type *ctx, struct task_wheel_type *w,
+						  const task_id_type task );
+static void wheel_advance( struct sim_context_type *ctx, struct task_wheel_type *w,
+						   const U32 time );
+static void wheel_spill( struct sim_context_type *ctx, struct task_wheel_type *w,
+						 const U32 list );
+static U32 wheel_earliest( struct sim_context_type *ctx, const struct task_wheel_type *w );
+static U32 wheel_first_used( const struct task_wheel_type *w, U32 first, const U32 last );
 
 
 /******************************************************************************
@@ -58,11 +125,854 @@ void QUTIL_close( void )
 } /* QUTIL_close() */
 
 
+/******************************************************************************
+*  Description : empties a heap queue, keeping its storage
+******************************************************************************/
+void QUTIL_heap_reset( struct task_q_type *q )
+{
+	q->size = ZERO_CPV;
+	q->seq  = ZERO_CPV;
+
+} /* QUTIL_heap_reset() */
+
+
+/******************************************************************************
+*  Description : releases the storage of a heap queue
+******************************************************************************/
+void QUTIL_heap_free( struct task_q_type *q )
+{
+	#ifndef DEV_SYSTEM
+	free( q->heap );
+	#endif
+
+	q->heap     = NULL;
+	q->max_size = ZERO_CPV;
+	q->size     = ZERO_CPV;
+
+} /* QUTIL_heap_free() */
+
+
+/******************************************************************************
+*  Description : inserts a task into a heap queue in q_order
+*  Parameters  : ctx       - simulation context
+*                q         - heap queue
+*                task      - task to insert
+*                q_order   - ordering, as for the list queues
+******************************************************************************/
+void QUTIL_heap_insert( struct sim_context_type *ctx, struct task_q_type *q,
+						const task_id_type task, const q_order_type q_order )
+{
+	if( ctx->tasks[task]->q0_pos is_not ZERO_CPV )
+	{
+		/* task is already in queue - abandon operation */
+		MESS_OUT_message_1( (S8*)"Trying to insert task twice, abandoning ",
+							task, MESSAGE_OP_ERROR );
+	}
+	else if( heap_grow( q ) is TRUE )
+	{
+		q->q_order = q_order;
+
+		/* stamp insert order for ties */
+		ctx->tasks[task]->q0_seq = q->seq;
+		ctx->tasks[task]->q0_key = heap_key( ctx, q_order, task );
+		q->seq++;
+
+		place( ctx, q, q->size, task );
+		q->size++;
+
+		sift_up( ctx, q, q->size - ONE_CPV );
+	}
+	else
+	{
+		MESS_OUT_message_1( (S8*)"QUTIL_heap_insert(): no room for task ",
+							task, MESSAGE_OP_ERROR );
+	}
+
+} /* QUTIL_heap_insert() */
+
+
+/******************************************************************************
+*  Description : removes a task from anywhere in a heap queue
+******************************************************************************/
+void QUTIL_heap_remove( struct sim_context_type *ctx, struct task_q_type *q,
+						const task_id_type task )
+{
+	U32 index;
+	task_id_type last;
+
+	if( ctx->tasks[task]->q0_pos is_not ZERO_CPV )
+	{
+		index = ctx->tasks[task]->q0_pos - ONE_CPV;
+
+		q->size--;
+		ctx->tasks[task]->q0_pos = ZERO_CPV;
+
+		if( index < q->size )
+		{
+			/* fill the hole with the last task and restore heap order */
+			last = q->heap[q->size];
+			place( ctx, q, index, last );
+			sift_up( ctx, q, index );
+			sift_down( ctx, q, ctx->tasks[last]->q0_pos - ONE_CPV );
+		}
+	}
+
+} /* QUTIL_heap_remove() */
+
+
+/******************************************************************************
+*  Description : takes the key of a queued task again after it changed and
+*                restores heap order, either way (decrease or increase key).
+*                Does nothing if the task is not in the queue.
+******************************************************************************/
+void QUTIL_heap_update( struct sim_context_type *ctx, struct task_q_type *q,
+						const task_id_type task )
+{
+	if( ctx->tasks[task]->q0_pos is_not ZERO_CPV )
+	{
+		ctx->tasks[task]->q0_key = heap_key( ctx, q->q_order, task );
+		sift_up( ctx, q, ctx->tasks[task]->q0_pos - ONE_CPV );
+		sift_down( ctx, q, ctx->tasks[task]->q0_pos - ONE_CPV );
+	}
+
+} /* QUTIL_heap_update() */
+
+
+/******************************************************************************
+*  Description : returns the first task in a heap queue, zero if empty
+******************************************************************************/
+task_id_type QUTIL_heap_first( const struct task_q_type *q )
+{
+	task_id_type task = ZERO_CPV;
+
+	if( q->size > ZERO_CPV )
+	{
+		task = q->heap[ZERO_CPV];
+	}
+
+	return( task );
+
+} /* QUTIL_heap_first() */
+
+
+/******************************************************************************
+*  Description : returns the second task in a heap queue, zero if none. The
+*                second task is the best child of the first.
+******************************************************************************/
+task_id_type QUTIL_heap_second( struct sim_context_type *ctx, const struct task_q_type *q )
+{
+	task_id_type task = ZERO_CPV;
+
+	if( q->size > ONE_CPV )
+	{
+		task = q->heap[best_child( ctx, q, ZERO_CPV )];
+	}
+
+	return( task );
+
+} /* QUTIL_heap_second() */
+
+
+/******************************************************************************
+*  Description : removes and returns the first task in a heap queue, zero if
+*                the queue is empty
+******************************************************************************/
+task_id_type QUTIL_heap_extract_first( struct sim_context_type *ctx, struct task_q_type *q )
+{
+	task_id_type task;
+
+	task = QUTIL_heap_first( q );
+
+	if( task is_not ZERO_CPV )
+	{
+		QUTIL_heap_remove( ctx, q, task );
+	}
+
+	return( task );
+
+} /* QUTIL_heap_extract_first() */
+
+
+/******************************************************************************
+*  Description : empties a timing wheel
+******************************************************************************/
+void QUTIL_wheel_reset( struct task_wheel_type *w )
+{
+	U32 list;
+
+	for( list=ZERO_CPV; list<QUTIL_WHEEL_LISTS; list++ )
+	{
+		w->head[list] = ZERO_CPV;
+		w->tail[list] = ZERO_CPV;
+	}
+
+	for( list=ZERO_CPV; list<QUTIL_WHEEL_WORDS; list++ )
+	{
+		w->used[list] = ZERO_CPV;
+	}
+
+	w->now        = ZERO_CPV;
+	w->size       = ZERO_CPV;
+	w->next       = QUTIL_NO_RELEASE;
+	w->next_known = TRUE;
+
+} /* QUTIL_wheel_reset() */
+
+
+/******************************************************************************
+*  Description : puts a task in a timing wheel to be released at its abs_dline.
+*                A future release is appended to the list of its deadline,
+*                which is O(1). A task that is already overdue goes in the
+*                slot of the cursor, in deadline order, so it is released
+*                first.
+*  Parameters  : ctx  - simulation context
+*                w    - timing wheel
+*                task - task to insert
+******************************************************************************/
+void QUTIL_wheel_insert( struct sim_context_type *ctx, struct task_wheel_type *w,
+						 const task_id_type task )
+{
+	U32 abs_dline = ctx->tasks[task]->abs_dline;
+	task_id_type next;
+
+	if( ctx->tasks[task]->q0_pos is_not ZERO_CPV )
+	{
+		/* task is already in queue - abandon operation */
+		MESS_OUT_message_1( (S8*)"Trying to insert task twice, abandoning ",
+							task, MESSAGE_OP_ERROR );
+	}
+	else
+	{
+		if( abs_dline >= w->now )
+		{
+			wheel_link( ctx, w, wheel_list( w, abs_dline ), task, ZERO_CPV );
+		}
+		else
+		{
+			next = w->head[WHEEL_SLOT( w->now )];
+
+			while( (next is_not ZERO_CPV) and (ctx->tasks[next]->abs_dline <= abs_dline) )
+			{
+				next = ctx->tasks[next]->q0_next;
+			}
+
+			wheel_link( ctx, w, WHEEL_SLOT( w->now ), task, next );
+		}
+
+		/* keep the earliest release */
+		if( (w->next_known is TRUE) and (abs_dline < w->next) )
+		{
+			w->next = abs_dline;
+		}
+	}
+
+} /* QUTIL_wheel_insert() */
+
+
+/******************************************************************************
+*  Description : removes a task from anywhere in a timing wheel
+******************************************************************************/
+void QUTIL_wheel_remove( struct sim_context_type *ctx, struct task_wheel_type *w,
+						 const task_id_type task )
+{
+	if( ctx->tasks[task]->q0_pos is_not ZERO_CPV )
+	{
+		wheel_unlink( ctx, w, task );
+
+		if( w->size is ZERO_CPV )
+		{
+			w->next       = QUTIL_NO_RELEASE;
+			w->next_known = TRUE;
+		}
+		else if( ctx->tasks[task]->abs_dline is w->next )
+		{
+			/* the earliest may have gone, found again when next asked for */
+			w->next_known = FALSE;
+		}
+		else
+		{
+			/* earliest release unchanged */
+		}
+	}
+
+} /* QUTIL_wheel_remove() */
+
+
+/******************************************************************************
+*  Description : removes and returns the next task whose abs_dline has been
+*                reached by timeval, zero if there is none. Tasks come out in
+*                deadline order, and in insert order for equal deadlines.
+*                When the cursor slot is empty the cursor jumps straight to
+*                the next release, or past timeval, rather than stepping a
+*                slot at a time.
+*  Parameters  : ctx     - simulation context
+*                w       - timing wheel
+*                timeval - system time
+******************************************************************************/
+task_id_type QUTIL_wheel_extract_due( struct sim_context_type *ctx, struct task_wheel_type *w,
+									  const U32 timeval )
+{
+	task_id_type task = ZERO_CPV;
+	U32 release;
+
+	if( w->size is ZERO_CPV )
+	{
+		/* nothing to release - the cursor can jump */
+		if( timeval >= w->now )
+		{
+			w->now = timeval + ONE_CPV;
+		}
+	}
+	else
+	{
+		while( (task is ZERO_CPV) and (w->now <= timeval) )
+		{
+			/* the cursor slot holds the overdue tasks and those due now */
+			task = w->head[WHEEL_SLOT( w->now )];
+
+			if( task is ZERO_CPV )
+			{
+				release = QUTIL_wheel_next_release( ctx, w );
+
+				wheel_advance( ctx, w, (release <= timeval) ? release
+															: (timeval + ONE_CPV) );
+			}
+		}
+
+		if( task is_not ZERO_CPV )
+		{
+			QUTIL_wheel_remove( ctx, w, task );
+		}
+	}
+
+	return( task );
+
+} /* QUTIL_wheel_extract_due() */
+
+
+/******************************************************************************
+*  Description : returns the earliest abs_dline in a timing wheel, or
+*                QUTIL_NO_RELEASE if it is empty. It is kept as tasks are
+*                inserted, and only found again after the task holding it
+*                has been removed.
+******************************************************************************/
+U32 QUTIL_wheel_next_release( struct sim_context_type *ctx, struct task_wheel_type *w )
+{
+	if( w->next_known is FALSE )
+	{
+		w->next       = wheel_earliest( ctx, w );
+		w->next_known = TRUE;
+	}
+
+	return( w->next );
+
+} /* QUTIL_wheel_next_release() */
+
+
 
 /******************************************************************************
 *                            PRIVATE FUNCTIONS								  *
 ******************************************************************************/
 
 
+/******************************************************************************
+*  Description : makes room for one more task in a heap queue
+*  Returns     : TRUE if there is room
+******************************************************************************/
+static boolean heap_grow( struct task_q_type *q )
+{
+	boolean room = TRUE;
+	#ifndef DEV_SYSTEM
+	task_id_type *heap;
+	U32 max_size;
+	#endif
+
+	if( q->size >= q->max_size )
+	{
+		#ifdef DEV_SYSTEM
+		if( q->heap is NULL )
+		{
+			q->heap     = dev_heap;
+			q->max_size = NUM_OF_TASKS;
+		}
+		else
+		{
+			room = FALSE;
+		}
+		#else
+		max_size = (q->max_size > ZERO_CPV) ? (q->max_size * TWO_CPV) : NUM_OF_TASKS;
+		heap     = (task_id_type*)realloc( q->heap, max_size * sizeof( task_id_type ) );
+
+		if( heap is NULL )
+		{
+			room = FALSE;
+		}
+		else
+		{
+			q->heap     = heap;
+			q->max_size = max_size;
+		}
+		#endif
+	}
+
+	return( room );
+
+} /* heap_grow() */
+
+
+/******************************************************************************
+*  Description : returns the heap key of task in q_order, lowest first. The
+*                key is taken when the task is inserted and kept with it, as
+*                the list compares the task against the others at its insert
+*                and does not move it afterwards.
+******************************************************************************/
+static U32 heap_key( struct sim_context_type *ctx,
+					 const q_order_type q_order, const task_id_type task )
+{
+	U32 key;
+
+	switch( q_order )
+	{
+		case Q_PRI:
+			/* priority order */
+			key = ctx->tasks[task]->priority;
+			break;
+
+		case Q_MUF:
+			/* most urgent first, urgency taken from the laxity now */
+			key = ~SCH_muf_urgency( ctx, task, LAXITY(task, ctx->timeval) );
+			break;
+
+		case Q_SPT:
+			/* shortest processing time */
+			key = ctx->tasks[task]->time_left;
+			break;
+
+		case Q_EDF:
+			/* earliest deadline */
+			key = ctx->tasks[task]->abs_dline;
+			break;
+
+		case Q_LLF:
+			/* least laxity, kept as deadline less work remaining so it
+			   holds for later inserts. A task with no laxity left keys
+			   zero, as it ties with all such tasks in the list */
+			key = (LAXITY(task, ctx->timeval) > ZERO_CPV) ? LAXITY_KEY(task) : ZERO_CPV;
+			break;
+
+		case Q_EPRI:
+			/* enhanced priority order */
+			key = ctx->tasks[task]->e_priority;
+			break;
+
+		case Q_NONE:
+		case Q_MAX:
+		default:
+			/* no order */
+			key = ZERO_CPV;
+			break;
+	}
+
+	return( key );
+
+} /* heap_key() */
+
+
+/******************************************************************************
+*  Description : returns TRUE if task a goes before task b. The keys taken on
+*                insert are compared and the tie break follows the list insert
+*                of the scheduler, so equal keys keep list order.
+******************************************************************************/
+static boolean precedes( struct sim_context_type *ctx,
+						 const q_order_type q_order,
+						 const task_id_type a, const task_id_type b )
+{
+	U32 key_a;
+	U32 key_b;
+	boolean lifo;
+	boolean before;
+
+	switch( q_order )
+	{
+		case Q_SPT:
+		case Q_EDF:
+			/* new task behind equals */
+			lifo = FALSE;
+			break;
+
+		case Q_PRI:
+		case Q_MUF:
+		case Q_LLF:
+		case Q_EPRI:
+		case Q_NONE:
+		case Q_MAX:
+		default:
+			/* new task ahead of equals, the list pushes on the front */
+			lifo = TRUE;
+			break;
+	}
+
+	key_a = ctx->tasks[a]->q0_key;
+	key_b = ctx->tasks[b]->q0_key;
+
+	if( key_a is_not key_b )
+	{
+		before = (key_a < key_b) ? TRUE : FALSE;
+	}
+	else if( lifo is TRUE )
+	{
+		before = (ctx->tasks[a]->q0_seq > ctx->tasks[b]->q0_seq) ? TRUE : FALSE;
+	}
+	else
+	{
+		before = (ctx->tasks[a]->q0_seq < ctx->tasks[b]->q0_seq) ? TRUE : FALSE;
+	}
+
+	return( before );
+
+} /* precedes() */
+
+
+/******************************************************************************
+*  Description : puts task in heap slot index
+******************************************************************************/
+static void place( struct sim_context_type *ctx, struct task_q_type *q,
+				   const U32 index, const task_id_type task )
+{
+	q->heap[index] = task;
+	ctx->tasks[task]->q0_pos = (task_id_type)(index + ONE_CPV);
+
+} /* place() */
+
+
+/******************************************************************************
+*  Description : moves the task in slot index up towards the root
+******************************************************************************/
+static void sift_up( struct sim_context_type *ctx, struct task_q_type *q,
+					 U32 index )
+{
+	task_id_type task = q->heap[index];
+	U32 parent;
+	boolean moving = TRUE;
+
+	while( (index > ZERO_CPV) and (moving is TRUE) )
+	{
+		parent = (index - ONE_CPV) / QUTIL_HEAP_ARITY;
+
+		if( precedes( ctx, q->q_order, task, q->heap[parent] ) is TRUE )
+		{
+			place( ctx, q, index, q->heap[parent] );
+			index = parent;
+		}
+		else
+		{
+			moving = FALSE;
+		}
+	}
+
+	place( ctx, q, index, task );
+
+} /* sift_up() */
+
+
+/******************************************************************************
+*  Description : moves the task in slot index down towards the leaves
+******************************************************************************/
+static void sift_down( struct sim_context_type *ctx, struct task_q_type *q,
+					   U32 index )
+{
+	task_id_type task = q->heap[index];
+	U32 child;
+	boolean moving = TRUE;
+
+	while( ((index * QUTIL_HEAP_ARITY) + ONE_CPV < q->size) and (moving is TRUE) )
+	{
+		child = best_child( ctx, q, index );
+
+		if( precedes( ctx, q->q_order, q->heap[child], task ) is TRUE )
+		{
+			place( ctx, q, index, q->heap[child] );
+			index = child;
+		}
+		else
+		{
+			moving = FALSE;
+		}
+	}
+
+	place( ctx, q, index, task );
+
+} /* sift_down() */
+
+
+/******************************************************************************
+*  Description : returns the slot of the first of the children of slot index,
+*                which must have at least one child
+******************************************************************************/
+static U32 best_child( struct sim_context_type *ctx, const struct task_q_type *q,
+					   const U32 index )
+{
+	U32 child;
+	U32 last;
+	U32 best;
+
+	best = (index * QUTIL_HEAP_ARITY) + ONE_CPV;
+	last = best + QUTIL_HEAP_ARITY;
+	if( last > q->size )
+	{
+		last = q->size;
+	}
+
+	for( child=best + ONE_CPV; child<last; child++ )
+	{
+		if( precedes( ctx, q->q_order, q->heap[child], q->heap[best] ) is TRUE )
+		{
+			best = child;
+		}
+	}
+
+	return( best );
+
+} /* best_child() */
+
+
+/******************************************************************************
+*  Description : returns the list for a release at abs_dline, which must not
+*                be before the cursor - the slot of its tick in the cursor's
+*                turn, the slot of its turn in the cursor's second level
+*                turn, or else the overflow list
+******************************************************************************/
+static U32 wheel_list( const struct task_wheel_type *w, const U32 abs_dline )
+{
+	U32 list;
+
+	if( WHEEL_TURN( abs_dline ) is WHEEL_TURN( w->now ) )
+	{
+		list = WHEEL_SLOT( abs_dline );
+	}
+	else if( WHEEL_EPOCH( abs_dline ) is WHEEL_EPOCH( w->now ) )
+	{
+		list = WHEEL_TURN_LIST( abs_dline );
+	}
+	else
+	{
+		list = WHEEL_OVERFLOW;
+	}
+
+	return( list );
+
+} /* wheel_list() */
+
+
+/******************************************************************************
+*  Description : links task into wheel list ahead of task next, or at the end
+*                of the list if next is zero
+******************************************************************************/
+static void wheel_link( struct sim_context_type *ctx, struct task_wheel_type *w,
+						const U32 list, const task_id_type task, const task_id_type next )
+{
+	task_id_type prev;
+
+	prev = (next is ZERO_CPV) ? w->tail[list] : ctx->tasks[next]->q0_prev;
+
+	if( prev is ZERO_CPV )
+	{
+		w->head[list] = task;
+		w->used[list / 32U] |= ( ONE_CPV << (list % 32U) );
+	}
+	else
+	{
+		ctx->tasks[prev]->q0_next = task;
+	}
+
+	if( next is ZERO_CPV )
+	{
+		w->tail[list] = task;
+	}
+	else
+	{
+		ctx->tasks[next]->q0_prev = task;
+	}
+
+	ctx->tasks[task]->q0_prev = prev;
+	ctx->tasks[task]->q0_next = next;
+	ctx->tasks[task]->q0_pos  = (task_id_type)(list + ONE_CPV);
+	w->size++;
+
+} /* wheel_link() */
+
+
+/******************************************************************************
+*  Description : unlinks task from its wheel list
+******************************************************************************/
+static void wheel_unlink( struct sim_context_type *ctx, struct task_wheel_type *w,
+						  const task_id_type task )
+{
+	U32 list;
+	task_id_type prev;
+	task_id_type next;
+
+	list = ctx->tasks[task]->q0_pos - ONE_CPV;
+	prev = ctx->tasks[task]->q0_prev;
+	next = ctx->tasks[task]->q0_next;
+
+	if( prev is ZERO_CPV )
+	{
+		w->head[list] = next;
+
+		if( next is ZERO_CPV )
+		{
+			w->used[list / 32U] &= ~( ONE_CPV << (list % 32U) );
+		}
+	}
+	else
+	{
+		ctx->tasks[prev]->q0_next = next;
+	}
+
+	if( next is ZERO_CPV )
+	{
+		w->tail[list] = prev;
+	}
+	else
+	{
+		ctx->tasks[next]->q0_prev = prev;
+	}
+
+	ctx->tasks[task]->q0_prev = ZERO_CPV;
+	ctx->tasks[task]->q0_next = ZERO_CPV;
+	ctx->tasks[task]->q0_pos  = ZERO_CPV;
+	w->size--;
+
+} /* wheel_unlink() */
+
+
+/******************************************************************************
+*  Description : moves the cursor on to time, which must not be after the
+*                earliest release. Entering a new second level turn brings
+*                in the overflow tasks it covers, and entering a new turn
+*                spills its second level slot into the first level. The
+*                turns passed over hold no tasks.
+******************************************************************************/
+static void wheel_advance( struct sim_context_type *ctx, struct task_wheel_type *w,
+						   const U32 time )
+{
+	U32 old_now = w->now;
+
+	w->now = time;
+
+	if( WHEEL_TURN( time ) is_not WHEEL_TURN( old_now ) )
+	{
+		if( WHEEL_EPOCH( time ) is_not WHEEL_EPOCH( old_now ) )
+		{
+			wheel_spill( ctx, w, WHEEL_OVERFLOW );
+		}
+
+		wheel_spill( ctx, w, WHEEL_TURN_LIST( time ) );
+	}
+
+} /* wheel_advance() */
+
+
+/******************************************************************************
+*  Description : moves the tasks of a list that now belong in another list
+*                on to the end of that list, keeping their order, so equal
+*                deadlines still come out in insert order
+******************************************************************************/
+static void wheel_spill( struct sim_context_type *ctx, struct task_wheel_type *w,
+						 const U32 list )
+{
+	task_id_type task;
+	task_id_type next;
+	U32 to;
+
+	for( task=w->head[list]; task is_not ZERO_CPV; task=next )
+	{
+		next = ctx->tasks[task]->q0_next;
+		to   = wheel_list( w, ctx->tasks[task]->abs_dline );
+
+		if( to is_not list )
+		{
+			wheel_unlink( ctx, w, task );
+			wheel_link( ctx, w, to, task, ZERO_CPV );
+		}
+	}
+
+} /* wheel_spill() */
+
+
+/******************************************************************************
+*  Description : finds the earliest abs_dline in a timing wheel. The first
+*                used slot from the cursor gives it directly. Failing that
+*                the first used second level slot, or the overflow list, is
+*                searched.
+******************************************************************************/
+static U32 wheel_earliest( struct sim_context_type *ctx, const struct task_wheel_type *w )
+{
+	U32 release = QUTIL_NO_RELEASE;
+	U32 list;
+	task_id_type task;
+
+	list = wheel_first_used( w, WHEEL_SLOT( w->now ), QUTIL_WHEEL_SLOTS );
+
+	if( list < QUTIL_WHEEL_SLOTS )
+	{
+		/* slot of a tick, or the cursor slot with its overdue tasks first */
+		release = ctx->tasks[w->head[list]]->abs_dline;
+	}
+	else
+	{
+		list = wheel_first_used( w, WHEEL_TURN_LIST( w->now ) + ONE_CPV, WHEEL_OVERFLOW );
+
+		/* tasks of a turn, or the overflow, are in no order */
+		for( task=w->head[list]; task is_not ZERO_CPV; task=ctx->tasks[task]->q0_next )
+		{
+			if( ctx->tasks[task]->abs_dline < release )
+			{
+				release = ctx->tasks[task]->abs_dline;
+			}
+		}
+	}
+
+	return( release );
+
+} /* wheel_earliest() */
+
+
+/******************************************************************************
+*  Description : returns the first list from first to before last that holds
+*                a task, or last if there is none. Reads the used bit map a
+*                word of lists at a time.
+******************************************************************************/
+static U32 wheel_first_used( const struct task_wheel_type *w, U32 first, const U32 last )
+{
+	U32 bits;
+	boolean found = FALSE;
+
+	while( (first < last) and (found is FALSE) )
+	{
+		bits = w->used[first / 32U] >> (first % 32U);
+
+		if( bits is ZERO_CPV )
+		{
+			/* rest of the word is empty */
+			first = (first | 31U) + ONE_CPV;
+		}
+		else
+		{
+			while( (bits & ONE_CPV) is ZERO_CPV )
+			{
+				bits >>= 1;
+				first++;
+			}
+			found = TRUE;
+		}
+	}
+
+	return( (first < last) ? first : last );
+
+} /* wheel_first_used() */
+
+
 
 
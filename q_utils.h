@@ -15,6 +15,9 @@
 *                                                                             *
 * Date     |Aut| Description                                                  *
 * 27-09-05 |JRO| Created                                                      *
+* 17-10-26 |JRO| Added heap ordered task queue                                *
+* 17-10-26 |JRO| Added timing wheel release queue                             *
+* 17-10-26 |JRO| Queues ordered by q_order_type instead of algorithm          *
 *          |   |                                                              *
 *                                                                             *
 ******************************************************************************/
@@ -28,19 +31,95 @@ typedef enum
 	Q_PRI,		/* priority          */
 	Q_EDF,		/* earliest deadline */
 	Q_LLF,		/* leat laxity first */
+	Q_MUF,		/* maximum urgency   */
+	Q_SPT,		/* shortest time left*/
+	Q_EPRI,		/* enhanced priority */
+	Q_NONE,		/* no order          */
 	Q_MAX
 }q_order_type;	 
 
 
+/* queue implementations */
+typedef enum
+{
+	Q_LIST,		/* linked list through the task queue links */
+	Q_HEAP,		/* heap of task ids                         */
+	Q_WHEEL,	/* timing wheel of release times           */
+	Q_KIND_MAX
+}q_kind_type;
+
+#define QUTIL_HEAP_ARITY  4    /* children per heap node */
+#define QUTIL_NO_RELEASE  0xFFFFFFFF  /* empty timing wheel   */
+
+/* A task's place in a timing wheel is kept in its q0_pos, one more than */
+/* its list, so QUTIL_WHEEL_LISTS must fit in a task_id_type.            */
+#if defined( DEV_SYSTEM ) || (TASK_ID_BITS == 8)
+#define QUTIL_WHEEL_SLOTS 32   /* timer ticks per wheel turn, power of 2 */
+#define QUTIL_WHEEL_TURNS 32   /* turns per second level turn, power of 2 */
+#else
+#define QUTIL_WHEEL_SLOTS 256  /* timer ticks per wheel turn, power of 2 */
+#define QUTIL_WHEEL_TURNS 256  /* turns per second level turn, power of 2 */
+#endif
+
+/* wheel lists - a slot per tick, a slot per turn, then the overflow list */
+#define QUTIL_WHEEL_LISTS ( QUTIL_WHEEL_SLOTS + QUTIL_WHEEL_TURNS + 1 )
+#define QUTIL_WHEEL_WORDS ( (QUTIL_WHEEL_LISTS + 31) / 32 )
+
+
 /* task queue type */
 struct task_q_type
 {
-	q_order_type	q_order;	/* order of queue */
+	q_order_type	q_order;	/* order of queue, from insert     */
+	q_kind_type		q_kind;		/* list or heap                     */
+	task_id_type   *heap;		/* heap of task ids                 */
+	U32				size;		/* tasks in the heap                */
+	U32				max_size;	/* heap slots allocated             */
+	U32				seq;		/* insert count, breaks ties        */
+};
+
+/* release queue type - a task waits in a list by its abs_dline, linked
+   through its queue 0 links. The first level has a slot per tick of the
+   cursor's turn, the second a slot per turn of the cursor's second level
+   turn, and the overflow list holds the releases beyond that */
+struct task_wheel_type
+{
+	q_kind_type		q_kind;		/* list or wheel                    */
+	task_id_type	head[QUTIL_WHEEL_LISTS];	/* first task in list   */
+	task_id_type	tail[QUTIL_WHEEL_LISTS];	/* last task in list    */
+	U32				used[QUTIL_WHEEL_WORDS];	/* lists not empty      */
+	U32				now;		/* first time not yet released      */
+	U32				size;		/* tasks in the wheel               */
+	U32				next;		/* earliest abs_dline, if known     */
+	boolean			next_known;	/* next is up to date               */
 };
 
+/* simulation context, see context.h */
+struct sim_context_type;
+
 
 void QUTIL_init( void );
 void QUTIL_close( void );
 void QUTIL_push( void );
 
+void QUTIL_heap_reset( struct task_q_type *q );
+void QUTIL_heap_free( struct task_q_type *q );
+void QUTIL_heap_insert( struct sim_context_type *ctx, struct task_q_type *q,
+						const task_id_type task, const q_order_type q_order );
+void QUTIL_heap_remove( struct sim_context_type *ctx, struct task_q_type *q,
+						const task_id_type task );
+void QUTIL_heap_update( struct sim_context_type *ctx, struct task_q_type *q,
+						const task_id_type task );
+task_id_type QUTIL_heap_first( const struct task_q_type *q );
+task_id_type QUTIL_heap_second( struct sim_context_type *ctx, const struct task_q_type *q );
+task_id_type QUTIL_heap_extract_first( struct sim_context_type *ctx, struct task_q_type *q );
+
+void QUTIL_wheel_reset( struct task_wheel_type *w );
+void QUTIL_wheel_insert( struct sim_context_type *ctx, struct task_wheel_type *w,
+						 const task_id_type task );
+void QUTIL_wheel_remove( struct sim_context_type *ctx, struct task_wheel_type *w,
+						 const task_id_type task );
+task_id_type QUTIL_wheel_extract_due( struct sim_context_type *ctx, struct task_wheel_type *w,
+									  const U32 timeval );
+U32 QUTIL_wheel_next_release( struct sim_context_type *ctx, struct task_wheel_type *w );
+
 #endif
@@ -16,6 +16,9 @@
 *                                                                             *
 * date     |who| description                                                  *
 * 03-06-05 |JRO| Created                                                      *
+* 17-10-26 |JRO| PC reference timer is per thread                             *
+* 17-10-26 |JRO| PC timer reads the monotonic clock, see CLK_HIRES            *
+* 17-10-26 |JRO| CLK_start_timer() pre load is time already run               *
 *          |   |                                                              *
 *                                                                             *
 ******************************************************************************/
@@ -72,6 +75,8 @@ U32 CLK_get_real_time( void )
 
 /******************************************************************************
 *  Description : Resets a reference timer
+*  Notes       : pre_load is time already run, so a timer stopped by
+*                CLK_end_timer() carries on from where it was
 ******************************************************************************/
 void CLK_start_timer( const U32 pre_load )
 {
@@ -79,7 +84,7 @@ void CLK_start_timer( const U32 pre_load )
     real_time = CTC;       /* read the clock tick counter */
 
     /* set the reference time */
-    ref_time = real_time + pre_load;
+    ref_time = real_time - pre_load;
 }
 
 /******************************************************************************
@@ -141,9 +146,25 @@ void RTC_isr(void)
 #include <time.h>
 /*lint -e628 */
 
-static U32 ref_time;
+#if CLK_HIRES
+    /* not slewed by NTP where the system has it */
+    #ifdef CLOCK_MONOTONIC_RAW
+        #define CLK_SOURCE  CLOCK_MONOTONIC_RAW
+    #else
+        #define CLK_SOURCE  CLOCK_MONOTONIC
+    #endif
+
+    #define CLK_NS_PER_SEC  1000000000U
+#endif
+
+static THREAD_LOCAL U32 ref_time;
 
 
+/******************************************************************************
+*  PRIVATE FUNCTION PROTOTYPES
+******************************************************************************/
+static U32 read_clock( void );
+
 
 /******************************************************************************
 *                             PUBLIC FUNCTIONS
@@ -154,42 +175,42 @@ static U32 ref_time;
 
 /******************************************************************************
 *  Description : Set up the real time clock
-*  Notes       : uclock() returns UCLOCKS_PER_SEC defined as 1193180
 ******************************************************************************/
 void CLK_init( void )
 {
-    ref_time = (U32)clock();
+    ref_time = read_clock();
 }
 
 /******************************************************************************
-*  Description : Getter function returns elapsed time since start-up
-*  Notes       : uclock() returns UCLOCKS_PER_SEC defined as 1193180
+*  Description : Getter function returns the clock, in
+*                CLK_clocks_per_second() units
+*  Notes       : the nanosecond clock wraps every 4.3 seconds
 ******************************************************************************/
 U32 CLK_get_real_time( void )
 {
-    return( (U32)clock() );
+    return( read_clock() );
 }
 
 /******************************************************************************
 *  Description : Resets a reference timer
-*  Notes       : uclock() returns UCLOCKS_PER_SEC defined in time.c as 1193180
+*  Notes       : pre_load is time already run, so a timer stopped by
+*                CLK_end_timer() carries on from where it was
 ******************************************************************************/
 void CLK_start_timer( const U32 pre_load )
 {
-    ref_time = (U32)clock() + pre_load;
+    ref_time = read_clock() - pre_load;
 }
 
 
 /******************************************************************************
 *  Description : Returns time since call to CLK_start_timer
-*  Notes       : uclock() returns UCLOCKS_PER_SEC defined in time.c as 0x1234DC
 ******************************************************************************/
 U32 CLK_end_timer( void )
 {
     U32 u_time;
     U32 d_time;
 
-    u_time = (U32)clock();
+    u_time = read_clock();
 
     d_time = u_time - ref_time;
 
@@ -197,12 +218,38 @@ U32 CLK_end_timer( void )
 }
 
 /******************************************************************************
-*  Description : Returns the value of CLOCKS_PER_SEC macro
-*  Notes       : uclock() returns CLOCKS_PER_SEC defined in time.c as 0x1234DC
+*  Description : Returns the clock rate, nanoseconds or CLOCKS_PER_SEC
 ******************************************************************************/
 U32 CLK_clocks_per_second( void )
 {
+#if CLK_HIRES
+    return( CLK_NS_PER_SEC );
+#else
     return( (U32)CLOCKS_PER_SEC );
+#endif
+}
+
+
+/******************************************************************************
+*                            PRIVATE FUNCTIONS
+******************************************************************************/
+
+
+/******************************************************************************
+*  Description : reads the clock. Only differences between readings are
+*                used, so the nanosecond count is left to wrap
+******************************************************************************/
+static U32 read_clock( void )
+{
+#if CLK_HIRES
+    struct timespec now;
+
+    (void)clock_gettime( CLK_SOURCE, &now );
+
+    return( ((U32)now.tv_sec * CLK_NS_PER_SEC) + (U32)now.tv_nsec );
+#else
+    return( (U32)clock() );
+#endif
 }
 
 #endif
@@ -19,12 +19,24 @@
 *                                                                             *
 * date     |who| description                                                  *
 * 03-06-05 |JRO| Created                                                      *
+* 17-10-26 |JRO| Added CLK_HIRES build option                                 *
 *          |   |                                                              *
 *                                                                             *
 ******************************************************************************/
 #ifndef _RT_CLOCK_H
 #define _RT_CLOCK_H
 
+/* PC build: the scheduler overhead timer reads the monotonic clock in
+   nanoseconds. Build with -DCLK_HIRES=0 for the process time from clock(),
+   which is too coarse to time one scheduler call */
+#ifndef CLK_HIRES
+    #ifdef DEV_SYSTEM
+        #define CLK_HIRES   0
+    #else
+        #define CLK_HIRES   1
+    #endif
+#endif
+
 void CLK_init( void );
 U32 CLK_get_real_time( void );
 U32 CLK_get_diff_time( const U32 t1, const U32 t2 );
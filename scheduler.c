@@ -32,6 +32,22 @@
 * 25-06-05 |JRO| Added ALG_ADAP_01 & ALG_ADAP_02 scheduler                    *
 * 26-06-05 |JRO| Added ALG_ADAP_03 & ALG_ADAP_04 scheduler                    *
 * 15-07-05 |JRO| Added ALG_ADAP_05 & ALG_ADAP_06 scheduler                    *
+* 17-10-26 |JRO| Added SCH_next_event() for event driven time advance         *
+* 17-10-26 |JRO| Task loops run over the task set size                        *
+* 17-10-26 |JRO| Queue links and task ids widened to task_id_type             *
+* 17-10-26 |JRO| Ready queue selectable as a heap (q_utils.c)                 *
+* 17-10-26 |JRO| Idle and waiting queues selectable as timing wheels          *
+* 17-10-26 |JRO| Laxity and MUF urgency read on demand, no per tick sweep     *
+* 17-10-26 |JRO| Task set utility kept as a running total                     *
+* 17-10-26 |JRO| Algorithms described by a policy table, not per tick tests   *
+* 17-10-26 |JRO| Single algorithm build, see SCH_SINGLE_ALGORITHM             *
+* 17-10-26 |JRO| Task selection sweeps walk the task table with state masks   *
+* 17-10-26 |JRO| Debug and verbose messages through MESS_OUT_DEBUG/VERBOSE    *
+* 17-10-26 |JRO| SCH_start() time recorded in the context latency histogram   *
+* 17-10-26 |JRO| SCH_start() phases profiled, see SCH_PROFILE                 *
+* 17-10-26 |JRO| Added SCH_queue_task() and SCH_algorithm_supported()         *
+* 17-10-26 |JRO| ADAP_01/03/05 overload loops stop when no task is left       *
+* 17-10-26 |JRO| Ready queue kept a list for MUF and the doubling algorithms  *
 *          |   |                                                              *
 *                                                                             *
 ******************************************************************************/
@@ -42,121 +58,373 @@
 #include "utils.h"		   /* general utilities        */
 #include "rt_clock.h"	   /* real time clock timer    */
 #include "scheduler.h"     /* interface file           */
+#include "q_utils.h"       /* heap and wheel queues    */
+#include "context.h"       /* simulation context       */
 
 /* maximum EDF task set utility x 1000 (Liu and Layland 1973) */
 static const U16 MAX_EDF_UTIL = (U16)1000;
 
-/* scheduling algorithm */
-static algorithm_type algorithm;
-
-/* local array of pointers to tasks, defined in task.c */
-extern struct task_type *tasks[NUM_OF_TASKS];
-
-/* local pointer to ready header */
-static struct task_type readys;
-static struct task_type *ready_tasks;
-
-/* local pointer to idle header */
-static struct task_type idles;
-static struct task_type *idle_tasks;
-
-/* local pointer to waiting header */
-static struct task_type waits;
-static struct task_type *waiting_tasks;
-
-/* local pointer to skipped header */
-static struct task_type skippeds;
-static struct task_type *skipped_tasks;
-
-/* local pointer to removed header */
-static struct task_type removeds;
-static struct task_type *removed_tasks;
-
-/* local pointer to doubled periods header */
-static struct task_type doubleds;
-static struct task_type *doubled_periods;
-
-/* local pointer to LST header */
-static struct task_type lsts;
-static struct task_type *lst_tasks;
+/* algorithms that skip tasks, red task only and blue when possible */
+#define SCH_SKIP_ALGORITHMS  (    SCH_ALG_BUILT(SCH_NUM_RM_RTO)     \
+                               || SCH_ALG_BUILT(SCH_NUM_EDF_RTO)    \
+                               || SCH_ALG_BUILT(SCH_NUM_EDF_BWP) )
+
+/* adaptive algorithms 1 to 7 */
+#define SCH_ADAPTIVE_ALGORITHMS (    SCH_ALG_BUILT(SCH_NUM_ADAP_01) \
+                                  || SCH_ALG_BUILT(SCH_NUM_ADAP_02) \
+                                  || SCH_DOUBLED_QUEUE )
+
+/* adaptive algorithms 3 to 7, which double task periods */
+#define SCH_DOUBLING_ALGORITHMS (    SCH_ALG_BUILT(SCH_NUM_ADAP_03) \
+                                  || SCH_ALG_BUILT(SCH_NUM_ADAP_04) \
+                                  || SCH_ALG_BUILT(SCH_NUM_ADAP_05) \
+                                  || SCH_ALG_BUILT(SCH_NUM_ADAP_06) \
+                                  || SCH_ALG_BUILT(SCH_NUM_ADAP_07) )
+
+/* adaptive algorithms 1 to 6, which act on the lowest priority active */
+/* task in overload                                                     */
+#define SCH_OVERLOAD_ALGORITHMS (    SCH_ALG_BUILT(SCH_NUM_ADAP_01) \
+                                  || SCH_ALG_BUILT(SCH_NUM_ADAP_02) \
+                                  || SCH_ALG_BUILT(SCH_NUM_ADAP_03) \
+                                  || SCH_ALG_BUILT(SCH_NUM_ADAP_04) \
+                                  || SCH_ALG_BUILT(SCH_NUM_ADAP_05) \
+                                  || SCH_ALG_BUILT(SCH_NUM_ADAP_06) )
+
+/* algorithms that schedule by EDF, the adaptive ones once in bounds */
+#define SCH_EDF_ALGORITHMS   (    SCH_ALG_BUILT(SCH_NUM_EDF)        \
+                               || SCH_ADAPTIVE_ALGORITHMS )
+
+/* algorithms that dispatch and preempt tasks, all those written */
+#define SCH_DISPATCH_ALGORITHMS (    SCH_ALG_BUILT(SCH_NUM_RM)      \
+                                  || SCH_ALG_BUILT(SCH_NUM_IRM)     \
+                                  || SCH_ALG_BUILT(SCH_NUM_DRM)     \
+                                  || SCH_ALG_BUILT(SCH_NUM_SPT)     \
+                                  || SCH_ALG_BUILT(SCH_NUM_LLF)     \
+                                  || SCH_ALG_BUILT(SCH_NUM_MLLF)    \
+                                  || SCH_ALG_BUILT(SCH_NUM_MUF)     \
+                                  || SCH_ALG_BUILT(SCH_NUM_MMUF)    \
+                                  || SCH_ALG_BUILT(SCH_NUM_MMMUF)   \
+                                  || SCH_ALG_BUILT(SCH_NUM_EDF_RTO) \
+                                  || SCH_EDF_ALGORITHMS )
 
 /* private function prototypes */
-static void process_waiting_tasks( const U32 timeval );
-static void process_completed_tasks( const U32 timeval );
-static void process_removed_tasks( const U32 timeval );
-static void process_doubled_periods( void );
-static U8 doubled_queue_has_task( const U16 utility );
-static void process_skipped_tasks( const U32 timeval );
-static void process_idle_tasks( const U32 timeval );
-static void process_ready_tasks( const U32 timeval );
-static void schedule_adapive_one_algorithm( const U32 timeval );
-static void schedule_adapive_three_algorithm( void );
-static void schedule_adapive_five_algorithm( const U32 timeval );
-static void schedule_adapive_six_algorithm( const U32 timeval );
-static void schedule_adapive_seven_algorithm( const U32 timeval );
-static void schedule_rr_algorithm( void );
-static void schedule_cyc_algorithm( void );
-static void schedule_rm_algorithm( void );
-static void schedule_drm_algorithm( const U32 timeval );
-static void schedule_irm_algorithm( void );
-static void schedule_muf_algorithm( const U32 timeval );
-static void schedule_mmuf_algorithm( const U32 timeval );
-static void schedule_mmmuf_algorithm( const U32 timeval );
-static void schedule_edf_algorithm( void );
-static void schedule_spt_algorithm( void );
-static void schedule_llf_algorithm( const U32 timeval );
-static void schedule_mllf_algorithm( const U32 timeval );
-static void schedule_skip_rto_algorithm( const U32 timeval );
+static void process_waiting_tasks( struct sim_context_type *ctx, const U32 timeval );
+static void process_completed_tasks( struct sim_context_type *ctx, const U32 timeval );
+static void process_removed_tasks( struct sim_context_type *ctx, const U32 timeval );
+#if SCH_DOUBLED_QUEUE
+static void process_doubled_periods( struct sim_context_type *ctx, const U32 timeval );
+static task_id_type doubled_queue_has_task( struct sim_context_type *ctx, const U16 utility );
+#endif
+#if SCH_SKIP_ALGORITHMS
+static void process_skipped_tasks( struct sim_context_type *ctx, const U32 timeval );
+#endif
+static void process_idle_tasks( struct sim_context_type *ctx, const U32 timeval );
+static void process_ready_tasks( struct sim_context_type *ctx, const U32 timeval );
+#if SCH_ALG_BUILT(SCH_NUM_ADAP_01) || SCH_ALG_BUILT(SCH_NUM_ADAP_02)
+static void schedule_adapive_one_algorithm( struct sim_context_type *ctx, const U32 timeval );
+#endif
+#if SCH_ALG_BUILT(SCH_NUM_ADAP_03) || SCH_ALG_BUILT(SCH_NUM_ADAP_04)
+static void schedule_adapive_three_algorithm( struct sim_context_type *ctx, const U32 timeval );
+#endif
+#if SCH_ALG_BUILT(SCH_NUM_ADAP_05)
+static void schedule_adapive_five_algorithm( struct sim_context_type *ctx, const U32 timeval );
+#endif
+#if SCH_ALG_BUILT(SCH_NUM_ADAP_06)
+static void schedule_adapive_six_algorithm( struct sim_context_type *ctx, const U32 timeval );
+#endif
+#if SCH_ALG_BUILT(SCH_NUM_ADAP_07)
+static void schedule_adapive_seven_algorithm( struct sim_context_type *ctx, const U32 timeval );
+#endif
+#if SCH_ALG_BUILT(SCH_NUM_RR)
+static void schedule_rr_algorithm( struct sim_context_type *ctx, const U32 timeval );
+#endif
+#if SCH_ALG_BUILT(SCH_NUM_CYC)
+static void schedule_cyc_algorithm( struct sim_context_type *ctx, const U32 timeval );
+#endif
+#if SCH_ALG_BUILT(SCH_NUM_RM)
+static void schedule_rm_algorithm( struct sim_context_type *ctx, const U32 timeval );
+#endif
+#if SCH_ALG_BUILT(SCH_NUM_DRM)
+static void schedule_drm_algorithm( struct sim_context_type *ctx, const U32 timeval );
+#endif
+#if SCH_ALG_BUILT(SCH_NUM_IRM)
+static void schedule_irm_algorithm( struct sim_context_type *ctx, const U32 timeval );
+#endif
+#if SCH_ALG_BUILT(SCH_NUM_MUF)
+static void schedule_muf_algorithm( struct sim_context_type *ctx, const U32 timeval );
+#endif
+#if SCH_ALG_BUILT(SCH_NUM_MMUF)
+static void schedule_mmuf_algorithm( struct sim_context_type *ctx, const U32 timeval );
+#endif
+#if SCH_ALG_BUILT(SCH_NUM_MMMUF)
+static void schedule_mmmuf_algorithm( struct sim_context_type *ctx, const U32 timeval );
+#endif
+#if SCH_EDF_ALGORITHMS
+static void schedule_edf_algorithm( struct sim_context_type *ctx, const U32 timeval );
+#endif
+#if SCH_ALG_BUILT(SCH_NUM_SPT)
+static void schedule_spt_algorithm( struct sim_context_type *ctx, const U32 timeval );
+#endif
+#if SCH_ALG_BUILT(SCH_NUM_LLF)
+static void schedule_llf_algorithm( struct sim_context_type *ctx, const U32 timeval );
+#endif
+#if SCH_ALG_BUILT(SCH_NUM_MLLF)
+static void schedule_mllf_algorithm( struct sim_context_type *ctx, const U32 timeval );
+#endif
+#if SCH_ALG_BUILT(SCH_NUM_EDF_RTO)
+static void schedule_skip_rto_algorithm( struct sim_context_type *ctx, const U32 timeval );
+#endif
+static void schedule_unsupported_algorithm( struct sim_context_type *ctx, const U32 timeval );
 #if(0)
-static void schedule_d_star_algorithm( const U32 timeval );
+static void schedule_d_star_algorithm( struct sim_context_type *ctx, const U32 timeval );
+#endif
+#if SCH_DISPATCH_ALGORITHMS
+static void preempt_task( struct sim_context_type *ctx, const task_id_type task );
+static void dispatch_next_task( struct sim_context_type *ctx );
+#endif
+#if SCH_ALG_BUILT(SCH_NUM_EDF_RTO)
+static void skip_first_task( struct sim_context_type *ctx, const U32 timeval );
 #endif
-static void preempt_task( const U8 task );
-static void dispatch_next_task( void );
-static void skip_first_task( const U32 timeval );
 
-static void q0_insert( const U8 task,
+static void q0_insert( struct sim_context_type *ctx, const task_id_type task,
                        struct task_type *header,
-                       const algorithm_type scheduling_algorithm );
+                       const q_order_type q_order );
+
+static void q0_list_insert( struct sim_context_type *ctx, const task_id_type task,
+                            struct task_type *header,
+                            const q_order_type q_order );
+
+static struct task_q_type *q0_heap( struct sim_context_type *ctx, const struct task_type *header );
+static void set_ready_q_kind( struct sim_context_type *ctx );
+#if SCH_DOUBLING_ALGORITHMS
+static void q0_key_changed( struct sim_context_type *ctx, const task_id_type task );
+#endif
+static struct task_wheel_type *q0_wheel( struct sim_context_type *ctx, const struct task_type *header );
 
-static void q1_insert( const U8 task,
+#if SCH_DOUBLED_QUEUE
+static void q1_insert( struct sim_context_type *ctx, const task_id_type task,
                        struct task_type *header,
-                       const algorithm_type scheduling_algorithm );
+                       const q_order_type q_order );
+#endif
 
-static void q2_insert( const U8 task,
+static void q2_insert( struct sim_context_type *ctx, const task_id_type task,
                        struct task_type *header,
-                       const algorithm_type scheduling_algorithm );
-
-static U8 q_extract_first( struct task_type *header );
-static void q0_extract( const U8 task );
-static void q1_extract( const U8 task, struct task_type *header );
-static void q2_extract( const U8 task, struct task_type *header );
-
-static boolean q_empty( const U8 queue, const struct task_type *header );
-static U8 q_first_id( const U8 queue, const struct task_type *header );
-static U8 q_second_id( const U8 queue, const struct task_type *header );
-static void calculate_all_laxities( const U32 timeval );
-static U32 calculate_laxity( const U8 task, const U32 timeval );
-static void calculate_all_muf_urgencies( void );
-static void calculate_muf_urgency( const U8 task );
-static U8 get_lowest_priority_active_task( void );
-static U8 get_active_task_priority( void );
-static void calculate_active_task_priority( const U8 task );
-static U8 task_skippable( const U8 task );
-static boolean can_meet_deadline( const U8 task, const U32 timeval );
-static void decrement_not_skipped_count( const U8 task );
-static U16 calculate_all_task_utilities( void );
-static U16 calculate_task_utility( const U8 task );
-static U16 get_task_set_utility( void );
-static U8 removed_queue_has_task_with_lower_utility( const U16 util );
-static U8 double_task_period( const U8 task );
-static void half_task_period( const U8 task );
+                       const q_order_type q_order );
+
+static task_id_type q_extract_first( struct sim_context_type *ctx, struct task_type *header );
+static task_id_type q_extract_due( struct sim_context_type *ctx, struct task_type *header, const U32 timeval );
+static U32 q_next_release( struct sim_context_type *ctx, const struct task_type *header );
+static void q0_extract( struct sim_context_type *ctx, const task_id_type task );
+#if SCH_DOUBLED_QUEUE
+static void q1_extract( struct sim_context_type *ctx, const task_id_type task, struct task_type *header );
+#endif
+#if SCH_DISPATCH_ALGORITHMS
+static void q2_extract( struct sim_context_type *ctx, const task_id_type task, struct task_type *header );
+#endif
+
+static boolean q_empty( struct sim_context_type *ctx, const U8 queue, const struct task_type *header );
+static task_id_type q_first_id( struct sim_context_type *ctx, const U8 queue, const struct task_type *header );
+#if SCH_ALG_BUILT(SCH_NUM_EDF_RTO)
+static task_id_type q_second_id( struct sim_context_type *ctx, const U8 queue, const struct task_type *header );
+#endif
+#if SCH_OVERLOAD_ALGORITHMS
+static task_id_type get_lowest_priority_active_task( struct sim_context_type *ctx );
+#endif
+#if SCH_ALG_BUILT(SCH_NUM_ADAP_07)
+static task_id_type get_active_task_priority( struct sim_context_type *ctx );
+#endif
+#if SCH_DOUBLED_QUEUE
+static void calculate_active_task_priority( struct sim_context_type *ctx, const task_id_type task );
+#endif
+#if SCH_ALG_BUILT(SCH_NUM_EDF_RTO)
+static U8 task_skippable( struct sim_context_type *ctx, const task_id_type task );
+static boolean can_meet_deadline( struct sim_context_type *ctx, const task_id_type task, const U32 timeval );
+#endif
+#if SCH_DISPATCH_ALGORITHMS
+static void decrement_not_skipped_count( struct sim_context_type *ctx, const task_id_type task );
+#endif
+#if SCH_ADAPTIVE_ALGORITHMS
+static U16 calculate_all_task_utilities( struct sim_context_type *ctx );
+static U16 calculate_task_utility( struct sim_context_type *ctx, const task_id_type task );
+#endif
+static U16 get_task_set_utility( struct sim_context_type *ctx );
+static boolean task_has_utility( struct sim_context_type *ctx, const task_id_type task );
+static void update_utility_share( struct sim_context_type *ctx, const task_id_type task );
+static task_id_type removed_queue_has_task_with_lower_utility( struct sim_context_type *ctx, const U16 util );
+#if SCH_DOUBLING_ALGORITHMS
+static U8 double_task_period( struct sim_context_type *ctx, const task_id_type task );
+#endif
+#if SCH_DOUBLED_QUEUE
+static void half_task_period( struct sim_context_type *ctx, const task_id_type task );
+#endif
 #if(0)
-static void q_dump( const struct task_type *header );
-static void q1_dump( const struct task_type *header );
+static void q_dump( struct sim_context_type *ctx, const struct task_type *header );
+static void q1_dump( struct sim_context_type *ctx, const struct task_type *header );
 #ifdef DEBUG
-    static void task_params( void );
+    static void task_params( struct sim_context_type *ctx );
 #endif
 #endif
+#if SCH_PROFILE
+static sch_queue_type profile_queue( struct sim_context_type *ctx, const struct task_type *header );
+#endif
+
+/* a per tick phase of the scheduler */
+typedef void (*sch_phase_type)( struct sim_context_type *ctx, const U32 timeval );
+
+/* scheduling policy - how SCH_start() runs an algorithm */
+struct sch_policy_type
+{
+    q_order_type   ready_order;   /* ready queue order                       */
+    sch_phase_type doubled;       /* doubled period processing, or NULL      */
+    sch_phase_type skipped;       /* skipped task processing, or NULL        */
+    boolean        lst_queue;     /* ready tasks also on LST queue (queue 2) */
+    boolean        time_driven;   /* must run every tick, see SCH_next_event */
+    boolean        heap;          /* ready queue may be a heap, see -p       */
+    sch_phase_type dispatch;      /* schedules the ready queue, or NULL      */
+};
+
+/* policies, in algorithm_type order. Time driven algorithms are those whose */
+/* decisions depend on laxity, urgency or the system time itself             */
+/* The ready queue stays a list where -p is asked for if the list order     */
+/* rests on keys changed in place, or on urgency ties that move with time.   */
+/* In a single algorithm build only its own row is present.                  */
+static const struct sch_policy_type policies[] =
+{
+/*   order   doubled                  skipped                lst    time   heap   dispatch                          */
+#if SCH_ALG_BUILT(SCH_NUM_CYC)
+    {Q_NONE, NULL,                    NULL,                  FALSE, FALSE, TRUE,  schedule_cyc_algorithm          }, /* ALG_CYC     */
+#endif
+#if SCH_ALG_BUILT(SCH_NUM_RR)
+    {Q_NONE, NULL,                    NULL,                  FALSE, FALSE, TRUE,  schedule_rr_algorithm           }, /* ALG_RR      */
+#endif
+#if SCH_ALG_BUILT(SCH_NUM_RM)
+    {Q_PRI,  NULL,                    NULL,                  FALSE, FALSE, TRUE,  schedule_rm_algorithm           }, /* ALG_RM      */
+#endif
+#if SCH_ALG_BUILT(SCH_NUM_IRM)
+    {Q_NONE, NULL,                    NULL,                  FALSE, FALSE, TRUE,  schedule_irm_algorithm          }, /* ALG_IRM     */
+#endif
+#if SCH_ALG_BUILT(SCH_NUM_DRM)
+    {Q_PRI,  NULL,                    NULL,                  FALSE, TRUE,  TRUE,  schedule_drm_algorithm          }, /* ALG_DRM     */
+#endif
+#if SCH_ALG_BUILT(SCH_NUM_EDF)
+    {Q_EDF,  NULL,                    NULL,                  FALSE, FALSE, TRUE,  schedule_edf_algorithm          }, /* ALG_EDF     */
+#endif
+#if SCH_ALG_BUILT(SCH_NUM_SPT)
+    {Q_SPT,  NULL,                    NULL,                  FALSE, FALSE, TRUE,  schedule_spt_algorithm          }, /* ALG_SPT     */
+#endif
+#if SCH_ALG_BUILT(SCH_NUM_LLF)
+    {Q_LLF,  NULL,                    NULL,                  FALSE, TRUE,  TRUE,  schedule_llf_algorithm          }, /* ALG_LLF     */
+#endif
+#if SCH_ALG_BUILT(SCH_NUM_MLLF)
+    {Q_LLF,  NULL,                    NULL,                  FALSE, TRUE,  TRUE,  schedule_mllf_algorithm         }, /* ALG_MLLF    */
+#endif
+#if SCH_ALG_BUILT(SCH_NUM_MUF)
+    {Q_MUF,  NULL,                    NULL,                  FALSE, TRUE,  FALSE, schedule_muf_algorithm          }, /* ALG_MUF     */
+#endif
+#if SCH_ALG_BUILT(SCH_NUM_MMUF)
+    {Q_MUF,  NULL,                    NULL,                  FALSE, TRUE,  FALSE, schedule_mmuf_algorithm         }, /* ALG_MMUF    */
+#endif
+#if SCH_ALG_BUILT(SCH_NUM_MMMUF)
+    {Q_MUF,  NULL,                    NULL,                  FALSE, TRUE,  FALSE, schedule_mmmuf_algorithm        }, /* ALG_MMMUF   */
+#endif
+#if SCH_ALG_BUILT(SCH_NUM_D_STAR)
+    {Q_NONE, NULL,                    NULL,                  FALSE, TRUE,  TRUE,  NULL                            }, /* ALG_D_STAR  */
+#endif
+#if SCH_ALG_BUILT(SCH_NUM_DD_STAR)
+    {Q_NONE, NULL,                    NULL,                  FALSE, TRUE,  TRUE,  schedule_unsupported_algorithm  }, /* ALG_DD_STAR */
+#endif
+#if SCH_ALG_BUILT(SCH_NUM_D_OVER)
+    {Q_NONE, NULL,                    NULL,                  FALSE, TRUE,  TRUE,  schedule_unsupported_algorithm  }, /* ALG_D_OVER  */
+#endif
+#if SCH_ALG_BUILT(SCH_NUM_RM_RTO)
+    {Q_NONE, NULL,                    process_skipped_tasks, FALSE, TRUE,  TRUE,  schedule_unsupported_algorithm  }, /* ALG_RM_RTO  */
+#endif
+#if SCH_ALG_BUILT(SCH_NUM_EDF_RTO)
+    {Q_EDF,  NULL,                    process_skipped_tasks, FALSE, TRUE,  TRUE,  schedule_skip_rto_algorithm     }, /* ALG_EDF_RTO */
+#endif
+#if SCH_ALG_BUILT(SCH_NUM_EDF_BWP)
+    {Q_NONE, NULL,                    process_skipped_tasks, FALSE, TRUE,  TRUE,  schedule_unsupported_algorithm  }, /* ALG_EDF_BWP */
+#endif
+#if SCH_ALG_BUILT(SCH_NUM_ADAP_01)
+    {Q_EDF,  NULL,                    NULL,                  FALSE, FALSE, TRUE,  schedule_adapive_one_algorithm  }, /* ALG_ADAP_01 */
+#endif
+#if SCH_ALG_BUILT(SCH_NUM_ADAP_02)
+    {Q_EDF,  process_doubled_periods, NULL,                  FALSE, FALSE, TRUE,  schedule_adapive_one_algorithm  }, /* ALG_ADAP_02 */
+#endif
+#if SCH_ALG_BUILT(SCH_NUM_ADAP_03)
+    {Q_EDF,  process_doubled_periods, NULL,                  FALSE, FALSE, FALSE, schedule_adapive_three_algorithm}, /* ALG_ADAP_03 */
+#endif
+#if SCH_ALG_BUILT(SCH_NUM_ADAP_04)
+    {Q_EDF,  process_doubled_periods, NULL,                  FALSE, FALSE, FALSE, schedule_adapive_three_algorithm}, /* ALG_ADAP_04 */
+#endif
+#if SCH_ALG_BUILT(SCH_NUM_ADAP_05)
+    {Q_EDF,  process_doubled_periods, NULL,                  TRUE,  TRUE,  FALSE, schedule_adapive_five_algorithm }, /* ALG_ADAP_05 */
+#endif
+#if SCH_ALG_BUILT(SCH_NUM_ADAP_06)
+    {Q_EDF,  process_doubled_periods, NULL,                  TRUE,  TRUE,  FALSE, schedule_adapive_six_algorithm  }, /* ALG_ADAP_06 */
+#endif
+#if SCH_ALG_BUILT(SCH_NUM_ADAP_07)
+    {Q_EDF,  process_doubled_periods, NULL,                  FALSE, TRUE,  FALSE, schedule_adapive_seven_algorithm}, /* ALG_ADAP_07 */
+#endif
+#ifndef SCH_SINGLE_ALGORITHM
+    {Q_NONE, NULL,                    NULL,                  FALSE, TRUE,  TRUE,  schedule_unsupported_algorithm  }, /* ALG_MAX_ALG */
+#endif
+};
+
+/* policy of the loaded algorithm, a constant in a single algorithm build */
+#ifdef SCH_SINGLE_ALGORITHM
+    #define POLICY(ctx)  ( &policies[ZERO_CPV] )
+#else
+    #define POLICY(ctx)  ( (ctx)->policy )
+#endif
+
+/* SCH_start() phase profiling, nothing is compiled in unless SCH_PROFILE */
+#if SCH_PROFILE
+    /* runs a phase, adding its time and a call to the phase profile */
+    #define SCH_PHASE( ctx, p, call )                                       \
+        do                                                                  \
+        {                                                                   \
+            U32 phase_start = CLK_get_real_time();                          \
+            (ctx)->profile.phase = (p);                                     \
+            call;                                                           \
+            (ctx)->profile.phases[p].time += CLK_get_real_time() - phase_start; \
+            (ctx)->profile.phases[p].calls++;                               \
+            (ctx)->profile.phase = SCH_PHASE_OTHER;                         \
+        } while( 0 )
+
+    /* queue operations, counted against the phase running */
+    #define SCH_COUNT_INSERT( ctx, header ) \
+        ( (ctx)->profile.phases[(ctx)->profile.phase].inserts[profile_queue( (ctx), (header) )]++ )
+    #define SCH_COUNT_EXTRACT( ctx, header ) \
+        ( (ctx)->profile.phases[(ctx)->profile.phase].extracts[profile_queue( (ctx), (header) )]++ )
+
+    static const S8* const profile_phase_names[SCH_PHASE_MAX] =
+    {
+        (S8*)"Sched phase waiting   calls",
+        (S8*)"Sched phase completed calls",
+        (S8*)"Sched phase removed   calls",
+        (S8*)"Sched phase doubled   calls",
+        (S8*)"Sched phase skipped   calls",
+        (S8*)"Sched phase idle      calls",
+        (S8*)"Sched phase ready     calls",
+        (S8*)"Sched phase other     calls"
+    };
+
+    static const S8* const profile_queue_names[SCH_QUEUE_MAX] =
+    {
+        (S8*)"    ready queue    inserts",
+        (S8*)"    idle queue     inserts",
+        (S8*)"    waiting queue  inserts",
+        (S8*)"    skipped queue  inserts",
+        (S8*)"    removed queue  inserts",
+        (S8*)"    doubled queue  inserts",
+        (S8*)"    LST queue      inserts"
+    };
+#else
+    #define SCH_PHASE( ctx, p, call )           call
+    #define SCH_COUNT_INSERT( ctx, header )     ( (void)0 )
+    #define SCH_COUNT_EXTRACT( ctx, header )    ( (void)0 )
+#endif
 
 /******************************************************************************
 *                             PUBLIC FUNCTIONS
@@ -167,7 +435,7 @@ static void q1_dump( const struct task_type *header );
 /******************************************************************************
 *  Description : initialises scheduler object
 ******************************************************************************/
-void SCH_init( void )
+void SCH_init( struct sim_context_type *ctx )
 {
     U8 index;
 
@@ -178,23 +446,38 @@ void SCH_init( void )
     }
 
     /* dereference queue pointers */
-    ready_tasks     = &readys;
-    idle_tasks      = &idles;
-    skipped_tasks   = &skippeds;
-    lst_tasks       = &lsts;
-    removed_tasks   = &removeds;
-    waiting_tasks   = &waits;
-    doubled_periods = &doubleds;
+    ctx->ready_tasks     = &ctx->readys;
+    ctx->idle_tasks      = &ctx->idles;
+    ctx->skipped_tasks   = &ctx->skippeds;
+#if SCH_LST_QUEUE
+    ctx->lst_tasks       = &ctx->lsts;
+#else
+    ctx->lst_tasks       = NULL;
+#endif
+    ctx->removed_tasks   = &ctx->removeds;
+    ctx->waiting_tasks   = &ctx->waits;
+#if SCH_DOUBLED_QUEUE
+    ctx->doubled_periods = &ctx->doubleds;
+#else
+    ctx->doubled_periods = NULL;
+#endif
+
+    /* pick up the policy of the current algorithm */
+#ifdef SCH_SINGLE_ALGORITHM
+    ctx->algorithm = (algorithm_type)SCH_SINGLE_ALGORITHM;
+#else
+    SCH_set_algorithm( ctx, ctx->algorithm );
+#endif
 } 
 
 /******************************************************************************
 *  Description : performs a soft initialisation of scheduler object
 ******************************************************************************/
-void SCH_soft_reset( void )
+void SCH_soft_reset( struct sim_context_type *ctx )
 {
     U8 index;
 
-    MESS_OUT_message( (S8*)"SCH_soft_reset()", MESSAGE_OP_DEBUG );
+    MESS_OUT_DEBUG( MESS_OUT_message( (S8*)"SCH_soft_reset()", MESSAGE_OP_DEBUG ) );
 
     /* initialise local tasks array */
     for( index=ZERO_CPV; index<NUM_OF_TASKS; index++ )
@@ -208,77 +491,162 @@ void SCH_soft_reset( void )
                         MESSAGE_OP_DEBUG );	  */
     
     /* reset the queue pointers */
-    SCH_reset_queues();
+    SCH_reset_queues( ctx );
+
+#if SCH_PROFILE
+    /* clear the phase profile */
+    for( index=ZERO_CPV; index<(U8)SCH_PHASE_MAX; index++ )
+    {
+        U8 queue;
+
+        ctx->profile.phases[index].calls = ZERO_CPV;
+        ctx->profile.phases[index].time  = ZERO_CPV;
+        for( queue=ZERO_CPV; queue<(U8)SCH_QUEUE_MAX; queue++ )
+        {
+            ctx->profile.phases[index].inserts[queue]  = ZERO_CPV;
+            ctx->profile.phases[index].extracts[queue] = ZERO_CPV;
+        }
+    }
+    ctx->profile.phase = SCH_PHASE_OTHER;
+#endif
 } 
 
 /******************************************************************************
 *  Description : Resets all queues
 ******************************************************************************/
-void SCH_reset_queues( void )
+void SCH_reset_queues( struct sim_context_type *ctx )
 {
-    U8 index;
+    U32 index;
 
-    MESS_OUT_message( (S8*)"SCH_reset_queues()", MESSAGE_OP_DEBUG );
+    MESS_OUT_DEBUG( MESS_OUT_message( (S8*)"SCH_reset_queues()", MESSAGE_OP_DEBUG ) );
 
     /* reset task pointers */
-    for( index=1; index<NUM_OF_TASKS; index++ )
+    for( index=1; index<=ctx->num_tasks; index++ )
     {
-        tasks[index]->q0_prev = ZERO_CPV;
-        tasks[index]->q1_prev = ZERO_CPV;
-        tasks[index]->q2_prev = ZERO_CPV;
-        tasks[index]->q0_next = ZERO_CPV;
-        tasks[index]->q1_next = ZERO_CPV;
-        tasks[index]->q2_next = ZERO_CPV;
+        ctx->tasks[index]->q0_prev = ZERO_CPV;
+        ctx->tasks[index]->q1_prev = ZERO_CPV;
+        ctx->tasks[index]->q2_prev = ZERO_CPV;
+        ctx->tasks[index]->q0_next = ZERO_CPV;
+        ctx->tasks[index]->q1_next = ZERO_CPV;
+        ctx->tasks[index]->q2_next = ZERO_CPV;
+        ctx->tasks[index]->q0_pos  = ZERO_CPV;
+        ctx->tasks[index]->util_share = ZERO_CPV;
+        ctx->tasks[index]->util_stale = FALSE;
     }
+
+    /* nothing counted in the task set utility */
+    ctx->task_set_util = ZERO_CPV;
+    ctx->stale_utils   = ZERO_CPV;
+
+    /* empty the ready heap, switching implementation if one was selected */
+    QUTIL_heap_reset( &ctx->ready_q );
+    set_ready_q_kind( ctx );
+
+    /* likewise the idle and waiting timing wheels */
+    QUTIL_wheel_reset( &ctx->idle_wheel );
+    QUTIL_wheel_reset( &ctx->waiting_wheel );
+    ctx->idle_wheel.q_kind    = ctx->release_q_kind;
+    ctx->waiting_wheel.q_kind = ctx->release_q_kind;
+
     /* reset header pointers */
-    ready_tasks->q0_prev            = ZERO_CPV;
-    ready_tasks->q0_next            = ZERO_CPV;
-    ready_tasks->q1_prev            = ZERO_CPV;
-    ready_tasks->q1_next            = ZERO_CPV;
-    ready_tasks->q2_prev            = ZERO_CPV;
-    ready_tasks->q2_next            = ZERO_CPV;
-
-    idle_tasks->q0_prev             = ZERO_CPV;
-    idle_tasks->q0_next             = ZERO_CPV;
-    idle_tasks->q1_prev             = ZERO_CPV;
-    idle_tasks->q1_next             = ZERO_CPV;
-    idle_tasks->q2_prev             = ZERO_CPV;
-    idle_tasks->q2_next             = ZERO_CPV;
-
-    skipped_tasks->q0_prev          = ZERO_CPV;
-    skipped_tasks->q0_next          = ZERO_CPV;
-    skipped_tasks->q1_prev          = ZERO_CPV;
-    skipped_tasks->q1_next          = ZERO_CPV;
-    skipped_tasks->q2_prev          = ZERO_CPV;
-    skipped_tasks->q2_next          = ZERO_CPV;
-
-    lst_tasks->q0_prev              = ZERO_CPV;
-    lst_tasks->q0_next              = ZERO_CPV;
-    lst_tasks->q1_prev              = ZERO_CPV;
-    lst_tasks->q1_next              = ZERO_CPV;
-    lst_tasks->q2_prev              = ZERO_CPV;
-    lst_tasks->q2_next              = ZERO_CPV;
-
-    removed_tasks->q0_prev          = ZERO_CPV;
-    removed_tasks->q0_next          = ZERO_CPV;
-    removed_tasks->q1_prev          = ZERO_CPV;
-    removed_tasks->q1_next          = ZERO_CPV;
-    removed_tasks->q2_prev          = ZERO_CPV;
-    removed_tasks->q2_next          = ZERO_CPV;
-
-    waiting_tasks->q0_prev          = ZERO_CPV;
-    waiting_tasks->q0_next          = ZERO_CPV;
-    waiting_tasks->q1_prev          = ZERO_CPV;
-    waiting_tasks->q1_next          = ZERO_CPV;
-    waiting_tasks->q2_prev          = ZERO_CPV;
-    waiting_tasks->q2_next          = ZERO_CPV;
-
-    doubled_periods->q0_prev        = ZERO_CPV;
-    doubled_periods->q0_next        = ZERO_CPV;
-    doubled_periods->q1_prev        = ZERO_CPV;
-    doubled_periods->q1_next        = ZERO_CPV;
-    doubled_periods->q2_prev        = ZERO_CPV;
-    doubled_periods->q2_next        = ZERO_CPV;
+    ctx->ready_tasks->q0_prev            = ZERO_CPV;
+    ctx->ready_tasks->q0_next            = ZERO_CPV;
+    ctx->ready_tasks->q1_prev            = ZERO_CPV;
+    ctx->ready_tasks->q1_next            = ZERO_CPV;
+    ctx->ready_tasks->q2_prev            = ZERO_CPV;
+    ctx->ready_tasks->q2_next            = ZERO_CPV;
+
+    ctx->idle_tasks->q0_prev             = ZERO_CPV;
+    ctx->idle_tasks->q0_next             = ZERO_CPV;
+    ctx->idle_tasks->q1_prev             = ZERO_CPV;
+    ctx->idle_tasks->q1_next             = ZERO_CPV;
+    ctx->idle_tasks->q2_prev             = ZERO_CPV;
+    ctx->idle_tasks->q2_next             = ZERO_CPV;
+
+    ctx->skipped_tasks->q0_prev          = ZERO_CPV;
+    ctx->skipped_tasks->q0_next          = ZERO_CPV;
+    ctx->skipped_tasks->q1_prev          = ZERO_CPV;
+    ctx->skipped_tasks->q1_next          = ZERO_CPV;
+    ctx->skipped_tasks->q2_prev          = ZERO_CPV;
+    ctx->skipped_tasks->q2_next          = ZERO_CPV;
+
+#if SCH_LST_QUEUE
+    ctx->lst_tasks->q0_prev              = ZERO_CPV;
+    ctx->lst_tasks->q0_next              = ZERO_CPV;
+    ctx->lst_tasks->q1_prev              = ZERO_CPV;
+    ctx->lst_tasks->q1_next              = ZERO_CPV;
+    ctx->lst_tasks->q2_prev              = ZERO_CPV;
+    ctx->lst_tasks->q2_next              = ZERO_CPV;
+#endif
+
+    ctx->removed_tasks->q0_prev          = ZERO_CPV;
+    ctx->removed_tasks->q0_next          = ZERO_CPV;
+    ctx->removed_tasks->q1_prev          = ZERO_CPV;
+    ctx->removed_tasks->q1_next          = ZERO_CPV;
+    ctx->removed_tasks->q2_prev          = ZERO_CPV;
+    ctx->removed_tasks->q2_next          = ZERO_CPV;
+
+    ctx->waiting_tasks->q0_prev          = ZERO_CPV;
+    ctx->waiting_tasks->q0_next          = ZERO_CPV;
+    ctx->waiting_tasks->q1_prev          = ZERO_CPV;
+    ctx->waiting_tasks->q1_next          = ZERO_CPV;
+    ctx->waiting_tasks->q2_prev          = ZERO_CPV;
+    ctx->waiting_tasks->q2_next          = ZERO_CPV;
+
+#if SCH_DOUBLED_QUEUE
+    ctx->doubled_periods->q0_prev        = ZERO_CPV;
+    ctx->doubled_periods->q0_next        = ZERO_CPV;
+    ctx->doubled_periods->q1_prev        = ZERO_CPV;
+    ctx->doubled_periods->q1_next        = ZERO_CPV;
+    ctx->doubled_periods->q2_prev        = ZERO_CPV;
+    ctx->doubled_periods->q2_next        = ZERO_CPV;
+#endif
+} 
+
+/******************************************************************************
+*  Description : toggles the ready queue between a linked list and a heap.
+*                Takes effect when the queues are next reset, at the start of
+*                a test. MUF and ADAP_03-07 keep a list, see policies[].
+******************************************************************************/
+void SCH_toggle_ready_queue( struct sim_context_type *ctx )
+{
+    if( ctx->ready_q_kind is Q_HEAP )
+    {
+        MESS_OUT_message( (S8*)"Ready queue is a linked list", MESSAGE_OP_LOG );
+        ctx->ready_q_kind = Q_LIST;
+    }
+    else
+    {
+        MESS_OUT_message( (S8*)"Ready queue is a heap", MESSAGE_OP_LOG );
+        ctx->ready_q_kind = Q_HEAP;
+    }
+} 
+
+/******************************************************************************
+*  Description : toggles the idle and waiting queues between linked lists and
+*                timing wheels. Takes effect when the queues are next reset,
+*                at the start of a test.
+******************************************************************************/
+void SCH_toggle_release_queues( struct sim_context_type *ctx )
+{
+    if( ctx->release_q_kind is Q_WHEEL )
+    {
+        MESS_OUT_message( (S8*)"Idle and waiting queues are linked lists", MESSAGE_OP_LOG );
+        ctx->release_q_kind = Q_LIST;
+    }
+    else
+    {
+        MESS_OUT_message( (S8*)"Idle and waiting queues are timing wheels", MESSAGE_OP_LOG );
+        ctx->release_q_kind = Q_WHEEL;
+    }
+} 
+
+/******************************************************************************
+*  Description : closes scheduler object, releasing the ready heap
+******************************************************************************/
+void SCH_close( struct sim_context_type *ctx )
+{
+    QUTIL_heap_free( &ctx->ready_q );
 } 
 
 /******************************************************************************
@@ -288,59 +656,74 @@ void SCH_reset_queues( void )
 *                ready queue unless 'release' has a value.
 *  Notes       : Adapted from code in Buttazzo's book (Buttazzo 2005)
 ******************************************************************************/
-void SCH_add_task( const U8 task_id, const U8 test_task_id )
+void SCH_add_task( struct sim_context_type *ctx, const task_id_type task_id, const U8 test_task_id )
 {
-    MESS_OUT_message_2( (S8*)"SCH_add_task(): Task ",
-                        task_id,
-                        (S8*)" loaded with id = ",
-                        tasks[task_id]->id,
-                        MESSAGE_OP_DEBUG );
+    MESS_OUT_DEBUG( MESS_OUT_message_2( (S8*)"SCH_add_task(): Task ",
+                                        task_id,
+                                        (S8*)" loaded with id = ",
+                                        ctx->tasks[task_id]->id,
+                                        MESSAGE_OP_DEBUG ) );
     
     /* load test_task[] pointer into task[] */
     #if(0)
-    tasks[task_id] = TSK_load_task( task_id, test_task_id );  
+    ctx->tasks[task_id] = TSK_load_task( ctx, task_id, test_task_id );  
 	#else
-   	TSK_add_task( test_task_id, tasks[task_id] );	 
+   	TSK_add_task( test_task_id, ctx->tasks[task_id], &TSK_STATS(task_id) );	 
 	#endif
 
-    if( tasks[task_id]->id > ZERO_CPV )
+    SCH_queue_task( ctx, task_id );
+}
+
+/******************************************************************************
+*  Description : Queues a task already loaded into tasks[], in the waiting
+*                queue if it has a release time, otherwise in the idle queue.
+*                Used by SCH_add_task(), and for task sets made up at run
+*                time.
+******************************************************************************/
+void SCH_queue_task( struct sim_context_type *ctx, const task_id_type task_id )
+{
+    if( ctx->tasks[task_id]->id > ZERO_CPV )
     {
         /* initialise calculated utility with estimated */
-        tasks[task_id]->task_util = tasks[task_id]->task_util;
+        ctx->tasks[task_id]->task_util = ctx->tasks[task_id]->task_util;
 
         /* initialised calculated duration with estimated */
-        tasks[task_id]->c_duration = tasks[task_id]->duration;
+        ctx->tasks[task_id]->c_duration = TSK_STATS(task_id).duration;
+        SCH_utility_stale( ctx, task_id );
 
-        if( tasks[task_id]->release > 0 )
+        if( TSK_STATS(task_id).release > 0 )
         {
             /* set state */
-            tasks[task_id]->state = TSK_WAITING;
+            ctx->tasks[task_id]->state = TSK_WAITING;
 
             /* set deadline for time in wait queue */
-            tasks[task_id]->abs_dline = tasks[task_id]->release;
+            ctx->tasks[task_id]->abs_dline = TSK_STATS(task_id).release;
 
             /* queue new idle task in deadline order */
-            q0_insert( task_id, waiting_tasks, ALG_EDF );
+            q0_insert( ctx, task_id, ctx->waiting_tasks, Q_EDF );
         }
         else
         {
             /* set state */
-            tasks[task_id]->state = TSK_IDLE;
+            ctx->tasks[task_id]->state = TSK_IDLE;
 
             /* queue new idle task in deadline order */
-            q0_insert( task_id, idle_tasks, ALG_EDF );
+            q0_insert( ctx, task_id, ctx->idle_tasks, Q_EDF );
         }
 
         /* set not-skipped count */
         NOT_SKIPPED(task_id) = (U8)SKIP_GAP(task_id);
+
+        /* count it in the task set utility */
+        update_utility_share( ctx, task_id );
     }
 
     #ifdef DEBUG
         OPR_0_message( (S8*)"Ready tasks\n" );
-        q_dump( ready_tasks );
+        q_dump( ctx, ctx->ready_tasks );
         OPR_0_message( (S8*)"Idle tasks\n" );
-        q_dump( idle_tasks );
-        task_params();
+        q_dump( ctx, ctx->idle_tasks );
+        task_params( ctx );
     #endif
 }
 
@@ -351,52 +734,108 @@ void SCH_add_task( const U8 task_id, const U8 test_task_id )
 *                - if there are ready tasks then schedule
 *                - calls some algorithm specific functions
 *  Notes       : Adapted from code in Buttazzo's book (Buttazzo 2005)
-*  Parameters  : timeval - system time
+*  Parameters  : ctx     - simulation context
+*                timeval - system time
 ******************************************************************************/
-void SCH_start( const U32 timeval )
+void SCH_start( struct sim_context_type *ctx, const U32 timeval )
 {
     CLK_start_timer( (U32)ZERO_CPV );         /* start the timer           */
-    calculate_all_laxities( timeval );        /* calculate laxity          */
 
-    if(     (algorithm is ALG_MUF)
-          or(algorithm is ALG_MMUF)
-          or(algorithm is ALG_MMMUF)   )
+    /* process waiting tasks */
+    SCH_PHASE( ctx, SCH_PHASE_WAITING,   process_waiting_tasks( ctx, timeval ) );
+    /* process completed tasks */
+    SCH_PHASE( ctx, SCH_PHASE_COMPLETED, process_completed_tasks( ctx, timeval ) );
+    /* process any removed tasks */
+    SCH_PHASE( ctx, SCH_PHASE_REMOVED,   process_removed_tasks( ctx, timeval ) );
+
+    if( POLICY(ctx)->doubled is_not NULL )
+    {
+        /* process any doubled tasks */
+        SCH_PHASE( ctx, SCH_PHASE_DOUBLED, POLICY(ctx)->doubled( ctx, timeval ) );
+    }
+
+    if( POLICY(ctx)->skipped is_not NULL )
     {
-        calculate_all_muf_urgencies();        /* calculate muf urgency     */
+        /* process any skipped tasks */
+        SCH_PHASE( ctx, SCH_PHASE_SKIPPED, POLICY(ctx)->skipped( ctx, timeval ) );
     }
 
-    process_waiting_tasks( timeval );         /* process waiting tasks     */
-    process_completed_tasks( timeval );       /* process completed tasks   */
-    process_removed_tasks( timeval);          /* process any removed tasks */
+    /* process any idle tasks */
+    SCH_PHASE( ctx, SCH_PHASE_IDLE,      process_idle_tasks( ctx, timeval ) );
+    /* process any ready tasks */
+    SCH_PHASE( ctx, SCH_PHASE_READY,     process_ready_tasks( ctx, timeval ) );
+
+    /* scheduler time, the timer runs on to the scheduler report */
+    LAT_record( &ctx->latency, timeval, CLK_end_timer() );
+} 
 
-    if(     (algorithm is ALG_ADAP_02)
-          or(algorithm is ALG_ADAP_03)
-          or(algorithm is ALG_ADAP_04)
-          or(algorithm is ALG_ADAP_05)
-          or(algorithm is ALG_ADAP_06)
-          or(algorithm is ALG_ADAP_07)   )
+/******************************************************************************
+*  Description : Setter function - sets scheduler algorithm to alg, and the
+*                policy SCH_start() runs it with. A single algorithm build
+*                keeps its own algorithm whatever alg is.
+******************************************************************************/
+void SCH_set_algorithm( struct sim_context_type *ctx, const algorithm_type alg )
+{
+#ifdef SCH_SINGLE_ALGORITHM
+    if( alg is_not (algorithm_type)SCH_SINGLE_ALGORITHM )
     {
-        process_doubled_periods();            /* process any doubled tasks */
+        MESS_OUT_message_1( (S8*)"SCH_set_algorithm(): only built for algorithm ",
+                            (U32)SCH_SINGLE_ALGORITHM + ONE_CPV,
+                            MESSAGE_OP_ERROR );
     }
 
+    ctx->algorithm = (algorithm_type)SCH_SINGLE_ALGORITHM;
+#else
+    ctx->algorithm = alg;
 
-    if(     (algorithm is ALG_RM_RTO)
-          or(algorithm is ALG_EDF_RTO)
-          or(algorithm is ALG_EDF_BWP)   )
+    if( alg < ALG_MAX_ALG )
+    {
+        ctx->policy = &policies[alg];
+    }
+    else
     {
-        process_skipped_tasks( timeval );     /* process any skipped tasks */
+        ctx->policy = &policies[ALG_MAX_ALG];
     }
 
-    process_idle_tasks( timeval );            /* process any idle tasks    */
-    process_ready_tasks( timeval );           /* process any ready tasks   */
-} 
+    /* an empty ready queue takes the kind the new policy allows */
+    if( (ctx->ready_q.size is ZERO_CPV) and (ctx->readys.q0_next is ZERO_CPV) )
+    {
+        set_ready_q_kind( ctx );
+    }
+#endif
+}
 
 /******************************************************************************
-*  Description : Setter function - sets scheduler algorithm to alg
+*  Description : Returns TRUE if alg is built, orders its ready queue and has
+*                a scheduler, FALSE for the algorithms listed but not yet
+*                written
 ******************************************************************************/
-void SCH_set_algorithm( const algorithm_type alg )
+boolean SCH_algorithm_supported( const algorithm_type alg )
 {
-    algorithm = alg;
+    const struct sch_policy_type *policy = NULL;
+    boolean supported = FALSE;
+
+#ifdef SCH_SINGLE_ALGORITHM
+    if( alg is (algorithm_type)SCH_SINGLE_ALGORITHM )
+    {
+        policy = &policies[ZERO_CPV];
+    }
+#else
+    if( alg < ALG_MAX_ALG )
+    {
+        policy = &policies[alg];
+    }
+#endif
+
+    if(    ( policy is_not NULL )
+       and ( policy->ready_order is_not Q_NONE )
+       and ( policy->dispatch is_not NULL )
+       and ( policy->dispatch is_not schedule_unsupported_algorithm ) )
+    {
+        supported = TRUE;
+    }
+
+    return( supported );
 }
 
 /******************************************************************************
@@ -491,59 +930,228 @@ void SCH_report_algorithm( const algorithm_type a, const message_class class )
 /******************************************************************************
 *  Description : Calls local function - tells what algorithm is loaded
 ******************************************************************************/
-void SCH_what_algorithm( const message_class class )
+void SCH_what_algorithm( struct sim_context_type *ctx, const message_class class )
 {
-    SCH_report_algorithm( algorithm, class );
+    SCH_report_algorithm( ctx->algorithm, class );
 }
 
 /******************************************************************************
 *  Description : Access function returns the loaded algorithm type
 ******************************************************************************/
-algorithm_type SCH_get_algorithm( void )
+algorithm_type SCH_get_algorithm( struct sim_context_type *ctx )
 {
-	return algorithm;
+	return ctx->algorithm;
 } 
 
+/******************************************************************************
+*  Description : Returns the earliest system time after timeval at which
+*                SCH_start() can change the schedule. Candidates are the
+*                running task completing, and the heads of the waiting, idle
+*                and skipped queues reaching their abs_dline. Between these
+*                times the running task simply consumes ticks, so the caller
+*                may jump straight to the returned time.
+*  Notes       : Algorithms that re-evaluate laxity or urgency every tick
+*                always return timeval + 1.
+*  Parameters  : ctx     - simulation context
+*                timeval - system time of the last SCH_start() call
+******************************************************************************/
+U32 SCH_next_event( struct sim_context_type *ctx, const U32 timeval )
+{
+    U32 next_event = 0xFFFFFFFF;
+    U32 event;
+
+    if( POLICY(ctx)->time_driven is TRUE )
+    {
+        next_event = timeval + ONE_CPV;
+    }
+    else
+    {
+        /* running task completes once its time_left has been consumed */
+        if( ctx->running_task_id > ZERO_CPV )
+        {
+            next_event = timeval + ctx->tasks[ctx->running_task_id]->time_left;
+        }
+
+        /* waiting task becomes idle at its release */
+        event = q_next_release( ctx, ctx->waiting_tasks );
+        if( event < next_event )
+        {
+            next_event = event;
+        }
+
+        /* idle task becomes ready at its deadline */
+        event = q_next_release( ctx, ctx->idle_tasks );
+        if( event < next_event )
+        {
+            next_event = event;
+        }
+
+        /* skipped task is restored at its deadline */
+        if( !q_empty( ctx, ZERO_CPV, ctx->skipped_tasks) )
+        {
+            event = ctx->tasks[ q_first_id( ctx, ZERO_CPV, ctx->skipped_tasks) ]->abs_dline;
+            if( event < next_event )
+            {
+                next_event = event;
+            }
+        }
+
+        /* never stand still */
+        if( next_event <= timeval )
+        {
+            next_event = timeval + ONE_CPV;
+        }
+    }
+
+    return( next_event );
+}
+
+/******************************************************************************
+*  Description : returns the MUF urgency of task for the given laxity. The
+*                following is a bit map of the urgency word.
+*
+*                1 111-1111-1111-1111-1111-1111-1111 1111
+*                | |                               | |  |
+*                | |           27 bits             |  \/
+*                | |                               |   |       4 bits
+*                | |                               |   \- user defined priority
+*                | |                               |
+*                | \-------------   --------------/
+*                |               \ /
+*                |                \--inverse of laxity (dynamic priority)
+*                |
+*                |
+*                \---------- msb=1 if in critical set, ELSE msb=0
+*
+*  Notes       : Adapted from by Stewart and Khoslas paper proposing the
+*                Maximum Urgency First (MUF) algorithm
+*                (Stewart and Khosla 1991).
+*                Worked out when needed from the laxity, usually
+*                LAXITY(task, timeval), instead of being stored for every
+*                task on every tick.
+******************************************************************************/
+U32 SCH_muf_urgency( struct sim_context_type *ctx, const task_id_type task, const U32 laxity )
+{
+    const U32 l_shift = 4U;                /* laxity shift            */
+    const U32 c_mask  = (U32)0x80000000u;  /* critical mask           */
+    const U32 l_mask  = (U32)0x07ffffffu;  /* laxity mask (pre-shift) */
+    const U32 p_mask  = (U32)0x0000000fu;  /* priority mask           */
+
+    U32 urgency;
+
+    /*  set critical bit */
+    if( MUF_CRITICAL(task) is ONE_CPV )
+    {
+        urgency = c_mask;
+    }
+    else
+    {
+        urgency = ZERO_CPV;
+    }
+
+    /* set inverse laxity and load bits */
+    urgency |= ( ((~laxity) & l_mask) << l_shift );
+
+    /* load priority bits */
+    urgency |= ( ctx->tasks[task]->priority & p_mask );
+
+    return( urgency );
+}
+
+/******************************************************************************
+*  Description : Marks the utility of task as stale, to be worked out again
+*                by the next calculate_all_task_utilities(). Called whenever
+*                the calculated duration of the task changes.
+******************************************************************************/
+void SCH_utility_stale( struct sim_context_type *ctx, const task_id_type task )
+{
+    if( ctx->tasks[task]->util_stale is FALSE )
+    {
+        ctx->tasks[task]->util_stale = TRUE;
+        ctx->stale_utils++;
+    }
+}
+
+#if SCH_PROFILE
+/******************************************************************************
+*  Description : Reports the SCH_start() phase profile at end of test - per
+*                phase the calls, the time in CLK_ clock units and the queue
+*                inserts and extracts. Phase times include any debug or
+*                verbose output, run with -q for scheduler time only.
+******************************************************************************/
+void SCH_profile_report( struct sim_context_type *ctx )
+{
+    const struct sch_phase_profile_type *phase;
+    U32 index;
+    U32 queue;
+    U32 inserts;
+    U32 extracts;
+
+    for( index=ZERO_CPV; index<(U32)SCH_PHASE_MAX; index++ )
+    {
+        phase = &ctx->profile.phases[index];
+
+        inserts  = ZERO_CPV;
+        extracts = ZERO_CPV;
+        for( queue=ZERO_CPV; queue<(U32)SCH_QUEUE_MAX; queue++ )
+        {
+            inserts  += phase->inserts[queue];
+            extracts += phase->extracts[queue];
+        }
+
+        if( (phase->calls > ZERO_CPV) or (inserts > ZERO_CPV) or (extracts > ZERO_CPV) )
+        {
+            MESS_OUT_message_4( profile_phase_names[index], phase->calls,
+                                (S8*)"time", phase->time,
+                                (S8*)"inserts", inserts,
+                                (S8*)"extracts", extracts,
+                                MESSAGE_OP_RESULTS );
+
+            /* break down by queue */
+            for( queue=ZERO_CPV; queue<(U32)SCH_QUEUE_MAX; queue++ )
+            {
+                if( (phase->inserts[queue] > ZERO_CPV) or (phase->extracts[queue] > ZERO_CPV) )
+                {
+                    MESS_OUT_message_2( profile_queue_names[queue], phase->inserts[queue],
+                                        (S8*)"extracts", phase->extracts[queue],
+                                        MESSAGE_OP_RESULTS );
+                }
+            }
+        }
+    }
+}
+#endif
+
 /******************************************************************************
 *                            PRIVATE FUNCTIONS
 ******************************************************************************/
 
 
-   
 /******************************************************************************
 *  Description : Private helper used by SCH_start() to process waiting tasks.
 *                A task is transferred from waiting to idle when its abs_dline
 *                has been been reached
 *  Notes       : Adapted from code in Buttazzo's book (Buttazzo 2005)
 ******************************************************************************/
-static void process_waiting_tasks( const U32 timeval  )
+static void process_waiting_tasks( struct sim_context_type *ctx, const U32 timeval  )
 {
-    U8 task;
+    task_id_type task;
 
-    while(  /* the waiting queue is NOT empty */
-            ( !q_empty(ZERO_CPV,waiting_tasks) )
-            and /* AND the last deadline is less than or equal to time now */
-            ( tasks[ task = q_first_id(ZERO_CPV,waiting_tasks) ]
-                                -> abs_dline <= timeval )
-         )
+    /* extract each waiting task whose release has been reached */
+    while( ( task = q_extract_due( ctx, ctx->waiting_tasks, timeval ) ) is_not ZERO_CPV )
     {
-        /* extract first waiting task - removes from queue */
-        task = q_extract_first( waiting_tasks );
-
         /* change state to idle */
-        tasks[task]->state = TSK_IDLE;
-
-        calculate_all_laxities( timeval );        /* calculate laxity      */
-        calculate_all_muf_urgencies();            /* calculate muf urgency */
+        ctx->tasks[task]->state = TSK_IDLE;
+        update_utility_share( ctx, task );
 
         /* add to idle queue */
-        q0_insert( task, idle_tasks, ALG_EDF );
+        q0_insert( ctx, task, ctx->idle_tasks, Q_EDF );
 
 
         #ifdef DEBUG
-            MESS_OUT_message( (S8*)"Waiting tasks", MESSAGE_OP_DEBUG );
-            q_dump( waiting_tasks );
-            task_params();
+            MESS_OUT_DEBUG( MESS_OUT_message( (S8*)"Waiting tasks", MESSAGE_OP_DEBUG ) );
+            q_dump( ctx, ctx->waiting_tasks );
+            task_params( ctx );
         #endif
     }
 } 
@@ -558,32 +1166,33 @@ static void process_waiting_tasks( const U32 timeval  )
 *                    might not be enough and decision made whether to transfer
 *                    it to the ready queue made.
 ******************************************************************************/
-static void process_completed_tasks( const U32 timeval  )
+static void process_completed_tasks( struct sim_context_type *ctx, const U32 timeval  )
 {
     if( /* is there a running task? */
-        (running_task_id > ZERO_CPV)
+        (ctx->running_task_id > ZERO_CPV)
         and /* AND has its time_left expired? */
-        (tasks[running_task_id]->time_left is ZERO_CPV)  )
+        (ctx->tasks[ctx->running_task_id]->time_left is ZERO_CPV)  )
     {
         /* inform task object */
-        TSK_task_completed( running_task_id, timeval );
+        TSK_task_completed( ctx, ctx->running_task_id, timeval );
 
-        if( tasks[running_task_id]->period > ZERO_CPV )
+        if( ctx->tasks[ctx->running_task_id]->period > ZERO_CPV )
         {
             /* periodic - change state to idle */
-            tasks[running_task_id]->state = TSK_IDLE;
+            ctx->tasks[ctx->running_task_id]->state = TSK_IDLE;
 
             /* place in idle queue in EDF order */
-            q0_insert( running_task_id, idle_tasks, ALG_EDF );
+            q0_insert( ctx, ctx->running_task_id, ctx->idle_tasks, Q_EDF );
         }
         else
         {
             /* non-periodic - change state to sleep */
-            tasks[running_task_id]->state = TSK_SLEEP;
+            ctx->tasks[ctx->running_task_id]->state = TSK_SLEEP;
+            update_utility_share( ctx, ctx->running_task_id );
         }
 
         /* clear running task id */
-        running_task_id = ZERO_CPV;
+        ctx->running_task_id = ZERO_CPV;
     }
 } 
 
@@ -591,78 +1200,79 @@ static void process_completed_tasks( const U32 timeval  )
 *  Description : Private helper used by SCH_start() to process removed tasks.
 *                Only runs for Adaptive-Two algorithm
 ******************************************************************************/
-static void process_removed_tasks( const U32 timeval )
+static void process_removed_tasks( struct sim_context_type *ctx, const U32 timeval )
 {
-    U8  task;
-    U16 old_utility;
+    task_id_type task;
     U16 task_set_utility;
     U16 spare_utility;
 
-    if( algorithm is ALG_ADAP_02 )
+    if( ctx->algorithm is ALG_ADAP_02 )
     {
         /* get task set utility */
-        task_set_utility = get_task_set_utility();
+        task_set_utility = get_task_set_utility( ctx );
 
         spare_utility = MAX_EDF_UTIL - task_set_utility;
 
         /* get task with utility that is smaller than utility */
-        task = removed_queue_has_task_with_lower_utility( spare_utility );
+        task = removed_queue_has_task_with_lower_utility( ctx, spare_utility );
 
         while(  ( task_set_utility < MAX_EDF_UTIL ) /* there is spare utility */
                 and /* removed queue NOT empty & has a task that will fit */
                 ( task > ZERO_CPV )  )
         {
             /* extract removed task from queue */
-            q0_extract( task );
+            q0_extract( ctx, task );
 
             /* change state to idle */
-            tasks[task]->state = TSK_IDLE;
+            ctx->tasks[task]->state = TSK_IDLE;
+            update_utility_share( ctx, task );
 
             /* reset the task deadline */
-            tasks[task]->abs_dline = timeval;
+            ctx->tasks[task]->abs_dline = timeval;
 
             /* add to idle queue in deadline order */
-            q0_insert( task, idle_tasks, ALG_EDF );
+            q0_insert( ctx, task, ctx->idle_tasks, Q_EDF );
 
             /* report task replacement */
-            MESS_OUT_message_1( (S8*)"Replacing task ", 
-                                task, 
-                                MESSAGE_OP_VERBOSE );
+            MESS_OUT_VERBOSE( MESS_OUT_message_1( (S8*)"Replacing task ", 
+                                                  task, 
+                                                  MESSAGE_OP_VERBOSE ) );
 
             /* recalculate spare task set utility */
-            old_utility = MAX_EDF_UTIL - spare_utility;
-
-            task_set_utility = get_task_set_utility();
+            task_set_utility = get_task_set_utility( ctx );
 
             /* find if there is any other tasks in removed queue */
-            task = removed_queue_has_task_with_lower_utility( spare_utility );
+            task = removed_queue_has_task_with_lower_utility( ctx, spare_utility );
 
-            MESS_OUT_message_2( (S8*)"Utility changed from ", old_utility,
-                                (S8*)" to ", task_set_utility, 
-                                MESSAGE_OP_VERBOSE );
+            MESS_OUT_VERBOSE( MESS_OUT_message_2( (S8*)"Utility changed from ", MAX_EDF_UTIL - spare_utility,
+                                                  (S8*)" to ", task_set_utility, 
+                                                  MESSAGE_OP_VERBOSE ) );
         }
     }
 } 
 
+#if SCH_DOUBLED_QUEUE
 /******************************************************************************
 *  Description : Private helper used by SCH_start()
 *                processes doubled tasks, restoring when there is sufficient
 *                task utility
 ******************************************************************************/
-static void process_doubled_periods( void )
+static void process_doubled_periods( struct sim_context_type *ctx, const U32 timeval )
 {
-    U8  task;
+    task_id_type task;
+#if MESS_OUT_LEVEL >= MESS_OUT_LEVEL_VERBOSE
     U16 old_utility;
+#endif
     U16 task_set_utility;
 
-    if( algorithm is ALG_ADAP_04 )
+    if( ctx->algorithm is ALG_ADAP_04 )
     {
         /* get task set utility */
-        task_set_utility = get_task_set_utility();
+        task_set_utility = get_task_set_utility( ctx );
 
         if( MAX_EDF_UTIL > task_set_utility )
         {
-            task = doubled_queue_has_task( MAX_EDF_UTIL - task_set_utility );
+            task = doubled_queue_has_task( ctx, MAX_EDF_UTIL - task_set_utility );
 
             /* get task with utility that is smaller than utility */
 
@@ -670,78 +1280,82 @@ static void process_doubled_periods( void )
                     and /* the doubled task queue is NOT empty & has a task that will fit */
                     ( task is_not ZERO_CPV )  )
             {
+#if MESS_OUT_LEVEL >= MESS_OUT_LEVEL_VERBOSE
                 /* remember previous utility for reporting purposes */
                 old_utility = task_set_utility;
+#endif
 
                 /* extract removed task from doubled_periods under queue-1 */
-                q1_extract( task, doubled_periods );
+                q1_extract( ctx, task, ctx->doubled_periods );
 
                 /* half the task period */
-                half_task_period( task );
+                half_task_period( ctx, task );
 
                 /* recalculate spare task set utility */
-                task_set_utility = get_task_set_utility();
+                task_set_utility = get_task_set_utility( ctx );
 
                 if( MAX_EDF_UTIL > task_set_utility )
                 {
                     /* find if there is any other tasks in removed queue */
-                    task = doubled_queue_has_task( MAX_EDF_UTIL - task_set_utility );
+                    task = doubled_queue_has_task( ctx, MAX_EDF_UTIL - task_set_utility );
                 }
 
-                MESS_OUT_message_2( (S8*)"Task set utility changed from ",
-                                    old_utility,
-                                    (S8*)" to ",
-                                    task_set_utility, 
-                                    MESSAGE_OP_VERBOSE );
+                MESS_OUT_VERBOSE( MESS_OUT_message_2( (S8*)"Task set utility changed from ",
+                                                      old_utility,
+                                                      (S8*)" to ",
+                                                      task_set_utility, 
+                                                      MESSAGE_OP_VERBOSE ) );
             }
         }
     }
-    else if( (algorithm is ALG_ADAP_06)or(algorithm is ALG_ADAP_07) )
+    else if( (ctx->algorithm is ALG_ADAP_06)or(ctx->algorithm is ALG_ADAP_07) )
     {
         /* get task set utility */
-        task_set_utility = calculate_all_task_utilities();
+        task_set_utility = calculate_all_task_utilities( ctx );
 
         if( MAX_EDF_UTIL > task_set_utility )
         {
-            task = doubled_queue_has_task( MAX_EDF_UTIL - task_set_utility );
+            task = doubled_queue_has_task( ctx, MAX_EDF_UTIL - task_set_utility );
 
             /* get task with utility that is smaller than utility */
             while(  ( task_set_utility < MAX_EDF_UTIL ) /* there is spare utility */
                     and /* the doubled task queue is NOT empty & has a task that will fit */
                     ( task is_not ZERO_CPV )  )
             {
+#if MESS_OUT_LEVEL >= MESS_OUT_LEVEL_VERBOSE
                 /* remember previous utility for reporting purposes */
                 old_utility = task_set_utility;
+#endif
 
                 /* extract removed task from doubled_periods under queue-1 */
-                q1_extract( task, doubled_periods );
+                q1_extract( ctx, task, ctx->doubled_periods );
 
                 /* half the task period */
-                half_task_period( task );
+                half_task_period( ctx, task );
 
-                if( tasks[task]->period_multiplyer > ZERO_CPV )
+                if( ctx->tasks[task]->period_multiplyer > ZERO_CPV )
                 {
                     /* re-calculate e_priority */
-                    calculate_active_task_priority( task );
+                    calculate_active_task_priority( ctx, task );
 
                     /* re-insert into doubled periods queue */
-                    q1_insert( task, doubled_periods, ALG_ADAP_07 );
+                    q1_insert( ctx, task, ctx->doubled_periods, Q_EPRI );
                 }
 
                 /* recalculate spare task set utility */
-                task_set_utility = calculate_all_task_utilities();
+                task_set_utility = calculate_all_task_utilities( ctx );
 
                 if( MAX_EDF_UTIL > task_set_utility )
                 {
                     /* find if there is any other tasks in removed queue */
-                    task = doubled_queue_has_task( MAX_EDF_UTIL - task_set_utility );
+                    task = doubled_queue_has_task( ctx, MAX_EDF_UTIL - task_set_utility );
                 }
 
-                MESS_OUT_message_2( (S8*)"Task set utility changed from ",
-                                    old_utility,
-                                    (S8*)" to ",
-                                    task_set_utility,
-                                    MESSAGE_OP_VERBOSE );
+                MESS_OUT_VERBOSE( MESS_OUT_message_2( (S8*)"Task set utility changed from ",
+                                                      old_utility,
+                                                      (S8*)" to ",
+                                                      task_set_utility,
+                                                      MESSAGE_OP_VERBOSE ) );
             }
         }
     }
@@ -750,127 +1364,123 @@ static void process_doubled_periods( void )
         /* do nothing */
     }
 }
+#endif
 
+#if SCH_DOUBLED_QUEUE
 /******************************************************************************
 *  Description : Private helper used by  process_doubled_periods scans
 *                doubled queue and returns a suitable task, or zero
 *                Queue-1 only contains tasks that are doubled
 ******************************************************************************/
-static U8 doubled_queue_has_task( const U16 utility )
+static task_id_type doubled_queue_has_task( struct sim_context_type *ctx, const U16 utility )
 {
-    U8 task = ZERO_CPV;
+    task_id_type task = ZERO_CPV;
     U8 multiplyer;
-    U8 n;   /* auxiliary pointer to next task */
-    n = doubled_periods->q1_next;
+    task_id_type n;   /* auxiliary pointer to next task */
+    n = ctx->doubled_periods->q1_next;
 
-    multiplyer = tasks[n]->period_multiplyer;
+    multiplyer = ctx->tasks[n]->period_multiplyer;
 
-    while( (n is_not ZERO_CPV) and (tasks[n]->task_util > (utility << multiplyer) ) )
+    while( (n is_not ZERO_CPV) and (ctx->tasks[n]->task_util > (utility << multiplyer) ) )
     {
-        n = tasks[n]->q1_next;
-        multiplyer = tasks[n]->period_multiplyer;
+        n = ctx->tasks[n]->q1_next;
+        multiplyer = ctx->tasks[n]->period_multiplyer;
     }
 
-    if( tasks[n]->task_util <= (utility << multiplyer) )
+    if( ctx->tasks[n]->task_util <= (utility << multiplyer) )
     {
         task = n;
     }
 
     return( task );
 }
+#endif
 
+#if SCH_SKIP_ALGORITHMS
 /******************************************************************************
 *  Description : private helper used by SCH_start() to process skipped tasks
 *                A task is skipped until its q0_next deadline
 *  Notes       : Based on the "Skip-Over" paper by Koren and Shasha (1995).
 ******************************************************************************/
-static void process_skipped_tasks( const U32 timeval )
+static void process_skipped_tasks( struct sim_context_type *ctx, const U32 timeval )
 {
-    U8 task;
+    task_id_type task;
 
-    while(   ( !q_empty(ZERO_CPV, skipped_tasks) )
+    while(   ( !q_empty( ctx, ZERO_CPV, ctx->skipped_tasks) )
              and
-             ( timeval >= tasks[task=q_first_id( ZERO_CPV, skipped_tasks )]->abs_dline ) )
+             ( timeval >= ctx->tasks[task=q_first_id( ctx, ZERO_CPV, ctx->skipped_tasks )]->abs_dline ) )
     {
         /* get first idle task */
-        task = q_extract_first( skipped_tasks );
+        task = q_extract_first( ctx, ctx->skipped_tasks );
 
         /* set absolute deadline */
-        tasks[task]->abs_dline = tasks[task]->rel_dline + timeval;
+        ctx->tasks[task]->abs_dline = ctx->tasks[task]->rel_dline + timeval;
 
         /* set time left to duration value */
-        tasks[task]->time_left = tasks[task]->c_duration;
+        ctx->tasks[task]->time_left = ctx->tasks[task]->c_duration;
 
         /* reset not-skipped count */
         NOT_SKIPPED(task) = (U8)SKIP_GAP(task);
 
-        if( tasks[task]->laxity is ZERO_CPV )
+        if( LAXITY(task, timeval) is ZERO_CPV )
         {
             /* put in ready queue */
-            q0_insert( task, ready_tasks, algorithm ); /* add to idle queue */
-            tasks[task]->state = TSK_READY;      /* change state to idle */
+            q0_insert( ctx, task, ctx->ready_tasks, POLICY(ctx)->ready_order ); /* add to idle queue */
+            ctx->tasks[task]->state = TSK_READY; /* change state to idle */
         }
         else
         {
             /* put in idle queue */
-            q0_insert( task, idle_tasks, algorithm );  /* add to ready queue */
-            tasks[task]->state = TSK_IDLE;       /* change state to ready */
+            q0_insert( ctx, task, ctx->idle_tasks, POLICY(ctx)->ready_order ); /* add to ready queue */
+            ctx->tasks[task]->state = TSK_IDLE;  /* change state to ready */
         }
+        update_utility_share( ctx, task );
     }
 }
+#endif
 
 /******************************************************************************
 *  Description : private helper used by SCH_start() to process idle tasks
 *  Notes       : Adapted from code in Buttazzo's book (Buttazzo 2005)
 ******************************************************************************/
-static void process_idle_tasks( const U32 timeval )
+static void process_idle_tasks( struct sim_context_type *ctx, const U32 timeval )
 {
-    U8 task;
+    task_id_type task;
 
-    while(  /* the idle queue is NOT empty */
-            ( !q_empty(ZERO_CPV,idle_tasks) )
-            and /* AND the last deadline is less than or equal to time now */
-            ( tasks[ task = q_first_id(ZERO_CPV, idle_tasks) ]
-                                ->abs_dline <= timeval )
-         )
+    /* extract each idle task whose deadline has been reached */
+    while( ( task = q_extract_due( ctx, ctx->idle_tasks, timeval ) ) is_not ZERO_CPV )
     {
-        /* extract first idle task - removes from queue */
-        task = q_extract_first( idle_tasks );
-
         /* set absolute deadline - also double check multiplier */
         if( PERIOD_FLEXIBLE(task)is ONE_CPV )
         {
-            tasks[task]->abs_dline +=
-               (tasks[task]->rel_dline << tasks[task]->period_multiplyer);
+            ctx->tasks[task]->abs_dline +=
+               (ctx->tasks[task]->rel_dline << ctx->tasks[task]->period_multiplyer);
         }
         else
         {
-            tasks[task]->abs_dline += (tasks[task]->rel_dline);
+            ctx->tasks[task]->abs_dline += (ctx->tasks[task]->rel_dline);
         }
 
         /* set time left to duration value */
-        tasks[task]->time_left = tasks[task]->c_duration;
+        ctx->tasks[task]->time_left = ctx->tasks[task]->c_duration;
 
         /* change state to ready */
-        tasks[task]->state = TSK_READY;
-
-        calculate_all_laxities( timeval );        /* calculate laxity      */
-        calculate_all_muf_urgencies();            /* calculate muf urgency */
+        ctx->tasks[task]->state = TSK_READY;
 
         /* add to ready queue */
-        q0_insert( task, ready_tasks, algorithm );
+        q0_insert( ctx, task, ctx->ready_tasks, POLICY(ctx)->ready_order );
 
         /* if in adaptive algorithm 05 then we are using laxity to */
         /* detect overload, using a second queue:                  */
-        if( (algorithm is ALG_ADAP_05) or (algorithm is ALG_ADAP_06) )
+        if( POLICY(ctx)->lst_queue is TRUE )
         {
-            q2_insert( task, lst_tasks, ALG_LLF );
+            q2_insert( ctx, task, ctx->lst_tasks, Q_LLF );
         }
 
         #ifdef DEBUG
             MESS_OUT_message( (S8*)"lst tasks\n", MESSAGE_OP_debug );
-            q_dump( lst_tasks );
-            task_params();
+            q_dump( ctx, ctx->lst_tasks );
+            task_params( ctx );
         #endif
     }
 
@@ -881,111 +1491,19 @@ static void process_idle_tasks( const U32 timeval )
 *  Description : private helper used by SCH_start() to process ready tasks
 *  Notes       : Adapted from code in Buttazzo's book (Buttazzo 2005)
 ******************************************************************************/
-static void process_ready_tasks( const U32 timeval )
+static void process_ready_tasks( struct sim_context_type *ctx, const U32 timeval )
 {
-    if( !q_empty(ZERO_CPV, ready_tasks) )
+    if(   ( !q_empty( ctx, ZERO_CPV, ctx->ready_tasks) )
+          and
+          ( POLICY(ctx)->dispatch is_not NULL )   )
     {
-        switch ( algorithm )
-        {
-            case ALG_ADAP_01:
-            case ALG_ADAP_02:
-                schedule_adapive_one_algorithm( timeval );
-                break;
-
-            case ALG_ADAP_03:
-            case ALG_ADAP_04:
-                schedule_adapive_three_algorithm();
-                break;
-
-            case ALG_ADAP_05:
-                schedule_adapive_five_algorithm( timeval );
-                break;
-
-            case ALG_ADAP_06:
-                schedule_adapive_six_algorithm( timeval );
-                break;
-
-            case ALG_ADAP_07:
-                schedule_adapive_seven_algorithm( timeval );
-                break;
-
-            case ALG_CYC:
-                /* cyclic executive */
-                schedule_cyc_algorithm();
-                break;
-
-            case ALG_RR:
-                /* round robin */
-                schedule_rr_algorithm();
-                break;
-
-            case ALG_RM:
-                schedule_rm_algorithm();
-                break;
-
-            case ALG_DRM:
-                schedule_drm_algorithm( timeval );
-                break;
-
-            case ALG_IRM:
-                schedule_irm_algorithm();
-                break;
-
-            case ALG_MUF:
-                schedule_muf_algorithm( timeval );
-                break;
-
-            case ALG_MMUF:
-                schedule_mmuf_algorithm( timeval );
-                break;
-
-            case ALG_MMMUF:
-                schedule_mmmuf_algorithm( timeval );
-                break;
-
-            case ALG_EDF:
-                schedule_edf_algorithm();
-                break;
-
-            case ALG_SPT:
-                schedule_spt_algorithm();
-                break;
-
-            case ALG_LLF:
-                schedule_llf_algorithm( timeval );
-                break;
-
-            case ALG_MLLF:
-                schedule_mllf_algorithm( timeval );
-                break;
-
-            case ALG_EDF_RTO:
-                schedule_skip_rto_algorithm( timeval );
-                break;
-
-            case ALG_D_STAR:
-                #if(0)
-                schedule_d_star_algorithm( timeval );
-                #endif
-                break; 
-
-            case ALG_RM_RTO:
-            case ALG_EDF_BWP:
-            case ALG_DD_STAR:
-            case ALG_D_OVER:
-            case ALG_MAX_ALG:
-            default:
-                /* do nothing */
-                MESS_OUT_message( (S8*)"default switch in process_ready_tasks()\n", 
-                                  MESSAGE_OP_ERROR );
-                break;
-        } /* end switch */
-
-    } /* end if */
+        POLICY(ctx)->dispatch( ctx, timeval );
+    }
 
 } /* process_ready_tasks() */
 
 
+#if SCH_ALG_BUILT(SCH_NUM_ADAP_01) || SCH_ALG_BUILT(SCH_NUM_ADAP_02)
 /******************************************************************************
 *  Description : private helper implements first adaptive design.
 *                In normal conditions, operates EDF
@@ -994,72 +1512,84 @@ static void process_ready_tasks( const U32 timeval )
 *                bounds by placing them onto removed queue.
 *  Notes       : Also used for adaptive two algorithm
 ******************************************************************************/
-static void schedule_adapive_one_algorithm( const U32 timeval )
+static void schedule_adapive_one_algorithm( struct sim_context_type *ctx, const U32 timeval )
 {
-    U8  lowest_priority;
+    task_id_type lowest_priority;
     U16 utility;
     U16 new_utility;
+    boolean task_left = TRUE;  /* a task is left to remove */
 
 	/* get the utility of the task set */
-	utility = calculate_all_task_utilities();
+	utility = calculate_all_task_utilities( ctx );
 
     /* check that task set utility is less than one (1000) */
-    while( utility > MAX_EDF_UTIL )
+    while( (utility > MAX_EDF_UTIL) and (task_left is TRUE) )
     {
         /* scheduler is in OVERLOAD */
         /* ======================== */
 
         /* identify active task with lowest priority */
-        lowest_priority = get_lowest_priority_active_task();
+        lowest_priority = get_lowest_priority_active_task( ctx );
 
-        /* and remove it */
-        MESS_OUT_message_1( (S8*)"Removing task ", 
-                            lowest_priority, 
-                            MESSAGE_OP_VERBOSE );
-
-        /* if the lowest priority task also happens to be the running */
-		/* task, then pre-empt it                                     */
-        if( lowest_priority is running_task_id )
+        if( lowest_priority is ZERO_CPV )
         {
-            /* lowest priority task is running */
-            preempt_task( lowest_priority );
+            /* no task left to remove, run on in overload */
+            task_left = FALSE;
         }
+        else
+        {
+            /* and remove it */
+            MESS_OUT_VERBOSE( MESS_OUT_message_1( (S8*)"Removing task ", 
+                                                  lowest_priority, 
+                                                  MESSAGE_OP_VERBOSE ) );
+
+            /* if the lowest priority task also happens to be the running */
+			/* task, then pre-empt it                                     */
+            if( lowest_priority is ctx->running_task_id )
+            {
+                /* lowest priority task is running */
+                preempt_task( ctx, lowest_priority );
+            }
 
-        /* extract lowest task from queue */
-        q0_extract( lowest_priority );
+            /* extract lowest task from queue */
+            q0_extract( ctx, lowest_priority );
 
-		/* record this activity to report storage */
-		TST_incr_test_report_value( TST_REMOVALS );
-		TOTAL_SKIPS(lowest_priority)++;
+			/* record this activity to report storage */
+			TST_incr_test_report_value( ctx, TST_REMOVALS );
+			TOTAL_SKIPS(lowest_priority)++;
 
-        /* place extracted task onto 'removed' queue, in priority order */
-        q0_insert( lowest_priority, removed_tasks, ALG_RM );
+            /* place extracted task onto 'removed' queue, in priority order */
+            q0_insert( ctx, lowest_priority, ctx->removed_tasks, Q_PRI );
 
-        /* change state of extracted task to removed */
-        tasks[lowest_priority]->state = TSK_REMOVED;
+            /* change state of extracted task to removed */
+            ctx->tasks[lowest_priority]->state = TSK_REMOVED;
+            update_utility_share( ctx, lowest_priority );
 
-        /* get the new task set utility */
-        new_utility = get_task_set_utility();
+            /* get the new task set utility */
+            new_utility = get_task_set_utility( ctx );
 
-        /* and report it */
-        MESS_OUT_message_2( (S8*)"Utility changed from ", utility, 
-                            (S8*)" to ", new_utility,
-                            MESSAGE_OP_VERBOSE );
+            /* and report it */
+            MESS_OUT_VERBOSE( MESS_OUT_message_2( (S8*)"Utility changed from ", utility, 
+                                                  (S8*)" to ", new_utility,
+                                                  MESSAGE_OP_VERBOSE ) );
 
-        /* reset utility value ready for next while loop */
-        utility = new_utility;
+            /* reset utility value ready for next while loop */
+            utility = new_utility;
+        }
 
     } /* end while loop */
 
     /* attempt to restore removed tasks */
-    process_removed_tasks( timeval );
+    process_removed_tasks( ctx, timeval );
 
     /* now perform normal EDF scheduling */
-    schedule_edf_algorithm();
+    schedule_edf_algorithm( ctx, timeval );
 
 } /* schedule_adapive_one_algorithm() */
+#endif
 
 
+#if SCH_ALG_BUILT(SCH_NUM_ADAP_03) || SCH_ALG_BUILT(SCH_NUM_ADAP_04)
 /******************************************************************************
 *  Description : private helper implements third adaptive design.
 *                In normal conditions, operates EDF
@@ -1067,45 +1597,56 @@ static void schedule_adapive_one_algorithm( const U32 timeval )
 *                Doubles the periods tasks with lower priority, until utility
 *                is within bounds.
 ******************************************************************************/
-static void schedule_adapive_three_algorithm( void )
+static void schedule_adapive_three_algorithm( struct sim_context_type *ctx, const U32 timeval )
 {
-    U8  lowest_priority = ZERO_CPV;
+    task_id_type lowest_priority = ZERO_CPV;
     U32 utility;
     U32 new_utility;
+    boolean task_left = TRUE;  /* a task is left to double */
 
     /* get the task set utility */
-	utility = calculate_all_task_utilities();
+	utility = calculate_all_task_utilities( ctx );
 
     /* check that task set utility is less than one */
-    while( utility > MAX_EDF_UTIL )
+    while( (utility > MAX_EDF_UTIL) and (task_left is TRUE) )
     {
         /* scheduler is in OVERLOAD */
         /* ======================== */
 
         /* identify active task with lowest priority */
-        lowest_priority = get_lowest_priority_active_task();
+        lowest_priority = get_lowest_priority_active_task( ctx );
 
-        (void)double_task_period( lowest_priority );
+        if( lowest_priority is ZERO_CPV )
+        {
+            /* no task left to double, run on in overload */
+            task_left = FALSE;
+        }
+        else
+        {
+            (void)double_task_period( ctx, lowest_priority );
 
-        /* en queue task into second list, doubled_periods, priority order */
-        q1_insert( lowest_priority, doubled_periods, ALG_RM );
+            /* en queue task into second list, doubled_periods, priority order */
+            q1_insert( ctx, lowest_priority, ctx->doubled_periods, Q_PRI );
 
-        /* get new utility */
-        new_utility = get_task_set_utility();
+            /* get new utility */
+            new_utility = get_task_set_utility( ctx );
 
-        MESS_OUT_message_2( (S8*)"Utility changed from ", utility, 
-                            (S8*)" to ", new_utility,
-                            MESSAGE_OP_VERBOSE );
+            MESS_OUT_VERBOSE( MESS_OUT_message_2( (S8*)"Utility changed from ", utility, 
+                                                  (S8*)" to ", new_utility,
+                                                  MESSAGE_OP_VERBOSE ) );
 
-        /* set for next while loop */
-        utility = new_utility;
+            /* set for next while loop */
+            utility = new_utility;
+        }
 
     } /* end while loop */
 
     /* now perform normal EDF scheduling */
-    schedule_edf_algorithm();
+    schedule_edf_algorithm( ctx, timeval );
 } 
+#endif
 
+#if SCH_ALG_BUILT(SCH_NUM_ADAP_05)
 /******************************************************************************
 *  Description : private helper implements fifth adaptive design.
 *                In normal conditions, operates EDF
@@ -1113,57 +1654,66 @@ static void schedule_adapive_three_algorithm( void )
 *                Doubles the periods tasks with lower priority, until utility
 *                is within bounds.
 ******************************************************************************/
-static void schedule_adapive_five_algorithm( const U32 timeval )
+static void schedule_adapive_five_algorithm( struct sim_context_type *ctx, const U32 timeval )
 {
-    U8  first_id;
-    U8  lowest_priority = ZERO_CPV;
+    task_id_type first_id;
+    task_id_type lowest_priority = ZERO_CPV;
     U32 laxity;
+    boolean task_left = TRUE;  /* a task is left to double */
 
     /* get index of first task in ready queue */
-    first_id = q_first_id( ZERO_CPV, ready_tasks );
+    first_id = q_first_id( ctx, ZERO_CPV, ctx->ready_tasks );
 
     /* get laxity for task at front of ready queue */
-    laxity = tasks[first_id]->laxity;
+    laxity = LAXITY(first_id, timeval);
 
-    while( laxity < tasks[running_task_id]->time_left )
+    while(    ( laxity < ctx->tasks[ctx->running_task_id]->time_left )
+          and ( task_left is TRUE ) )
     {
-        MESS_OUT_message_1( (S8*)"OVERLOAD: Laxity is zero for task ", 
-                            first_id, 
-                            MESSAGE_OP_VERBOSE );
+        MESS_OUT_VERBOSE( MESS_OUT_message_1( (S8*)"OVERLOAD: Laxity is zero for task ", 
+                                              first_id, 
+                                              MESSAGE_OP_VERBOSE ) );
 
         /* scheduler is in OVERLOAD */
         /* ======================== */
 
         /* identify active task with lowest priority */
-        lowest_priority = get_lowest_priority_active_task();
-
-        /* double period of lowest_priority task */
-        (void)double_task_period( lowest_priority );
+        lowest_priority = get_lowest_priority_active_task( ctx );
 
-        /* en queue task in second list, doubled_periods, priority order */
-        q1_insert( lowest_priority, doubled_periods, ALG_RM );
+        if( lowest_priority is ZERO_CPV )
+        {
+            /* no task left to double, run on in overload */
+            task_left = FALSE;
+        }
+        else
+        {
+            /* double period of lowest_priority task */
+            (void)double_task_period( ctx, lowest_priority );
 
-        /* recalculate laxities */
-        calculate_all_laxities( timeval );
+            /* en queue task in second list, doubled_periods, priority order */
+            q1_insert( ctx, lowest_priority, ctx->doubled_periods, Q_PRI );
 
-        /* get index of first task in ready queue */
-        first_id = q_first_id( ZERO_CPV, ready_tasks );
+            /* get index of first task in ready queue */
+            first_id = q_first_id( ctx, ZERO_CPV, ctx->ready_tasks );
 
-        /* get laxity for task at front of ready queue */
-        laxity = tasks[first_id]->laxity;
+            /* get laxity for task at front of ready queue */
+            laxity = LAXITY(first_id, timeval);
 
-        if( laxity > 0 )
-        {
-            MESS_OUT_message_1( (S8*)"Laxity is now ", 
-                                laxity, MESSAGE_OP_VERBOSE );
+            if( laxity > 0 )
+            {
+                MESS_OUT_VERBOSE( MESS_OUT_message_1( (S8*)"Laxity is now ", 
+                                                      laxity, MESSAGE_OP_VERBOSE ) );
+            }
         }
 
     } /* end while loop */
 
     /* now perform normal EDF scheduling */
-    schedule_edf_algorithm();
+    schedule_edf_algorithm( ctx, timeval );
 }
+#endif
 
+#if SCH_ALG_BUILT(SCH_NUM_ADAP_06)
 /******************************************************************************
 *  Description : private helper implements adaptive design #6.
 *                Features:
@@ -1171,11 +1721,11 @@ static void schedule_adapive_five_algorithm( const U32 timeval )
 *                - uses calculated task set utility
 *                - doubles tasks
 ******************************************************************************/
-static void schedule_adapive_six_algorithm( const U32 timeval )
+static void schedule_adapive_six_algorithm( struct sim_context_type *ctx, const U32 timeval )
 {
 	const U8 max_loop_count = 5;
-	U8  first_id;
-	U8  lowest_priority = ZERO_CPV;
+	task_id_type first_id;
+	task_id_type lowest_priority = ZERO_CPV;
 	U32 laxity;
 	U32 utility;
 	U32 new_utility;
@@ -1186,63 +1736,63 @@ static void schedule_adapive_six_algorithm( const U32 timeval )
 	/* set up a timed forced fault event */
 	if( timeval is time_frigg )
 	{
-		MESS_OUT_message_1( (S8*)"Running task duration incremented by ", 
-		                    task_frigg, 
-		                    MESSAGE_OP_VERBOSE );
+		MESS_OUT_VERBOSE( MESS_OUT_message_1( (S8*)"Running task duration incremented by ", 
+		                                      task_frigg, 
+		                                      MESSAGE_OP_VERBOSE ) );
 
 		/* mangle task parameter */
-		tasks[running_task_id]->time_taken += task_frigg;
+		ctx->tasks[ctx->running_task_id]->time_taken += task_frigg;
 	}
 
 	/* check that calculated task set utility is less than 100% */
-	utility = calculate_all_task_utilities();
+	utility = calculate_all_task_utilities( ctx );
 
 	/* get index of first task in ready queue */
-	first_id = q_first_id( ZERO_CPV, ready_tasks );
+	first_id = q_first_id( ctx, ZERO_CPV, ctx->ready_tasks );
 
 	/* get laxity for task at front of ready queue */
-	laxity = calculate_laxity( first_id, timeval );
+	laxity = LAXITY(first_id, timeval);
 
 	loop_count = ZERO_CPV;
-	while( ((utility > MAX_EDF_UTIL) or (laxity < tasks[running_task_id]->time_left))
+	while( ((utility > MAX_EDF_UTIL) or (laxity < ctx->tasks[ctx->running_task_id]->time_left))
 		and (loop_count < max_loop_count) )
 	{
 		/* report why we are here */
 		if(utility > MAX_EDF_UTIL)
 		{
-			MESS_OUT_message_1( (S8*)"OVERLOAD: utility = ", 
-			                     utility, MESSAGE_OP_VERBOSE );
+			MESS_OUT_VERBOSE( MESS_OUT_message_1( (S8*)"OVERLOAD: utility = ", 
+			                                       utility, MESSAGE_OP_VERBOSE ) );
 		}
 		else
 		{
-			MESS_OUT_message_2( (S8*)"OVERLOAD: task ", first_id, 
-				                (S8*)" laxity = ", laxity,
-				                MESSAGE_OP_VERBOSE );
+			MESS_OUT_VERBOSE( MESS_OUT_message_2( (S8*)"OVERLOAD: task ", first_id, 
+				                                  (S8*)" laxity = ", laxity,
+				                                  MESSAGE_OP_VERBOSE ) );
 		}
 
 		/* scheduler is in OVERLOAD */
 		/* ======================== */
 
 		/* identify active task with lowest priority */
-		lowest_priority = get_lowest_priority_active_task();
+		lowest_priority = get_lowest_priority_active_task( ctx );
 
-		(void)double_task_period( lowest_priority );
+		(void)double_task_period( ctx, lowest_priority );
 
 		/* en queue task in second list, doubled_periods, priority order */
-		q1_insert( lowest_priority, doubled_periods, ALG_RM );
+		q1_insert( ctx, lowest_priority, ctx->doubled_periods, Q_PRI );
 
 		/* get new utility */
-		new_utility = calculate_all_task_utilities();
+		new_utility = calculate_all_task_utilities( ctx );
 
-		MESS_OUT_message_2( (S8*)"Task set utility changed from ", utility,
-			                (S8*)" to ", new_utility,
-			                MESSAGE_OP_VERBOSE );
+		MESS_OUT_VERBOSE( MESS_OUT_message_2( (S8*)"Task set utility changed from ", utility,
+			                                  (S8*)" to ", new_utility,
+			                                  MESSAGE_OP_VERBOSE ) );
 
 		/* set for next while loop */
 		utility = new_utility;
 
 		/* get laxity for task at front of ready queue */
-		laxity = calculate_laxity( first_id, timeval );
+		laxity = LAXITY(first_id, timeval);
 
 		loop_count++;
 
@@ -1250,14 +1800,16 @@ static void schedule_adapive_six_algorithm( const U32 timeval )
 
 	if( loop_count >= max_loop_count )
 	{
-		MESS_OUT_message( (S8*)"GIVING UP: INSUFFICIENT SPARE UTILITY\n", 
-		                  MESSAGE_OP_VERBOSE );
+		MESS_OUT_VERBOSE( MESS_OUT_message( (S8*)"GIVING UP: INSUFFICIENT SPARE UTILITY\n", 
+		                                    MESSAGE_OP_VERBOSE ) );
 	}
 
 	/* now perform normal EDF scheduling */
-	schedule_edf_algorithm();
+	schedule_edf_algorithm( ctx, timeval );
 }
+#endif
 
+#if SCH_ALG_BUILT(SCH_NUM_ADAP_07)
 /******************************************************************************
 *  Description : private helper implements adaptive design #7.
 *                Features:
@@ -1266,12 +1818,13 @@ static void schedule_adapive_six_algorithm( const U32 timeval )
 *                - progressive doubling of tasks  
 *                - loop counter to prevent lock-up
 ******************************************************************************/
-static void schedule_adapive_seven_algorithm( const U32 timeval )
+static void schedule_adapive_seven_algorithm( struct sim_context_type *ctx, const U32 timeval )
 {
 	const U8 max_loop_count = 10;
-	U8  first_id;
-	U8  candidate_task = ZERO_CPV;
-	U32 laxity;
+#if MESS_OUT_LEVEL >= MESS_OUT_LEVEL_VERBOSE
+	task_id_type first_id;
+#endif
+	task_id_type candidate_task = ZERO_CPV;
 	U32 utility;
 	U32 new_utility;
 	U16 time_frigg     = 906;
@@ -1280,23 +1833,23 @@ static void schedule_adapive_seven_algorithm( const U32 timeval )
 	U8  loop_count;
 
 	/* set up a timed forced fault event */
-	if( (timeval is time_frigg)and(test_num is 57) )
+	if( (timeval is time_frigg)and(ctx->test_num is 57) )
 	{
-	    MESS_OUT_message_1( (S8*)"Running task duration incremented by ", 
-	                        task_frigg_1, 
-	                        MESSAGE_OP_VERBOSE );
+	    MESS_OUT_VERBOSE( MESS_OUT_message_1( (S8*)"Running task duration incremented by ", 
+	                                          task_frigg_1, 
+	                                          MESSAGE_OP_VERBOSE ) );
 
 		/* mangle task parameter */
-		tasks[running_task_id]->time_taken += task_frigg_1;
+		ctx->tasks[ctx->running_task_id]->time_taken += task_frigg_1;
 	}
-	else if( (timeval is time_frigg)and(test_num is 60) )
+	else if( (timeval is time_frigg)and(ctx->test_num is 60) )
 	{
-		MESS_OUT_message_1( (S8*)"Running task duration incremented by ", 
-		                    task_frigg_2, 
-		                    MESSAGE_OP_VERBOSE );
+		MESS_OUT_VERBOSE( MESS_OUT_message_1( (S8*)"Running task duration incremented by ", 
+		                                      task_frigg_2, 
+		                                      MESSAGE_OP_VERBOSE ) );
 
 		/* mangle task parameter */
-		tasks[running_task_id]->time_taken += task_frigg_2;
+		ctx->tasks[ctx->running_task_id]->time_taken += task_frigg_2;
 	}
 	else
 	{
@@ -1305,13 +1858,12 @@ static void schedule_adapive_seven_algorithm( const U32 timeval )
 
 
 	/* get task set utility */
-	utility = calculate_all_task_utilities();
+	utility = calculate_all_task_utilities( ctx );
 
+#if MESS_OUT_LEVEL >= MESS_OUT_LEVEL_VERBOSE
 	/* get index of first task in ready queue */
-	first_id = q_first_id( ZERO_CPV, ready_tasks );
-
-	/* get laxity for task at front of ready queue */
-	laxity = calculate_laxity( first_id, timeval );
+	first_id = q_first_id( ctx, ZERO_CPV, ctx->ready_tasks );
+#endif
 
 	loop_count = ZERO_CPV;
 	while( (utility > MAX_EDF_UTIL)and(loop_count < max_loop_count) )
@@ -1323,43 +1875,40 @@ static void schedule_adapive_seven_algorithm( const U32 timeval )
 		if(utility > MAX_EDF_UTIL)
 		{
 			/* overload due to utility */
-			MESS_OUT_message_1( (S8*)"OVERLOAD: utility = ", 
-			                    utility, 
-			                    MESSAGE_OP_VERBOSE );
+			MESS_OUT_VERBOSE( MESS_OUT_message_1( (S8*)"OVERLOAD: utility = ", 
+			                                      utility, 
+			                                      MESSAGE_OP_VERBOSE ) );
 		}
 		else
 		{
 			/* overload due to laxity */
-			MESS_OUT_message_2( (S8*)"OVERLOAD: task ", first_id,
-				                (S8*)" laxity = ", laxity,
-				                MESSAGE_OP_VERBOSE );
+			MESS_OUT_VERBOSE( MESS_OUT_message_2( (S8*)"OVERLOAD: task ", first_id,
+				                                  (S8*)" laxity = ", LAXITY(first_id, timeval),
+				                                  MESSAGE_OP_VERBOSE ) );
 		}
 
 		/* identify candidate task for period doubling */
-		candidate_task = get_active_task_priority();
+		candidate_task = get_active_task_priority( ctx );
 
 		/* remove task from doubled queue */
-		q1_extract( candidate_task, doubled_periods );
+		q1_extract( ctx, candidate_task, ctx->doubled_periods );
 
 		/* double the candidate task */
-		(void)double_task_period( candidate_task );
+		(void)double_task_period( ctx, candidate_task );
 
 		/* en queue task in second list, doubled_periods, e_priority order */
-		q1_insert( candidate_task, doubled_periods, ALG_ADAP_07 );
+		q1_insert( ctx, candidate_task, ctx->doubled_periods, Q_EPRI );
 
 		/* get new utility */
-		new_utility = calculate_all_task_utilities();
+		new_utility = calculate_all_task_utilities( ctx );
 
-		MESS_OUT_message_2( (S8*)"Task set utility changed from ", utility,
-			                (S8*)" to ", new_utility, 
-			                MESSAGE_OP_VERBOSE );
+		MESS_OUT_VERBOSE( MESS_OUT_message_2( (S8*)"Task set utility changed from ", utility,
+			                                  (S8*)" to ", new_utility, 
+			                                  MESSAGE_OP_VERBOSE ) );
 
 		/* set for next while loop */
 		utility = new_utility;
 
-		/* get laxity for task at front of ready queue */
-		laxity = calculate_laxity( first_id, timeval );
-
 		loop_count++;
 
 	} /* end while loop */
@@ -1371,101 +1920,110 @@ static void schedule_adapive_seven_algorithm( const U32 timeval )
 	}
 
 	/* ok, now we perform normal EDF scheduling */
-	schedule_edf_algorithm();
+	schedule_edf_algorithm( ctx, timeval );
 }
+#endif
 
+#if SCH_ALG_BUILT(SCH_NUM_RR)
 /******************************************************************************
 *  Description : private helper implements round robin algorithm
 ******************************************************************************/
-static void schedule_rr_algorithm( void )
+static void schedule_rr_algorithm( struct sim_context_type *ctx, const U32 timeval )
 {
 
 
 } 
+#endif
 
+#if SCH_ALG_BUILT(SCH_NUM_CYC)
 /******************************************************************************
 *  Description : private helper implements cyclic executive algorithm
 ******************************************************************************/
-static void schedule_cyc_algorithm( void )
+static void schedule_cyc_algorithm( struct sim_context_type *ctx, const U32 timeval )
 {
 
 
 } 
+#endif
 
+#if SCH_ALG_BUILT(SCH_NUM_RM)
 /******************************************************************************
 *  Description : private helper compares running task with first ready task
 *                and preempts if algorithm permits using priority algorithm
 *  Notes       : Adapted from code in Buttazzo's book (Buttazzo 2005)
 ******************************************************************************/
-static void schedule_rm_algorithm( void )
+static void schedule_rm_algorithm( struct sim_context_type *ctx, const U32 timeval )
 {
-    U8 first_id;
+    task_id_type first_id;
 
     /* get index of first task in ready queue */
-    first_id = q_first_id( ZERO_CPV, ready_tasks );
+    first_id = q_first_id( ctx, ZERO_CPV, ctx->ready_tasks );
 
     if(
-          (tasks[first_id]->priority < tasks[running_task_id]->priority)
+          (ctx->tasks[first_id]->priority < ctx->tasks[ctx->running_task_id]->priority)
           or /* OR there are no running tasks */
-          (running_task_id is ZERO_CPV)
+          (ctx->running_task_id is ZERO_CPV)
       )
     {
         /* why are we here ? */
-        if( running_task_id is_not ZERO_CPV )
+        if( ctx->running_task_id is_not ZERO_CPV )
         {
-            MESS_OUT_message_4( (S8*)"RM: running task #",
-                            running_task_id,
-                           (S8*)" priority = ",
-                           tasks[running_task_id]->priority,
-                           (S8*)" - next task #",
-                            first_id,
-                           (S8*)" priority = ",
-                            tasks[first_id]->priority, 
-                            MESSAGE_OP_VERBOSE );
+            MESS_OUT_VERBOSE( MESS_OUT_message_4( (S8*)"RM: running task #",
+                                              ctx->running_task_id,
+                                             (S8*)" priority = ",
+                                             ctx->tasks[ctx->running_task_id]->priority,
+                                             (S8*)" - next task #",
+                                              first_id,
+                                             (S8*)" priority = ",
+                                              ctx->tasks[first_id]->priority, 
+                                              MESSAGE_OP_VERBOSE ) );
         }
         else
         {
-            MESS_OUT_message( (S8*)"RM: No running task", 
-                              MESSAGE_OP_VERBOSE );
+            MESS_OUT_VERBOSE( MESS_OUT_message( (S8*)"RM: No running task", 
+                                                MESSAGE_OP_VERBOSE ) );
         }
 
         /* pre-empt task, if there is a running task */
-        if( running_task_id > ZERO_CPV )
+        if( ctx->running_task_id > ZERO_CPV )
         {
-            preempt_task( running_task_id );  /* pre-empt running task */
+            preempt_task( ctx, ctx->running_task_id ); /* pre-empt running task */
         }
 
         /* dispatch next task in ready queue */
-        dispatch_next_task();                 /* dispatch new task     */
+        dispatch_next_task( ctx );            /* dispatch new task     */
     }
 }
+#endif
 
+#if SCH_ALG_BUILT(SCH_NUM_DRM)
 /******************************************************************************
 *  Description : private helper user the delayed rate monotonic scheduling
 *                algorithm as described by Naghibzadeh (2002)
-*  Parameters  : Tasks are delayed by (T - c). In other words, all laxity
+*  Parameters  : ctx     - simulation context
+*                Tasks are delayed by (T - c). In other words, all laxity
 *                is removed.
 ******************************************************************************/
-static void schedule_drm_algorithm( const U32 timeval )
+static void schedule_drm_algorithm( struct sim_context_type *ctx, const U32 timeval )
 {
-    U8 first_id;
+    task_id_type first_id;
     U32 laxity;
 
     /* get index of first task in ready queue */
-    first_id = q_first_id( ZERO_CPV, ready_tasks );
+    first_id = q_first_id( ctx, ZERO_CPV, ctx->ready_tasks );
 
     /* get laxity of first task in queue */
-    laxity = calculate_laxity( first_id, timeval );
+    laxity = LAXITY(first_id, timeval);
 
 	/* if( laxity is 0) */
-	MESS_OUT_message_2( (S8*)"Laxity of task ",
-	                    first_id,
-	                    (S8*)" is ",
-	                    laxity, MESSAGE_OP_VERBOSE );
+	MESS_OUT_VERBOSE( MESS_OUT_message_2( (S8*)"Laxity of task ",
+	                                      first_id,
+	                                      (S8*)" is ",
+	                                      laxity, MESSAGE_OP_VERBOSE ) );
 
     if(
         (
-            ((tasks[first_id]->priority < tasks[running_task_id]->priority) or (running_task_id is ZERO_CPV))
+            ((ctx->tasks[first_id]->priority < ctx->tasks[ctx->running_task_id]->priority) or (ctx->running_task_id is ZERO_CPV))
             and /* the next task has no laxity */
             (laxity is ZERO_CPV )
         )
@@ -1474,46 +2032,51 @@ static void schedule_drm_algorithm( const U32 timeval )
       )
     {
         /* pre-empt task, if there is a running task */
-        if( running_task_id > ZERO_CPV )
+        if( ctx->running_task_id > ZERO_CPV )
         {
-            preempt_task( running_task_id );  /* pre-empt running task */
+            preempt_task( ctx, ctx->running_task_id ); /* pre-empt running task */
         }
 
         /* dispatch next task in ready queue */
-        dispatch_next_task();                 /* dispatch new task     */
+        dispatch_next_task( ctx );            /* dispatch new task     */
     }
 } 
+#endif
 
+#if SCH_ALG_BUILT(SCH_NUM_IRM)
 /******************************************************************************
 *  Description : private helper user the intelligent rate monotonic scheduling
 *                algorithm as described by Naghibzadeh and Fathi (2003)
-*  Parameters  : Tasks are delayed by (T - c). In other words, all laxity
+*  Parameters  : ctx     - simulation context
+*                Tasks are delayed by (T - c). In other words, all laxity
 *                is removed.
 ******************************************************************************/
-static void schedule_irm_algorithm( void )
+static void schedule_irm_algorithm( struct sim_context_type *ctx, const U32 timeval )
 {
-    U8 first_id;
+    task_id_type first_id;
 
     /* get index of first task in ready queue */
-    first_id = q_first_id( ZERO_CPV, ready_tasks );
+    first_id = q_first_id( ctx, ZERO_CPV, ctx->ready_tasks );
 
     if(
-          (tasks[first_id]->priority < tasks[running_task_id]->priority)
+          (ctx->tasks[first_id]->priority < ctx->tasks[ctx->running_task_id]->priority)
           or /* OR there are no running tasks */
-          (running_task_id is ZERO_CPV)
+          (ctx->running_task_id is ZERO_CPV)
       )
     {
         /* pre-empt task, if there is a running task */
-        if( running_task_id > ZERO_CPV )
+        if( ctx->running_task_id > ZERO_CPV )
         {
-            preempt_task( running_task_id );  /* pre-empt running task */
+            preempt_task( ctx, ctx->running_task_id ); /* pre-empt running task */
         }
 
         /* dispatch next task in ready queue */
-        dispatch_next_task();                 /* dispatch new task     */
+        dispatch_next_task( ctx );            /* dispatch new task     */
     }
 } 
+#endif
 
+#if SCH_ALG_BUILT(SCH_NUM_MUF)
 /******************************************************************************
 *  Description : private helper compares running task with first ready task
 *                and preempts if algorithm permits using priority algorithm
@@ -1521,278 +2084,292 @@ static void schedule_irm_algorithm( void )
 *                the Maximum Urgency First (MUF) algorithm
 *                (Stewart and Khosla 1991).
 ******************************************************************************/
-static void schedule_muf_algorithm( const U32 timeval )
+static void schedule_muf_algorithm( struct sim_context_type *ctx, const U32 timeval )
 {
-    U8 first_id;
-
-    calculate_all_laxities( timeval );        /* calculate the laxities */
-    calculate_all_muf_urgencies();            /* calculate the muf urgencies */
+    task_id_type first_id;
+    U32 first_urgency;
+    U32 running_urgency;
 
     /* get index of first task in ready queue */
-    first_id = q_first_id( ZERO_CPV, ready_tasks );
+    first_id = q_first_id( ctx, ZERO_CPV, ctx->ready_tasks );
+
+    first_urgency   = SCH_muf_urgency( ctx, first_id, LAXITY(first_id, timeval) );
+    running_urgency = SCH_muf_urgency( ctx, ctx->running_task_id,
+                                       LAXITY(ctx->running_task_id, timeval) );
 
     if(   /* next task muf urgency is less than running task muf urgency */
-          (MUF_URGENCY(first_id) > MUF_URGENCY(running_task_id))
+          (first_urgency > running_urgency)
           or /* OR there are no running tasks */
-          (running_task_id is ZERO_CPV)
+          (ctx->running_task_id is ZERO_CPV)
       )
     {
         /* why are we here ? */
-        if( running_task_id is_not ZERO_CPV )
+        if( ctx->running_task_id is_not ZERO_CPV )
         {
-            MESS_OUT_message_4( (S8*)"MUF: running task #",
-                            running_task_id,
-                           (S8*)" urgency = ",
-                           MUF_URGENCY(running_task_id),
-                           (S8*)" - next task #",
-                            first_id,
-                           (S8*)" urgency = ",
-                            MUF_URGENCY(first_id), 
-                            MESSAGE_OP_VERBOSE );
+            MESS_OUT_VERBOSE( MESS_OUT_message_4( (S8*)"MUF: running task #",
+                                              ctx->running_task_id,
+                                             (S8*)" urgency = ",
+                                             running_urgency,
+                                             (S8*)" - next task #",
+                                              first_id,
+                                             (S8*)" urgency = ",
+                                              first_urgency, 
+                                              MESSAGE_OP_VERBOSE ) );
         }
         else
         {
-            MESS_OUT_message( (S8*)"MUF: No running task", 
-                               MESSAGE_OP_VERBOSE );
+            MESS_OUT_VERBOSE( MESS_OUT_message( (S8*)"MUF: No running task", 
+                                                 MESSAGE_OP_VERBOSE ) );
         }
 
         /* pre-empt task, if there is a running task */
-        if( running_task_id > ZERO_CPV )
+        if( ctx->running_task_id > ZERO_CPV )
         {
             /* report task replacement */
-            MESS_OUT_message_1( (S8*)"Laxity Zero: removing task ", 
-                                running_task_id, 
-                                MESSAGE_OP_VERBOSE );
+            MESS_OUT_VERBOSE( MESS_OUT_message_1( (S8*)"Laxity Zero: removing task ", 
+                                                  ctx->running_task_id, 
+                                                  MESSAGE_OP_VERBOSE ) );
 
-            preempt_task( running_task_id );  /* pre-empt running task */
+            preempt_task( ctx, ctx->running_task_id ); /* pre-empt running task */
         }
-        dispatch_next_task();                 /* dispatch new task     */
+        dispatch_next_task( ctx );            /* dispatch new task     */
     }
 }
+#endif
 
 
+#if SCH_ALG_BUILT(SCH_NUM_MMUF)
 /******************************************************************************
 *  Description : private helper compares running task with first ready task
 *                and preempts if algorithm permits using a modified muf
 *                algorithm
 *  Notes       : Adapted from code in Buttazzo's book (Buttazzo 2005)
 ******************************************************************************/
-static void schedule_mmuf_algorithm( const U32 timeval )
+static void schedule_mmuf_algorithm( struct sim_context_type *ctx, const U32 timeval )
 {
     U32 laxity;
-    U8 first_id;
+    task_id_type first_id;
 
-    calculate_all_laxities( timeval );        /* calculate the laxities      */
-    calculate_all_muf_urgencies();            /* calculate the muf urgencies */
-
-    first_id = q_first_id(ZERO_CPV, ready_tasks);
-    laxity = tasks[first_id]->laxity;
+    first_id = q_first_id( ctx, ZERO_CPV, ctx->ready_tasks);
+    laxity = LAXITY(first_id, timeval);
 
     if(      /* next task laxity = zero */
           ( laxity is ZERO_CPV )
           or /* OR there are no running tasks */
-          ( running_task_id is ZERO_CPV )
+          ( ctx->running_task_id is ZERO_CPV )
       )
     {
         /* why are we here ? */
-        if( running_task_id is_not ZERO_CPV )
+        if( ctx->running_task_id is_not ZERO_CPV )
         {
-            MESS_OUT_message_2( (S8*)"MMUF: running task #",
-                                running_task_id,
-                                (S8*)" laxity = ",
-                                laxity, 
-                                MESSAGE_OP_VERBOSE );
+            MESS_OUT_VERBOSE( MESS_OUT_message_2( (S8*)"MMUF: running task #",
+                                                  ctx->running_task_id,
+                                                  (S8*)" laxity = ",
+                                                  laxity, 
+                                                  MESSAGE_OP_VERBOSE ) );
         }
         else
         {
-            MESS_OUT_message( (S8*)"MMUF: No running task", 
-                               MESSAGE_OP_VERBOSE );
+            MESS_OUT_VERBOSE( MESS_OUT_message( (S8*)"MMUF: No running task", 
+                                                 MESSAGE_OP_VERBOSE ) );
         }
         /* pre-empt task, if there is a running task */
-        if( running_task_id > ZERO_CPV )
+        if( ctx->running_task_id > ZERO_CPV )
         {
             /* report task replacement */
-            MESS_OUT_message_1( (S8*)"Laxity Zero: removing task ", running_task_id, MESSAGE_OP_VERBOSE );
+            MESS_OUT_VERBOSE( MESS_OUT_message_1( (S8*)"Laxity Zero: removing task ", ctx->running_task_id, MESSAGE_OP_VERBOSE ) );
 
-            preempt_task( running_task_id );  /* pre-empt running task */
+            preempt_task( ctx, ctx->running_task_id ); /* pre-empt running task */
         }
 
-        dispatch_next_task();                 /* dispatch next task    */
+        dispatch_next_task( ctx );            /* dispatch next task    */
     }
 } 
+#endif
 
+#if SCH_ALG_BUILT(SCH_NUM_MMMUF)
 /******************************************************************************
 *  Description : private helper compares running task with first ready task
 *                and preempts if algorithm permits using a modified muf
 *                algorithm
 *  Notes       : Adapted from code in Buttazzo's book (Buttazzo 2005)
 ******************************************************************************/
-static void schedule_mmmuf_algorithm( const U32 timeval )
+static void schedule_mmmuf_algorithm( struct sim_context_type *ctx, const U32 timeval )
 {
-    U8 first_id;
+    task_id_type first_id;
 
-    calculate_all_laxities( timeval );        /* calculate the laxities      */
-    calculate_all_muf_urgencies();            /* calculate the muf urgencies */
-
-    first_id = q_first_id(ZERO_CPV, ready_tasks);
+    first_id = q_first_id( ctx, ZERO_CPV, ctx->ready_tasks);
 
     if(   /* next task laxity = zero */
-          ( tasks[first_id]->laxity is ZERO_CPV )
+          ( LAXITY(first_id, timeval) is ZERO_CPV )
           or /* OR next task muf urgency is less than running task muf urgency */
           (
-			  (MUF_CRITICAL(running_task_id) is ZERO_CPV)
+			  (MUF_CRITICAL(ctx->running_task_id) is ZERO_CPV)
               and
-              (MUF_URGENCY(first_id) > MUF_URGENCY(running_task_id))
+              (   SCH_muf_urgency( ctx, first_id, LAXITY(first_id, timeval) )
+                > SCH_muf_urgency( ctx, ctx->running_task_id,
+                                   LAXITY(ctx->running_task_id, timeval) ) )
           )
           or /* OR there are no running tasks */
-          ( running_task_id is ZERO_CPV )
+          ( ctx->running_task_id is ZERO_CPV )
       )
     {
         /* pre-empt task, if there is a running task */
-        if( running_task_id > ZERO_CPV )
+        if( ctx->running_task_id > ZERO_CPV )
         {
             /* report task replacement */
-            MESS_OUT_message_1( (S8*)"Laxity Zero: removing task ", 
-                                running_task_id, 
-                                MESSAGE_OP_VERBOSE );
+            MESS_OUT_VERBOSE( MESS_OUT_message_1( (S8*)"Laxity Zero: removing task ", 
+                                                  ctx->running_task_id, 
+                                                  MESSAGE_OP_VERBOSE ) );
 
-            preempt_task( running_task_id );  /* pre-empt running task */
+            preempt_task( ctx, ctx->running_task_id ); /* pre-empt running task */
         }
 
-        dispatch_next_task();                 /* dispatch next task    */
+        dispatch_next_task( ctx );            /* dispatch next task    */
     }
 }
+#endif
 
+#if SCH_EDF_ALGORITHMS
 /******************************************************************************
 *  Description : private helper compares running task with first ready task
 *                and preempts if algorithm permits using priority algorithm
 *  Notes       : Adapted from code in Buttazzo's book (Buttazzo 2005)
 ******************************************************************************/
-static void schedule_edf_algorithm( void )
+static void schedule_edf_algorithm( struct sim_context_type *ctx, const U32 timeval )
 {
-    U8 first_id;
+    task_id_type first_id;
 
     /* get index of first task in ready queue */
-    first_id  = q_first_id( ZERO_CPV, ready_tasks );
+    first_id  = q_first_id( ctx, ZERO_CPV, ctx->ready_tasks );
 
     if(    /* next task in queue has a deadline before the running task */
-          ( tasks[first_id]->abs_dline < tasks[running_task_id]->abs_dline )
+          ( ctx->tasks[first_id]->abs_dline < ctx->tasks[ctx->running_task_id]->abs_dline )
           or /* OR there are no running tasks */
-          (running_task_id is ZERO_CPV)
+          (ctx->running_task_id is ZERO_CPV)
       )
     {
         /* why are we here ? */
-        if( running_task_id is_not ZERO_CPV )
+        if( ctx->running_task_id is_not ZERO_CPV )
         {
-            MESS_OUT_message_4( (S8*)"EDF: running task #",
-                            running_task_id,
-                           (S8*)" deadline = ",
-                           tasks[running_task_id]->abs_dline,
-                           (S8*)" - next task #",
-                            first_id,
-                           (S8*)" deadline = ",
-                            tasks[first_id]->abs_dline, 
-                            MESSAGE_OP_VERBOSE );
+            MESS_OUT_VERBOSE( MESS_OUT_message_4( (S8*)"EDF: running task #",
+                                              ctx->running_task_id,
+                                             (S8*)" deadline = ",
+                                             ctx->tasks[ctx->running_task_id]->abs_dline,
+                                             (S8*)" - next task #",
+                                              first_id,
+                                             (S8*)" deadline = ",
+                                              ctx->tasks[first_id]->abs_dline, 
+                                              MESSAGE_OP_VERBOSE ) );
         }
         else
         {
-            MESS_OUT_message( (S8*)"EDF: No running task", MESSAGE_OP_VERBOSE );
+            MESS_OUT_VERBOSE( MESS_OUT_message( (S8*)"EDF: No running task", MESSAGE_OP_VERBOSE ) );
         }
 
         /* pre-empt task, if there is a running task */
-        if( running_task_id > ZERO_CPV )
+        if( ctx->running_task_id > ZERO_CPV )
         {
-            preempt_task( running_task_id );  /* pre-empt running task */
+            preempt_task( ctx, ctx->running_task_id ); /* pre-empt running task */
         }
 
-        dispatch_next_task();                 /* dispatch new task     */
+        dispatch_next_task( ctx );            /* dispatch new task     */
     }
 } 
+#endif
 
+#if SCH_ALG_BUILT(SCH_NUM_SPT)
 /******************************************************************************
 *  Description : private helper compares running task with first ready task
 *                and preempts if algorithm permits using priority algorithm
 *  Notes       : Adapted from code in Buttazzo's book (Buttazzo 2005)
 ******************************************************************************/
-static void schedule_spt_algorithm( void )
+static void schedule_spt_algorithm( struct sim_context_type *ctx, const U32 timeval )
 {
-    U8 first_id;
+    task_id_type first_id;
 
     /* get index of first task in ready queue */
-    first_id  = q_first_id( ZERO_CPV, ready_tasks );
+    first_id  = q_first_id( ctx, ZERO_CPV, ctx->ready_tasks );
 
     if(
-          (tasks[first_id]->time_left < tasks[running_task_id]->time_left)
+          (ctx->tasks[first_id]->time_left < ctx->tasks[ctx->running_task_id]->time_left)
           or /* OR there are no running tasks */
-          (running_task_id is ZERO_CPV)
+          (ctx->running_task_id is ZERO_CPV)
       )
     {
         /* pre-empt task, if there is a running task */
-        if( running_task_id > ZERO_CPV )
+        if( ctx->running_task_id > ZERO_CPV )
         {
-            preempt_task( running_task_id );  /* pre-empt running task */
+            preempt_task( ctx, ctx->running_task_id ); /* pre-empt running task */
         }
-        dispatch_next_task();                 /* dispatch new task     */
+        dispatch_next_task( ctx );            /* dispatch new task     */
     }
 } 
+#endif
 
+#if SCH_ALG_BUILT(SCH_NUM_LLF)
 /******************************************************************************
 *  Description : private helper compares running task with first ready task
 *                and preempts if algorithm permits using algorithm
 *  Notes       : Adapted from Dertouzos and Mok's paper
 *                (Dertouzos and Mok 1989)
 ******************************************************************************/
-static void schedule_llf_algorithm( const U32 timeval )
+static void schedule_llf_algorithm( struct sim_context_type *ctx, const U32 timeval )
 {
-    U8 first_id;
-
-    calculate_all_laxities( timeval );         /* calculate the laxities */
+    task_id_type first_id;
 
     /* get index of first task in ready queue */
-    first_id = q_first_id( ZERO_CPV, ready_tasks );
+    first_id = q_first_id( ctx, ZERO_CPV, ctx->ready_tasks );
 
     if(
-          (tasks[first_id]->laxity < tasks[running_task_id]->laxity)
+          (LAXITY(first_id, timeval) < LAXITY(ctx->running_task_id, timeval))
           or
-          (running_task_id is ZERO_CPV)
+          (ctx->running_task_id is ZERO_CPV)
       )
     {
         /* pre-empt task, if there is a running task */
-        if( running_task_id > ZERO_CPV )
+        if( ctx->running_task_id > ZERO_CPV )
         {
-            preempt_task( running_task_id );  /* pre-empt running task */
+            preempt_task( ctx, ctx->running_task_id ); /* pre-empt running task */
         }
-        dispatch_next_task();                 /* dispatch new task     */
+        dispatch_next_task( ctx );            /* dispatch new task     */
     }
 } 
+#endif
 
 
+#if SCH_ALG_BUILT(SCH_NUM_MLLF)
 /******************************************************************************
 *  Description : private helper compares running task with first ready task
 *                and preempts if algorithm permits using algorithm
 *  Notes       : Adapted from Sung-Heun Oh and Seung-Min Yang's paper
 *                (Oh and Yang 1998)
 ******************************************************************************/
-static void schedule_mllf_algorithm( const U32 timeval )
+static void schedule_mllf_algorithm( struct sim_context_type *ctx, const U32 timeval )
 {
-    calculate_all_laxities( timeval );         /* calculate the laxities */
+    task_id_type first_id;
+
+    /* get index of first task in ready queue */
+    first_id = q_first_id( ctx, ZERO_CPV, ctx->ready_tasks );
 
     if(
-          ( tasks[ q_first_id(ZERO_CPV, ready_tasks) ]->laxity is ZERO_CPV )
+          ( LAXITY(first_id, timeval) is ZERO_CPV )
           or
-          ( running_task_id is ZERO_CPV )
+          ( ctx->running_task_id is ZERO_CPV )
       )
     {
         /* pre-empt task, if there is a running task */
-        if( running_task_id > ZERO_CPV )
+        if( ctx->running_task_id > ZERO_CPV )
         {
-            preempt_task( running_task_id );  /* pre-empt running task */
+            preempt_task( ctx, ctx->running_task_id ); /* pre-empt running task */
         }
-        dispatch_next_task();                 /* dispatch new task     */
+        dispatch_next_task( ctx );            /* dispatch new task     */
     }
 } 
+#endif
 
 
+#if SCH_ALG_BUILT(SCH_NUM_EDF_RTO)
 /******************************************************************************
 *  Description : private helper compares running task with first ready task
 *                and preempts if algorithm permits using skip algorithm.
@@ -1801,65 +2378,66 @@ static void schedule_mllf_algorithm( const U32 timeval )
 *  Notes       : Based on the Red Task Only Skip-Over algorithm in paper
 *                by Koren and Shasha (1995).
 ******************************************************************************/
-static void schedule_skip_rto_algorithm( const U32 timeval )
+static void schedule_skip_rto_algorithm( struct sim_context_type *ctx, const U32 timeval )
 {
-    U8 first_id;
-    U8 second_id;
+    task_id_type first_id;
+    task_id_type second_id;
 
     /* get index of first task in ready queue */
-    first_id  = q_first_id(  ZERO_CPV, ready_tasks );
-    second_id = q_second_id( ZERO_CPV, ready_tasks );
+    first_id  = q_first_id( ctx, ZERO_CPV, ctx->ready_tasks );
+    second_id = q_second_id( ctx, ZERO_CPV, ctx->ready_tasks );
 
 
-    if( running_task_id is ZERO_CPV)
+    if( ctx->running_task_id is ZERO_CPV)
     {
 
-        if( task_skippable(first_id) )
+        if( task_skippable( ctx, first_id) )
         {
-            if( can_meet_deadline(first_id, timeval) )
+            if( can_meet_deadline( ctx, first_id, timeval) )
             {
-                if( can_meet_deadline(second_id, timeval) )
+                if( can_meet_deadline( ctx, second_id, timeval) )
                 {
                     /* dispatch the next task in the ready queue */
-                    dispatch_next_task();
+                    dispatch_next_task( ctx );
                 }
                 else
                 {
                     /* skip ready task */
-                    skip_first_task( timeval );
+                    skip_first_task( ctx, timeval );
 
                     /* dispatch the next task in the ready queue */
-                    dispatch_next_task();
+                    dispatch_next_task( ctx );
                 }
             }
             else
             {
                 /* skip ready task */
-                skip_first_task( timeval );
+                skip_first_task( ctx, timeval );
 
                 /* dispatch the next task in the ready queue */
-                dispatch_next_task();
+                dispatch_next_task( ctx );
             }
         }
         else
         {
             /* do nothing - dispatch anyway */
-            dispatch_next_task();
+            dispatch_next_task( ctx );
         }
     }
     else if(
-            ( tasks[first_id]->abs_dline < tasks[running_task_id]->abs_dline )
+            ( ctx->tasks[first_id]->abs_dline < ctx->tasks[ctx->running_task_id]->abs_dline )
             and /* AND only if this task will complete */
-            ( tasks[first_id]->time_left < tasks[running_task_id]->laxity)
+            ( ctx->tasks[first_id]->time_left < LAXITY(ctx->running_task_id, timeval))
            )
     {
-        preempt_task( running_task_id );  /* pre-empt running task */
+        preempt_task( ctx, ctx->running_task_id ); /* pre-empt running task */
     }
     else
     {
         /* do nothing */
     }
 } 
+#endif
 
 #if(0)
 /******************************************************************************
@@ -1884,10 +2462,11 @@ static void schedule_skip_rto_algorithm( const U32 timeval )
 *                      endwhile
 *                  endfor
 *
-*  Parameters  : timeval - system time
+*  Parameters  : ctx     - simulation context
+*                timeval - system time
 *  Returns     : TRUE if the task is schedulable
 ******************************************************************************/
-static boolean dm_schedulable( const U32 timeval )
+static boolean dm_schedulable( struct sim_context_type *ctx, const U32 timeval )
 {
     boolean schedulable = FALSE;
 
@@ -1897,214 +2476,328 @@ static boolean dm_schedulable( const U32 timeval )
 #endif
 
 
+/******************************************************************************
+*  Description : private helper - dispatch function of the algorithms that
+*                are not implemented yet
+******************************************************************************/
+static void schedule_unsupported_algorithm( struct sim_context_type *ctx, const U32 timeval )
+{
+    /* do nothing */
+    MESS_OUT_message( (S8*)"default switch in process_ready_tasks()\n", 
+                      MESSAGE_OP_ERROR );
+}
+
 #if(0)
 /******************************************************************************
 *  Description : private helper compares running task with first ready task
 *                and preempts if algorithm permits using D* algorithm
 ******************************************************************************/
-static void schedule_d_star_algorithm( const U32 timeval )
+static void schedule_d_star_algorithm( struct sim_context_type *ctx, const U32 timeval )
 {
 }
 #endif
 
+#if SCH_DISPATCH_ALGORITHMS
 /******************************************************************************
 *  Description : private helper preempts task, transferring it to the
 *                ready queue
 *  Notes       : Adapted from code in Buttazzo's book (Buttazzo 2005)
 ******************************************************************************/
-static void preempt_task( const U8 task )
+static void preempt_task( struct sim_context_type *ctx, const task_id_type task )
 {
     /* report task replacement */
-    MESS_OUT_message_1( (S8*)"Pre-empting task ", task, MESSAGE_OP_VERBOSE );
+    MESS_OUT_VERBOSE( MESS_OUT_message_1( (S8*)"Pre-empting task ", task, MESSAGE_OP_VERBOSE ) );
 
-    tasks[task]->state = TSK_PREMPT;            /* set state to pre-empted   */
-    tasks[task]->pre_count++;                   /* increment pre-empt counts */
-    TST_incr_test_report_value( TST_PREEMPTS ); /* increment pre-empt counts */
-    q0_insert( task, ready_tasks, algorithm );  /* put it into ready queue   */
+    ctx->tasks[task]->state = TSK_PREMPT;       /* set state to pre-empted   */
+    ctx->tasks[task]->pre_count++;              /* increment pre-empt counts */
+    TST_incr_test_report_value( ctx, TST_PREEMPTS ); /* increment pre-empt counts */
+    q0_insert( ctx, task, ctx->ready_tasks, POLICY(ctx)->ready_order ); /* put it into ready queue   */
 
     /* if in adaptive algorithm 05 then we are using laxity to */
     /* detect overload. */
-    if( (algorithm is ALG_ADAP_05) or (algorithm is ALG_ADAP_06) )
+    if( POLICY(ctx)->lst_queue is TRUE )
     {
-        q2_insert( task, lst_tasks, ALG_LLF );
+        q2_insert( ctx, task, ctx->lst_tasks, Q_LLF );
     }
 
-    running_task_id = 0;                        /* clear running task ID     */
+    ctx->running_task_id = 0;                   /* clear running task ID     */
 }
+#endif
 
+#if SCH_DISPATCH_ALGORITHMS
 /******************************************************************************
 *  Description : private helper dispatched q0_next task in ready queue
 *                updates the tasks[] array
 *  Notes       : Adapted from code in Buttazzo's book (Buttazzo 2005)
 ******************************************************************************/
-static void dispatch_next_task( void )
+static void dispatch_next_task( struct sim_context_type *ctx )
 {
     /* dispatch new task */
-    running_task_id = q_extract_first( ready_tasks );
+    ctx->running_task_id = q_extract_first( ctx, ctx->ready_tasks );
 
-    if( (algorithm is ALG_ADAP_05) or (algorithm is ALG_ADAP_06) )
+    if( POLICY(ctx)->lst_queue is TRUE )
     {
-        q2_extract( running_task_id, lst_tasks );
+        q2_extract( ctx, ctx->running_task_id, ctx->lst_tasks );
     }
 
-    if( running_task_id > ZERO_CPV )
+    if( ctx->running_task_id > ZERO_CPV )
     {
         /* set state of new running task */
-        tasks[running_task_id]->state = TSK_RUN;
+        ctx->tasks[ctx->running_task_id]->state = TSK_RUN;
 
         /* decrement non skipped count */
-        decrement_not_skipped_count( running_task_id );
+        decrement_not_skipped_count( ctx, ctx->running_task_id );
     }
 } 
+#endif
 
+#if SCH_ALG_BUILT(SCH_NUM_EDF_RTO)
 /******************************************************************************
 *  Description : private helper skips first ready task by transferring it from
 *                front of ready queue to skipped queue
 *  Notes       : Based on the "Skip-Over" paper by Koren and Shasha (1995).
 ******************************************************************************/
-static void skip_first_task( const U32 timeval )
+static void skip_first_task( struct sim_context_type *ctx, const U32 timeval )
 {
-    U8 id;
+    task_id_type id;
 
     /* extract task from ready queue, keeping its id */
-    id = q_extract_first( ready_tasks );
+    id = q_extract_first( ctx, ctx->ready_tasks );
 
     /* report task replacement */
-    MESS_OUT_message_1( (S8*)"Skipping task ", id, MESSAGE_OP_VERBOSE );
+    MESS_OUT_VERBOSE( MESS_OUT_message_1( (S8*)"Skipping task ", id, MESSAGE_OP_VERBOSE ) );
 
     /* put task in skipped queue */
-    q0_insert( id, skipped_tasks, algorithm );
+    q0_insert( ctx, id, ctx->skipped_tasks, POLICY(ctx)->ready_order );
 
     /* set state to skipped */
-    tasks[id]->state = TSK_SKIPPED;
+    ctx->tasks[id]->state = TSK_SKIPPED;
 
     /* reset not skipped count */
     NOT_SKIPPED(id) = (U8)SKIP_GAP(id);
+    update_utility_share( ctx, id );
 
     /* how long to skip - set abs_dline to hold task in skip queue */
-    if( tasks[id]->abs_dline <= timeval )
+    if( ctx->tasks[id]->abs_dline <= timeval )
     {
-        tasks[id]->abs_dline = timeval + tasks[id]->rel_dline;
+        ctx->tasks[id]->abs_dline = timeval + ctx->tasks[id]->rel_dline;
     }
 
     /* increment skip count */
     TOTAL_SKIPS(id)++;
 } 
+#endif
 
 /* queue utility functions */
 
+/******************************************************************************
+*  Description : private helper links task into queue 0 in q_order, as a
+*                heap or a list.
+*  Parameters  : ctx     - simulation context
+*                pointer to task
+*                pointer to queue
+******************************************************************************/
+static void q0_insert( struct sim_context_type *ctx, const task_id_type task,
+                       struct task_type *header,
+                       const q_order_type q_order )
+{
+    struct task_q_type *q;
+    struct task_wheel_type *w;
+
+    SCH_COUNT_INSERT( ctx, header );
+
+    q = q0_heap( ctx, header );
+    w = q0_wheel( ctx, header );
+
+    if( q is_not NULL )
+    {
+        QUTIL_heap_insert( ctx, q, task, q_order );
+    }
+    else if( w is_not NULL )
+    {
+        /* wheel releases in deadline order whatever the algorithm */
+        QUTIL_wheel_insert( ctx, w, task );
+    }
+    else
+    {
+        q0_list_insert( ctx, task, header, q_order );
+    }
+} 
+
+/******************************************************************************
+*  Description : private helper returns the heap behind a queue 0 header, or
+*                NULL if the queue is a linked list
+*  Parameters  : ctx     - simulation context
+*                pointer to queue
+******************************************************************************/
+static struct task_q_type *q0_heap( struct sim_context_type *ctx, const struct task_type *header )
+{
+    struct task_q_type *q = NULL;
+
+    if( (header is ctx->ready_tasks) and (ctx->ready_q.q_kind is Q_HEAP) )
+    {
+        q = &ctx->ready_q;
+    }
+
+    return( q );
+} 
+
+/******************************************************************************
+*  Description : private helper returns the timing wheel behind a queue 0
+*                header, or NULL if the queue is a linked list
+*  Parameters  : ctx     - simulation context
+*                pointer to queue
+******************************************************************************/
+static struct task_wheel_type *q0_wheel( struct sim_context_type *ctx, const struct task_type *header )
+{
+    struct task_wheel_type *w = NULL;
+
+    if( (header is ctx->idle_tasks) and (ctx->idle_wheel.q_kind is Q_WHEEL) )
+    {
+        w = &ctx->idle_wheel;
+    }
+    else if( (header is ctx->waiting_tasks) and (ctx->waiting_wheel.q_kind is Q_WHEEL) )
+    {
+        w = &ctx->waiting_wheel;
+    }
+    else
+    {
+        /* list queue */
+    }
+
+    return( w );
+} 
+
+/******************************************************************************
+*  Description : private helper sets the ready queue to the kind selected,
+*                a list where the policy of the algorithm keeps one
+*  Parameters  : ctx     - simulation context
+******************************************************************************/
+static void set_ready_q_kind( struct sim_context_type *ctx )
+{
+    if( (ctx->ready_q_kind is Q_HEAP) and (POLICY(ctx)->heap is FALSE) )
+    {
+        ctx->ready_q.q_kind = Q_LIST;
+    }
+    else
+    {
+        ctx->ready_q.q_kind = ctx->ready_q_kind;
+    }
+} 
+
+#if SCH_DOUBLING_ALGORITHMS
+/******************************************************************************
+*  Description : private helper called after the key of a task changes. A
+*                heap queue is re-ordered; a list queue keeps its order.
+*  Parameters  : ctx     - simulation context
+*                task number
+******************************************************************************/
+static void q0_key_changed( struct sim_context_type *ctx, const task_id_type task )
+{
+    if( ctx->ready_q.q_kind is Q_HEAP )
+    {
+        QUTIL_heap_update( ctx, &ctx->ready_q, task );
+    }
+} 
+#endif
+
 /******************************************************************************
 *  Description : private helper links task into head of task list
 *                according to scheduler algorithm.
 *  Notes       : Adapted from code in Buttazzo's book (Buttazzo 2005)
-*  Parameters  : pointer to task
+*  Parameters  : ctx     - simulation context
+*                pointer to task
 *                pointer to queue
 ******************************************************************************/
-static void q0_insert( const U8 task,
-                       struct task_type *header,
-                       const algorithm_type scheduling_algorithm )
+static void q0_list_insert( struct sim_context_type *ctx, const task_id_type task,
+                            struct task_type *header,
+                            const q_order_type q_order )
 {
-    U8  prev;      /* pointer to previous task */
-    U8  next;      /* pointer to next task     */
+    task_id_type prev; /* pointer to previous task */
+    task_id_type next; /* pointer to next task     */
 
-	MESS_OUT_message( (S8*)"q0_insert() called", MESSAGE_OP_DEBUG );
+	MESS_OUT_DEBUG( MESS_OUT_message( (S8*)"q0_insert() called", MESSAGE_OP_DEBUG ) );
 
     /* initialise auxiliary pointers */
     prev = ZERO_CPV;
     next = header->q0_next;
 
-    switch ( scheduling_algorithm )
+    switch ( q_order )
     {
-        case ALG_RM:
-        case ALG_DRM:
+        case Q_PRI:
             /* Priority scheduling: insert in priority order */
             while(
                      ( next is_not ZERO_CPV )
                      and
-                     ( tasks[task]->priority > tasks[next]->priority )
+                     ( ctx->tasks[task]->priority > ctx->tasks[next]->priority )
                  )
             {
                 prev = next;
-                next = tasks[next]->q0_next;
+                next = ctx->tasks[next]->q0_next;
             }
             break;
 
-        case ALG_MUF:
-        case ALG_MMUF:
-        case ALG_MMMUF:
+        case Q_MUF:
             /* MUF, MMUF & MMMUF: insert in muf urgency first order */
             while(
                      ( next is_not ZERO_CPV )
                       and
-                     ( MUF_URGENCY(task) < MUF_URGENCY(next) )
+                     ( SCH_muf_urgency( ctx, task, LAXITY(task, ctx->timeval) )
+                       <
+                       SCH_muf_urgency( ctx, next, LAXITY(next, ctx->timeval) ) )
                  )
             {
                 prev = next;
-                next = tasks[next]->q0_next;
+                next = ctx->tasks[next]->q0_next;
             }
             break;
 
-        case ALG_SPT:
+        case Q_SPT:
             /* SPT queue in shortest processing time order */
             while(
                      ( next is_not 0 )
                       and
-                     ( tasks[task]->time_left >= tasks[next]->time_left )
+                     ( ctx->tasks[task]->time_left >= ctx->tasks[next]->time_left )
                  )
             {
                 prev = next;
-                next = tasks[next]->q0_next;
+                next = ctx->tasks[next]->q0_next;
             }
             break;
 
-        case ALG_ADAP_01:
-        case ALG_ADAP_02:
-        case ALG_ADAP_03:
-        case ALG_ADAP_04:
-        case ALG_ADAP_05:
-        case ALG_ADAP_06:
-        case ALG_ADAP_07:
-        case ALG_EDF_RTO:
-        case ALG_EDF:
+        case Q_EDF:
             /* EDF: insert in deadline first order */
             while(
                      ( next is_not ZERO_CPV )
                       and
-                     ( tasks[task]->abs_dline >= tasks[next]->abs_dline )
+                     ( ctx->tasks[task]->abs_dline >= ctx->tasks[next]->abs_dline )
                  )
             {
                 prev = next;
-                next = tasks[next]->q0_next;
+                next = ctx->tasks[next]->q0_next;
             }
             break;
 
-        case ALG_LLF:
-        case ALG_MLLF:
+        case Q_LLF:
             /* LLF: insert in least laxity order */
             while(
                      ( next is_not ZERO_CPV )
                      and
-                     ( tasks[task]->laxity > tasks[next]->laxity )
+                     ( LAXITY(task, ctx->timeval) > LAXITY(next, ctx->timeval) )
                  )
             {
                 prev = next;
-                next = tasks[next]->q0_next;
+                next = ctx->tasks[next]->q0_next;
             }
             break;
 
-        case ALG_IRM:
-        case ALG_D_STAR:
-        case ALG_DD_STAR:
-        case ALG_D_OVER:
-        case ALG_CYC:
-        case ALG_RR:
-        case ALG_RM_RTO:
-        case ALG_EDF_BWP:
-        case ALG_MAX_ALG:
+        case Q_EPRI:
+        case Q_NONE:
+        case Q_MAX:
         default:
             /* do nothing */
 			MESS_OUT_message_1(  (S8*)"q0_insert() default switch with ",
-                                 (U32)scheduling_algorithm,
+                                 (U32)q_order,
 			                     MESSAGE_OP_ERROR );
             break;
     }
@@ -2113,7 +2806,7 @@ static void q0_insert( const U8 task,
     if( prev is_not ZERO_CPV )
     {
         /* not at start */
-        tasks[prev]->q0_next = task;
+        ctx->tasks[prev]->q0_next = task;
     }
     else
     {
@@ -2124,105 +2817,91 @@ static void q0_insert( const U8 task,
     if( next is_not ZERO_CPV )
     {
         /* not at end */
-        tasks[next]->q0_prev = task;
+        ctx->tasks[next]->q0_prev = task;
     }
 
     /* set new ready task pointers */
-    tasks[task]->q0_next = next;
-    tasks[task]->q0_prev = prev;
+    ctx->tasks[task]->q0_next = next;
+    ctx->tasks[task]->q0_prev = prev;
 } 
 
+#if SCH_DOUBLED_QUEUE
 /******************************************************************************
 *  Description : private helper links task into head of task list
 *                according to scheduler algorithm
 *  Notes       : Adapted from code in Buttazzo's book (Buttazzo 2005)
-*  Parameters  : pointer to task
+*  Parameters  : ctx     - simulation context
+*                pointer to task
 *                pointer to queue
 *                algorithm to select
 ******************************************************************************/
-static void q1_insert( const U8 task,
+static void q1_insert( struct sim_context_type *ctx, const task_id_type task,
                        struct task_type *header,
-                       const algorithm_type scheduling_algorithm )
+                       const q_order_type q_order )
 {
-    U8  prev;      /* pointer to previous task */
-    U8  next;      /* pointer to next task     */
+    task_id_type prev; /* pointer to previous task */
+    task_id_type next; /* pointer to next task     */
+
 
+	MESS_OUT_DEBUG( MESS_OUT_message( (S8*)"q1_insert() task", MESSAGE_OP_DEBUG ) );
 
-	MESS_OUT_message( (S8*)"q1_insert() task", MESSAGE_OP_DEBUG );
+    SCH_COUNT_INSERT( ctx, header );
 
     /* initialise auxiliary pointers */
     prev = ZERO_CPV;
     next = header->q1_next;
 
-    switch ( scheduling_algorithm )
+    switch ( q_order )
     {
-        case ALG_RM:
+        case Q_PRI:
             /* Priority: insert in priority order */
             while(
                      ( next is_not ZERO_CPV )
                      and
-                     ( tasks[task]->priority > tasks[next]->priority )
+                     ( ctx->tasks[task]->priority > ctx->tasks[next]->priority )
                  )
             {
                 prev = next;
-                next = tasks[next]->q1_next;
+                next = ctx->tasks[next]->q1_next;
             }
             break;
 
-        case ALG_LLF:
+        case Q_LLF:
             /* LLF: insert in least laxity order */
             while(
                      ( next is_not ZERO_CPV )
                      and
-                     ( tasks[task]->laxity > tasks[next]->laxity )
+                     ( LAXITY(task, ctx->timeval) > LAXITY(next, ctx->timeval) )
                  )
             {
                 prev = next;
-                next = tasks[next]->q1_next;
+                next = ctx->tasks[next]->q1_next;
             }
             break;
 
-        case ALG_ADAP_07:
+        case Q_EPRI:
             /* used for queuing doubled tasks */
             /* store in e_priority order - highest is bottom */
             while(
                      ( next is_not ZERO_CPV )
                      and
-                     ( tasks[task]->e_priority > tasks[next]->e_priority )
+                     ( ctx->tasks[task]->e_priority > ctx->tasks[next]->e_priority )
                  )
             {
                 prev = next;
-                next = tasks[next]->q1_next;
+                next = ctx->tasks[next]->q1_next;
             }
             break;
 
-        case ALG_IRM:
-        case ALG_DRM:
-        case ALG_D_STAR:
-        case ALG_DD_STAR:
-        case ALG_D_OVER:
-        case ALG_MLLF:
-        case ALG_MUF:
-        case ALG_MMUF:
-        case ALG_SPT:
-        case ALG_EDF_RTO:
-        case ALG_EDF:
-        case ALG_CYC:
-        case ALG_RR:
-        case ALG_RM_RTO:
-        case ALG_EDF_BWP:
-        case ALG_MMMUF:
-        case ALG_ADAP_01:
-        case ALG_ADAP_02:
-        case ALG_ADAP_03:
-        case ALG_ADAP_04:
-        case ALG_ADAP_05:
-        case ALG_ADAP_06:
-        case ALG_MAX_ALG:
+        case Q_EDF:
+        case Q_MUF:
+        case Q_SPT:
+        case Q_NONE:
+        case Q_MAX:
         default:
             /* do nothing */
 			MESS_OUT_message_1(  (S8*)"q1_insert() default switch with ",
-                                 (U32)scheduling_algorithm,
+                                 (U32)q_order,
 			                      MESSAGE_OP_ERROR );
             break;
     }
@@ -2230,7 +2909,7 @@ static void q1_insert( const U8 task,
     if( prev is_not ZERO_CPV )
     {
         /* not at start */
-        tasks[prev]->q1_next = task;
+        ctx->tasks[prev]->q1_next = task;
     }
     else
     {
@@ -2241,77 +2920,63 @@ static void q1_insert( const U8 task,
     if( next is_not ZERO_CPV )
     {
         /* not at end */
-        tasks[next]->q1_prev = task;
+        ctx->tasks[next]->q1_prev = task;
     }
 
     /* set new ready task pointers */
-    tasks[task]->q1_next = next;
-    tasks[task]->q1_prev = prev;
+    ctx->tasks[task]->q1_next = next;
+    ctx->tasks[task]->q1_prev = prev;
 } 
+#endif
 
 /******************************************************************************
 *  Description : private helper links task into head of task list
 *                according to scheduler algorithm
 *  Notes       : Adapted from code in Buttazzo's book (Buttazzo 2005)
-*  Parameters  : pointer to task
+*  Parameters  : ctx     - simulation context
+*                pointer to task
 *                pointer to queue
 *                algorithm to select
 ******************************************************************************/
-static void q2_insert( const U8 task,
+static void q2_insert( struct sim_context_type *ctx, const task_id_type task,
                        struct task_type *header,
-                       const algorithm_type scheduling_algorithm )
+                       const q_order_type q_order )
 {
-    U8  prev;      /* pointer to previous task */
-    U8  next;      /* pointer to next task     */
+    task_id_type prev; /* pointer to previous task */
+    task_id_type next; /* pointer to next task     */
+
+    SCH_COUNT_INSERT( ctx, header );
 
     /* initialise auxiliary pointers */
     prev = ZERO_CPV;
     next = header->q2_next;
 
-    switch ( scheduling_algorithm )
+    switch ( q_order )
     {
-        case ALG_LLF:
+        case Q_LLF:
             /* LLF: insert in least laxity order */
             while(
                      ( next is_not ZERO_CPV )
                      and
-                     ( tasks[task]->laxity > tasks[next]->laxity )
+                     ( LAXITY(task, ctx->timeval) > LAXITY(next, ctx->timeval) )
                  )
             {
                 prev = next;
-                next = tasks[next]->q2_next;
+                next = ctx->tasks[next]->q2_next;
             }
             break;
 
-        case ALG_RM:
-        case ALG_IRM:
-        case ALG_DRM:
-        case ALG_D_STAR:
-        case ALG_DD_STAR:
-        case ALG_D_OVER:
-        case ALG_MLLF:
-        case ALG_MUF:
-        case ALG_MMUF:
-        case ALG_SPT:
-        case ALG_EDF_RTO:
-        case ALG_EDF:
-        case ALG_CYC:
-        case ALG_RR:
-        case ALG_RM_RTO:
-        case ALG_EDF_BWP:
-        case ALG_MMMUF:
-        case ALG_ADAP_01:
-        case ALG_ADAP_02:
-        case ALG_ADAP_03:
-        case ALG_ADAP_04:
-        case ALG_ADAP_05:
-        case ALG_ADAP_06:
-        case ALG_ADAP_07:
-        case ALG_MAX_ALG:
+        case Q_PRI:
+        case Q_EDF:
+        case Q_MUF:
+        case Q_SPT:
+        case Q_EPRI:
+        case Q_NONE:
+        case Q_MAX:
         default:
             /* do nothing */
 			MESS_OUT_message_1( (S8*)"q2_insert() default switch with ",
-                                (U32)scheduling_algorithm,
+                                (U32)q_order,
 			                    MESSAGE_OP_ERROR );
             break;
     }
@@ -2322,7 +2987,7 @@ static void q2_insert( const U8 task,
         if( prev is_not ZERO_CPV )
         {
             /* not at start */
-            tasks[prev]->q2_next = task;
+            ctx->tasks[prev]->q2_next = task;
         }
         else
         {
@@ -2330,116 +2995,211 @@ static void q2_insert( const U8 task,
             header->q2_next = task;
         }
 
-        if( next is_not ZERO_CPV )
+        if( next is_not ZERO_CPV )
+        {
+            /* not at end */
+            ctx->tasks[next]->q2_prev = task;
+        }
+
+        /* set new ready task pointers */
+        ctx->tasks[task]->q2_next = next;
+        ctx->tasks[task]->q2_prev = prev;
+    }
+    else
+    {
+        /* task is already in que - abandon operation */
+        MESS_OUT_message_1( (S8*)"Trying to insert task twice, abandoning ",
+                       task, MESSAGE_OP_ERROR );
+    }
+} 
+
+/******************************************************************************
+*  Description : private helper returns first ready task in header queue
+*  Notes       : Adapted from code in Buttazzo's book (Buttazzo 2005)
+*  Parameters  : ctx     - simulation context
+*                queue header pointer
+******************************************************************************/
+static task_id_type q_extract_first( struct sim_context_type *ctx, struct task_type *header )
+{
+    task_id_type pointer; /* pointer to task */
+    struct task_q_type *q;
+
+    q = q0_heap( ctx, header );
+
+    if( q is_not NULL )
+    {
+        pointer = QUTIL_heap_extract_first( ctx, q );
+    }
+    else if( (pointer = header->q0_next) is_not ZERO_CPV )
+    {
+        /* queue is not empty, get following task id */
+        header->q0_next = ctx->tasks[pointer]->q0_next;
+
+        ctx->tasks[ctx->tasks[pointer]->q0_next]->q0_prev = ZERO_CPV;
+    }
+
+    if( pointer is_not ZERO_CPV )
+    {
+        SCH_COUNT_EXTRACT( ctx, header );
+    }
+
+    return( pointer );
+} 
+
+/******************************************************************************
+*  Description : private helper removes and returns the next task in a
+*                deadline ordered queue whose abs_dline has been reached, or
+*                zero if there is none
+*  Parameters  : ctx     - simulation context
+*                queue header pointer
+*                timeval - system time
+******************************************************************************/
+static task_id_type q_extract_due( struct sim_context_type *ctx, struct task_type *header, const U32 timeval )
+{
+    task_id_type task = ZERO_CPV;
+    struct task_wheel_type *w;
+
+    w = q0_wheel( ctx, header );
+
+    if( w is_not NULL )
+    {
+        task = QUTIL_wheel_extract_due( ctx, w, timeval );
+
+        if( task is_not ZERO_CPV )
         {
-            /* not at end */
-            tasks[next]->q2_prev = task;
+            SCH_COUNT_EXTRACT( ctx, header );
         }
-
-        /* set new ready task pointers */
-        tasks[task]->q2_next = next;
-        tasks[task]->q2_prev = prev;
+    }
+    else if(   ( !q_empty( ctx, ZERO_CPV, header ) )
+               and /* AND the first deadline is less than or equal to time now */
+               ( ctx->tasks[ q_first_id( ctx, ZERO_CPV, header ) ]->abs_dline <= timeval ) )
+    {
+        task = q_extract_first( ctx, header );
     }
     else
     {
-        /* task is already in que - abandon operation */
-        MESS_OUT_message_1( (S8*)"Trying to insert task twice, abandoning ",
-                       task, MESSAGE_OP_ERROR );
+        /* nothing due */
     }
+
+    return( task );
 } 
 
 /******************************************************************************
-*  Description : private helper returns first ready task in header queue
-*  Notes       : Adapted from code in Buttazzo's book (Buttazzo 2005)
-*  Parameters  : queue header pointer
+*  Description : private helper returns the earliest abs_dline in a deadline
+*                ordered queue, or QUTIL_NO_RELEASE if it is empty
+*  Parameters  : ctx     - simulation context
+*                queue header pointer
 ******************************************************************************/
-static U8 q_extract_first( struct task_type *header )
+static U32 q_next_release( struct sim_context_type *ctx, const struct task_type *header )
 {
-    U8 pointer; /* pointer to task */
+    U32 release = QUTIL_NO_RELEASE;
+    struct task_wheel_type *w;
 
-    pointer = header->q0_next;
+    w = q0_wheel( ctx, header );
 
-    if( pointer is_not ZERO_CPV )
+    if( w is_not NULL )
     {
-        /* queue is not empty, get following task id */
-        header->q0_next = tasks[pointer]->q0_next;
-
-        tasks[tasks[pointer]->q0_next]->q0_prev = ZERO_CPV;
+        release = QUTIL_wheel_next_release( ctx, w );
+    }
+    else if( !q_empty( ctx, ZERO_CPV, header ) )
+    {
+        release = ctx->tasks[ q_first_id( ctx, ZERO_CPV, header ) ]->abs_dline;
+    }
+    else
+    {
+        /* empty */
     }
 
-    return( pointer );
+    return( release );
 } 
 
 /******************************************************************************
 *  Description : private helper removes task from queue list 0.
 *  Notes       : Adapted from code in Buttazzo's book (Buttazzo 2005)
 ******************************************************************************/
-static void q0_extract( const U8 task )
+static void q0_extract( struct sim_context_type *ctx, const task_id_type task )
 {
     task_state_type state;
-    struct task_type *header = ready_tasks; /* initialise to please Lint */
+    struct task_type *header = ctx->ready_tasks; /* initialise to please Lint */
 
-    U8 p;       /* auxiliary pointers */
-    U8 q;       /* auxiliary pointers */
+    task_id_type p;    /* auxiliary pointers */
+    task_id_type q;    /* auxiliary pointers */
 
-    state = tasks[task]->state;
+    state = ctx->tasks[task]->state;
 
     if( (state is TSK_READY)or(state is TSK_PREMPT) )
     {
-        header = ready_tasks;
+        header = ctx->ready_tasks;
     }
     else if( state is TSK_REMOVED )
     {
-        header = removed_tasks;
+        header = ctx->removed_tasks;
     }
     else if( state is TSK_IDLE )
     {
-        header = idle_tasks;
+        header = ctx->idle_tasks;
     }
     else
     {
         /* not possible */
     }
 
-    p = tasks[task]->q0_prev;
-    q = tasks[task]->q0_next;
+    SCH_COUNT_EXTRACT( ctx, header );
 
-    if( p is ZERO_CPV )
+    if( q0_heap( ctx, header ) is_not NULL )
     {
-        /* task is first element of queue */
-        header->q0_next = q;
+        QUTIL_heap_remove( ctx, &ctx->ready_q, task );
     }
-    else
+    else if( q0_wheel( ctx, header ) is_not NULL )
     {
-        tasks[p]->q0_next = q;
+        QUTIL_wheel_remove( ctx, q0_wheel( ctx, header ), task );
     }
-
-    if( q is_not ZERO_CPV )
+    else
     {
-        tasks[q]->q0_prev = p;
+        p = ctx->tasks[task]->q0_prev;
+        q = ctx->tasks[task]->q0_next;
+
+        if( p is ZERO_CPV )
+        {
+            /* task is first element of queue */
+            header->q0_next = q;
+        }
+        else
+        {
+            ctx->tasks[p]->q0_next = q;
+        }
+
+        if( q is_not ZERO_CPV )
+        {
+            ctx->tasks[q]->q0_prev = p;
+        }
     }
 
     /* clear removed task pointers */
-    tasks[task]->q0_prev = ZERO_CPV;
-    tasks[task]->q0_next = ZERO_CPV;
+    ctx->tasks[task]->q0_prev = ZERO_CPV;
+    ctx->tasks[task]->q0_next = ZERO_CPV;
 } 
 
+#if SCH_DOUBLED_QUEUE
 /******************************************************************************
 *  Description : private helper removes task from queue list 1.
 *  Notes       : Adapted from code in Buttazzo's book (Buttazzo 2005)
-*  Parameters  : task number
+*  Parameters  : ctx     - simulation context
+*                task number
 *                task list header
 ******************************************************************************/
-static void q1_extract( const U8 task, struct task_type *header )
+static void q1_extract( struct sim_context_type *ctx, const task_id_type task, struct task_type *header )
 {
-    U8 p;       /* auxiliary pointers */
-    U8 q;       /* auxiliary pointers */
+    task_id_type p;    /* auxiliary pointers */
+    task_id_type q;    /* auxiliary pointers */
 
-    MESS_OUT_message_1( (S8*)"DEBUG: q1_extract() task ", 
-                        task, MESSAGE_OP_DEBUG );
+    MESS_OUT_DEBUG( MESS_OUT_message_1( (S8*)"DEBUG: q1_extract() task ", 
+                                        task, MESSAGE_OP_DEBUG ) );
 
-    p = tasks[task]->q1_prev;
-    q = tasks[task]->q1_next;
+    SCH_COUNT_EXTRACT( ctx, header );
+
+    p = ctx->tasks[task]->q1_prev;
+    q = ctx->tasks[task]->q1_next;
 
     if( (p is ZERO_CPV) and (header->q1_next is task) )
     {
@@ -2449,33 +3209,38 @@ static void q1_extract( const U8 task, struct task_type *header )
     else
     {
         /* task is in middle or end of queue */
-        tasks[p]->q1_next = q;
+        ctx->tasks[p]->q1_next = q;
     }
 
     if( q is_not ZERO_CPV )
     {
         /* task is not at the end of the queue */
-        tasks[q]->q1_prev = p;
+        ctx->tasks[q]->q1_prev = p;
     }
 
     /* clear removed task pointers */
-    tasks[task]->q1_prev = ZERO_CPV;
-    tasks[task]->q1_next = ZERO_CPV;
+    ctx->tasks[task]->q1_prev = ZERO_CPV;
+    ctx->tasks[task]->q1_next = ZERO_CPV;
 } 
+#endif
 
+#if SCH_DISPATCH_ALGORITHMS
 /******************************************************************************
 *  Description : private helper removes task from queue list 2.
 *  Notes       : Adapted from code in Buttazzo's book (Buttazzo 2005)
-*  Parameters  : task number
+*  Parameters  : ctx     - simulation context
+*                task number
 *                task list header
 ******************************************************************************/
-static void q2_extract( const U8 task, struct task_type *header )
+static void q2_extract( struct sim_context_type *ctx, const task_id_type task, struct task_type *header )
 {
-    U8 p;       /* auxiliary pointers */
-    U8 q;       /* auxiliary pointers */
+    task_id_type p;    /* auxiliary pointers */
+    task_id_type q;    /* auxiliary pointers */
 
-    p = tasks[task]->q2_prev;
-    q = tasks[task]->q2_next;
+    SCH_COUNT_EXTRACT( ctx, header );
+
+    p = ctx->tasks[task]->q2_prev;
+    q = ctx->tasks[task]->q2_next;
 
     if( p is ZERO_CPV )
     {
@@ -2484,33 +3249,82 @@ static void q2_extract( const U8 task, struct task_type *header )
     }
     else
     {
-        tasks[p]->q2_next = q;
+        ctx->tasks[p]->q2_next = q;
     }
 
     if( q is_not ZERO_CPV )
     {
-        tasks[q]->q2_prev = p;
+        ctx->tasks[q]->q2_prev = p;
     }
 
     /* clear removed task pointers */
-    tasks[task]->q2_prev = ZERO_CPV;
-    tasks[task]->q2_next = ZERO_CPV;
+    ctx->tasks[task]->q2_prev = ZERO_CPV;
+    ctx->tasks[task]->q2_next = ZERO_CPV;
 } 
+#endif
+
+#if SCH_PROFILE
+/******************************************************************************
+*  Description : private helper returns the profile queue of a queue header
+*  Parameters  : ctx     - simulation context
+*                pointer to queue header
+******************************************************************************/
+static sch_queue_type profile_queue( struct sim_context_type *ctx, const struct task_type *header )
+{
+    sch_queue_type queue = SCH_QUEUE_READY;
+
+    if( header is ctx->idle_tasks )
+    {
+        queue = SCH_QUEUE_IDLE;
+    }
+    else if( header is ctx->waiting_tasks )
+    {
+        queue = SCH_QUEUE_WAITING;
+    }
+    else if( header is ctx->skipped_tasks )
+    {
+        queue = SCH_QUEUE_SKIPPED;
+    }
+    else if( header is ctx->removed_tasks )
+    {
+        queue = SCH_QUEUE_REMOVED;
+    }
+    else if( header is ctx->doubled_periods )
+    {
+        queue = SCH_QUEUE_DOUBLED;
+    }
+    else if( header is ctx->lst_tasks )
+    {
+        queue = SCH_QUEUE_LST;
+    }
+    else
+    {
+        /* ready queue */
+    }
+
+    return( queue );
+}
+#endif
 
 /******************************************************************************
 *  Description : private helper returns TRUE if queue is empty
 *  Notes       : Adapted from code in Buttazzo's book (Buttazzo 2005)
-*  Parameters  : queue link number
+*  Parameters  : ctx     - simulation context
+*                queue link number
 *                pointer to queue header
 ******************************************************************************/
-static boolean q_empty( const U8 queue, const struct task_type *header )
+static boolean q_empty( struct sim_context_type *ctx, const U8 queue, const struct task_type *header )
 {
     boolean is_empty;
 
     switch( queue )
     {
         case ZERO_CPV:
-            if(header->q0_next is ZERO_CPV)
+            if( q0_heap( ctx, header ) is_not NULL )
+            {
+                is_empty = ( (boolean)(ctx->ready_q.size is ZERO_CPV) );
+            }
+            else if(header->q0_next is ZERO_CPV)
             {
                 is_empty = TRUE;
             }
@@ -2539,17 +3353,25 @@ static boolean q_empty( const U8 queue, const struct task_type *header )
 /******************************************************************************
 *  Description : private helper returns first task id in queue
 *  Notes       : Adapted from code in Buttazzo's book (Buttazzo 2005)
-*  Parameters  : queue link number
+*  Parameters  : ctx     - simulation context
+*                queue link number
 *                pointer to queue
 ******************************************************************************/
-static U8 q_first_id( const U8 queue, const struct task_type *header )
+static task_id_type q_first_id( struct sim_context_type *ctx, const U8 queue, const struct task_type *header )
 {
-    U8 id;
+    task_id_type id;
 
     switch( queue )
     {
         case ZERO_CPV:
-            id = header->q0_next;
+            if( q0_heap( ctx, header ) is_not NULL )
+            {
+                id = QUTIL_heap_first( &ctx->ready_q );
+            }
+            else
+            {
+                id = header->q0_next;
+            }
             break;
         case ONE_CPV:
             id = header->q1_next;
@@ -2566,25 +3388,34 @@ static U8 q_first_id( const U8 queue, const struct task_type *header )
     return( id );
 } 
 
+#if SCH_ALG_BUILT(SCH_NUM_EDF_RTO)
 /******************************************************************************
 *  Description : private helper returns second task id in queue
-*  Parameters  : pointer to queue
+*  Parameters  : ctx     - simulation context
+*                pointer to queue
 *  Returns     : first id in queue, or zero if empty
 ******************************************************************************/
-static U8 q_second_id( const U8 queue, const struct task_type *header )
+static task_id_type q_second_id( struct sim_context_type *ctx, const U8 queue, const struct task_type *header )
 {
-    U8 id;
+    task_id_type id;
 
     switch( queue )
     {
         case 0:
-            id = tasks[header->q0_next]->q0_next;
+            if( q0_heap( ctx, header ) is_not NULL )
+            {
+                id = QUTIL_heap_second( ctx, &ctx->ready_q );
+            }
+            else
+            {
+                id = ctx->tasks[header->q0_next]->q0_next;
+            }
             break;
         case 1:
-            id = tasks[header->q1_next]->q1_next;
+            id = ctx->tasks[header->q1_next]->q1_next;
             break;
         case 2:
-            id = tasks[header->q2_next]->q2_next;
+            id = ctx->tasks[header->q2_next]->q2_next;
             break;
         default:
             id = ZERO_CPV;
@@ -2594,187 +3425,48 @@ static U8 q_second_id( const U8 queue, const struct task_type *header )
     }
     return( id );
 } 
+#endif
 
-/******************************************************************************
-*  Description : private helper calculates all task laxities. Steps through
-*                task array calculating laxity.
-******************************************************************************/
-static void calculate_all_laxities( const U32 timeval )
-{
-    task_state_type state;
-    U8 index;
-
-    for( index=ONE_CPV; index<NUM_OF_TASKS; index++ )
-    {
-        state = tasks[index]->state;
-
-        if(
-            (state is TSK_READY)
-            or
-            (state is TSK_RUN)
-            or
-            (state is TSK_SKIPPED)
-            or
-            (state is TSK_PREMPT)
-          )
-        {
-            (void)calculate_laxity( index, timeval );
-        }
-    }
-} 
-
-/******************************************************************************
-*  Description : private helper calculates laxity for task.
-******************************************************************************/
-static U32 calculate_laxity( const U8 task, const U32 timeval )
-{
-    U32 deadline;
-    U32 time_left;
-
-    deadline  = tasks[task]->abs_dline;
-    time_left = tasks[task]->time_left;
-
-    if( deadline > (timeval + time_left) )
-    {
-        tasks[task]->laxity = deadline - (timeval + time_left);
-    }
-    else
-    {
-        tasks[task]->laxity = ZERO_CPV;
-    }
-
-    return( tasks[task]->laxity );
-} 
-
-/******************************************************************************
-*  Description : private helper calculates all task muf urgencies. Steps
-*                through task array calculating.
-*  Notes       : Adapted from by Stewart and Khoslas paper proposing the
-*                Maximum Urgency First (MUF) algorithm
-*                (Stewart and Khosla 1991).
-******************************************************************************/
-static void calculate_all_muf_urgencies( void )
-{
-    task_state_type state;
-    U8 index;
-
-    for( index=ONE_CPV; index<NUM_OF_TASKS; index++ )
-    {
-        state = tasks[index]->state;
-
-        if(
-              (state is TSK_READY)
-              or
-              (state is TSK_RUN)
-              or
-              (state is TSK_SKIPPED)
-              or
-              (state is TSK_PREMPT)
-          )
-        {
-            calculate_muf_urgency( index );
-        }
-    }
-} 
-
-/******************************************************************************
-*  Function    : calculate_muf_urgency
-*  Description : private helper calculates laxity for task. The following is
-*                a bit map of the urgency word.
-*
-*                1 111-1111-1111-1111-1111-1111-1111 1111
-*                | |                               | |  |
-*                | |           27 bits             |  \/
-*                | |                               |   |       4 bits
-*                | |                               |   \- user defined priority
-*                | |                               |
-*                | \-------------   --------------/
-*                |               \ /
-*                |                \--inverse of laxity (dynamic priority)
-*                |
-*                |
-*                \---------- msb=1 if in critical set, ELSE msb=0
-*
-*  Notes       : Adapted from by Stewart and Khoslas paper proposing the
-*                Maximum Urgency First (MUF) algorithm
-*                (Stewart and Khosla 1991).
-******************************************************************************/
-static void calculate_muf_urgency( const U8 task )
-{
-    const U32 l_shift = 4U;                /* laxity shift            */
-    const U32 c_mask  = (U32)0x80000000u;  /* critical mask           */
-    const U32 l_mask  = (U32)0x07ffffffu;  /* laxity mask (pre-shift) */
-    const U32 p_mask  = (U32)0x0000000fu;  /* priority mask           */
-
-    U32 critical;
-    U32 i_laxity;
-
-    /*  set critical bit */
-    if( MUF_CRITICAL(task) is ONE_CPV )
-    {
-        critical = c_mask;
-    }
-    else
-    {
-        critical = ZERO_CPV;
-    }
-    
-    MUF_URGENCY(task) = critical;
-
-    /* set inverse laxity and load bits */
-    i_laxity = (~tasks[task]->laxity) & l_mask;
-
-    MUF_URGENCY(task) |= ( i_laxity << l_shift );
-
-    /* load priority bits */
-    MUF_URGENCY(task) |= ( tasks[task]->priority & p_mask );
-} 
-
+#if SCH_OVERLOAD_ALGORITHMS
 /******************************************************************************
 *  Description : private helper returns active task with the lowest priority
-*  Notes       : number #1 is highest priority
+*  Notes       : number #1 is highest priority. Walks the task table in
+*                order rather than through the task pointers, and tests
+*                the state against a set with one mask
 ******************************************************************************/
-static U8 get_lowest_priority_active_task( void )
+static task_id_type get_lowest_priority_active_task( struct sim_context_type *ctx )
 {
-    task_state_type state;
-    U8 index;
+    const struct task_type *task;
+    U32 index;
     U8 lowest_priority = ZERO_CPV;
-    U8 lowest_index    = ZERO_CPV;
+    task_id_type lowest_index = ZERO_CPV;
 
-    for( index=ONE_CPV; index<NUM_OF_TASKS; index++ )
+    task = &ctx->task_array[ONE_CPV];
+    for( index=ONE_CPV; index<=ctx->num_tasks; index++, task++ )
     {
-        state = tasks[index]->state;
-
-        if( (state is TSK_READY)
-            or
-            (state is TSK_RUN)
-            or
-            (state is TSK_SKIPPED)
-            or
-            (state is TSK_IDLE)
-            or
-            (state is TSK_PREMPT) )
+        if( TSK_IN_STATES( task->state, TSK_UTILITY_STATES )
+            and
+            (task->priority > lowest_priority)
+            and
+            (task->period_multiplyer is ZERO_CPV)
+            and
+            (PERIOD_FLEXIBLE_OF(task) is ONE_CPV) )
         {
-            if( (tasks[index]->priority > lowest_priority)
-                and
-                (tasks[index]->period_multiplyer is ZERO_CPV)
-                and
-                (PERIOD_FLEXIBLE(index) is ONE_CPV) )
-            {
-                /* indexed task has lower priority (higher number) */
-                lowest_priority = tasks[index]->priority;
-                lowest_index    = index;
-            }
+            /* indexed task has lower priority (higher number) */
+            lowest_priority = task->priority;
+            lowest_index    = index;
         }
     }
 
-    MESS_OUT_message_1( (S8*)"get_lowest_priority_active_task() returns ",
-                        lowest_index,
-                        MESSAGE_OP_DEBUG ); 
+    MESS_OUT_DEBUG( MESS_OUT_message_1( (S8*)"get_lowest_priority_active_task() returns ",
+                                        lowest_index,
+                                        MESSAGE_OP_DEBUG ) ); 
 
     return( lowest_index );
 }
+#endif
 
+#if SCH_ALG_BUILT(SCH_NUM_ADAP_07)
 /******************************************************************************
 *  Description : private helper returns candidate task for task doubling
 *                THE RULES:
@@ -2786,45 +3478,37 @@ static U8 get_lowest_priority_active_task( void )
 *  Notes       : number #1 is highest priority
 *  Returns     : candidate task index, or zero if unsuccessful
 ******************************************************************************/
-static U8 get_active_task_priority( void )
+static task_id_type get_active_task_priority( struct sim_context_type *ctx )
 {
-    task_state_type state;
-    U8 index;
+    const struct task_type *task;
+    U32 index;
     U8 lowest_priority = ~ZERO_CPV; /* need to invert - 1 is highest */
-    U8 lowest_index    = ZERO_CPV;
+    task_id_type lowest_index = ZERO_CPV;
 
     /* run through tasks calculating priority */
-    for( index=ONE_CPV; index<NUM_OF_TASKS; index++ )
+    task = &ctx->task_array[ONE_CPV];
+    for( index=ONE_CPV; index<=ctx->num_tasks; index++, task++ )
     {
-        calculate_active_task_priority( index );
-
-        /* localise task state */
-        state = tasks[index]->state;
+        calculate_active_task_priority( ctx, index );
 
-        if( ((state is TSK_READY)
-            or
-            (state is TSK_RUN)
-            or
-            (state is TSK_IDLE)
-            or
-            (state is TSK_PREMPT))
+        /* look for lowest value */
+        if( TSK_IN_STATES( task->state, TSK_ACTIVE_STATES )
             and
-            (PERIOD_FLEXIBLE(index)) )
+            (PERIOD_FLEXIBLE_OF(task) is_not ZERO_CPV)
+            and
+            (task->e_priority < lowest_priority) )
         {
-            /* look for lowest value */
-
-            if (tasks[index]->e_priority < lowest_priority)
-            {
-                /* indexed task has lower priority (higher number) */
-                lowest_priority = tasks[index]->e_priority;
-                lowest_index    = index;
-            }
+            /* indexed task has lower priority (higher number) */
+            lowest_priority = task->e_priority;
+            lowest_index    = index;
         }
     }
 
     return( lowest_index );
 } 
+#endif
 
+#if SCH_DOUBLED_QUEUE
 /******************************************************************************
 *  Description : private helper used by get_active_task_priority
 *
@@ -2840,7 +3524,7 @@ static U8 get_active_task_priority( void )
 *                 \-------- 4 bit task doubling value priority
 *
 ******************************************************************************/
-static void calculate_active_task_priority( const U8 task )
+static void calculate_active_task_priority( struct sim_context_type *ctx, const task_id_type task )
 {
     const U8 m_shift = (U8)FOUR_CPV; /* multiplier shift            */
     const U8 m_mask  = (U8)0x0fU;    /* multiplier mask (pre shift) */
@@ -2849,104 +3533,103 @@ static void calculate_active_task_priority( const U8 task )
     U8 multiplyer;
 
     /* mask, shift and load the multiplier bits */
-    multiplyer = tasks[task]->period_multiplyer & m_mask;
-    tasks[task]->e_priority = (U8)(multiplyer << m_shift);
+    multiplyer = ctx->tasks[task]->period_multiplyer & m_mask;
+    ctx->tasks[task]->e_priority = (U8)(multiplyer << m_shift);
 
     /* load priority bits - need to invert because one is highest */
-    tasks[task]->e_priority |= ( ~tasks[task]->priority & p_mask );
+    ctx->tasks[task]->e_priority |= ( ~ctx->tasks[task]->priority & p_mask );
 } 
+#endif
 
+#if SCH_ALG_BUILT(SCH_NUM_EDF_RTO)
 /******************************************************************************
 *  Description : private helper - tests if task is skippable
 *                skippable means that not skipped count S is zero
 *  Notes       : Based on the Red Task Only Skip-Over algorithm in paper
 *                by Koren and Shasha (1995).
-*  Parameters  : task - id of task
+*  Parameters  : ctx     - simulation context
+*                task - id of task
 *                time
 *  Returns     : TRUE - if skippable
 ******************************************************************************/
-static U8 task_skippable( const U8 task )
+static U8 task_skippable( struct sim_context_type *ctx, const task_id_type task )
 {
     return( NOT_SKIPPED(task) is ZERO_CPV );
 } 
+#endif
 
+#if SCH_DISPATCH_ALGORITHMS
 /******************************************************************************
 *  Description : private helper - decrements running tasks non skipped count
 *  Notes       : Based on the Red Task Only Skip-Over algorithm in paper
 *                by Koren and Shasha (1995).
 ******************************************************************************/
-static void decrement_not_skipped_count( const U8 task )
+static void decrement_not_skipped_count( struct sim_context_type *ctx, const task_id_type task )
 {
     if( NOT_SKIPPED(task) > ZERO_CPV )
     {
         NOT_SKIPPED(task)--;
+        update_utility_share( ctx, task );
     }
 } 
+#endif
 
+#if SCH_ALG_BUILT(SCH_NUM_EDF_RTO)
 /******************************************************************************
 *  Description : private helper - returns TRUE if task has time to meet
 *                its deadline
 *  Notes       : Based on the Red Task Only Skip-Over algorithm in paper
 *                by Koren and Shasha (1995).
 ******************************************************************************/
-static boolean can_meet_deadline( const U8 task, const U32 timeval )
+static boolean can_meet_deadline( struct sim_context_type *ctx, const task_id_type task, const U32 timeval )
 {
-    return(boolean)(tasks[task]->time_left + timeval);
+    return(boolean)(ctx->tasks[task]->time_left + timeval);
 } 
+#endif
 
+#if SCH_ADAPTIVE_ALGORITHMS
 /******************************************************************************
 *  Description : private helper calculates utility of task
+*  Notes       : only tasks whose calculated duration has changed since their
+*                utility was last calculated are divided out again, the rest
+*                are already counted in the running total
 ******************************************************************************/
-static U16 calculate_all_task_utilities( void )
+static U16 calculate_all_task_utilities( struct sim_context_type *ctx )
 {
-    task_state_type state;
-    U8 index;
-    U16 task_utility;
-    U16 task_set_utility = ZERO_CPV;
+    U32 index;
 
-    /* step through all atsks */
-    for( index=ONE_CPV; index<NUM_OF_TASKS; index++ )
+    if( ctx->stale_utils > ZERO_CPV )
     {
-        /* localise the state */
-        state = tasks[index]->state;
-
-        if(
-              (state is TSK_READY)
-              or
-              (state is TSK_RUN)
-              or
-              (state is TSK_SKIPPED)
-              or
-              (state is TSK_IDLE)
-              or
-              (state is TSK_PREMPT)
-          )
+        /* step through all tasks */
+        for( index=ONE_CPV; index<=ctx->num_tasks; index++ )
         {
-            /* calculate the task utility */
-            task_utility = calculate_task_utility( index );
-
-            if( PERIOD_FLEXIBLE(index)is ONE_CPV )
+            if(
+                  (ctx->tasks[index]->util_stale is TRUE)
+                  and
+                  (task_has_utility( ctx, index ) is TRUE)
+              )
             {
-                task_set_utility += (task_utility
-                                  >> tasks[index]->period_multiplyer );
-            }
-            else
-            {
-                task_set_utility += task_utility;
+                /* recalculate the task utility, updating its share */
+                (void)calculate_task_utility( ctx, index );
+
+                ctx->tasks[index]->util_stale = FALSE;
+                ctx->stale_utils--;
             }
         }
     }
 
-    return( task_set_utility );
+    return( get_task_set_utility( ctx ) );
 }
+#endif
 
 
+#if SCH_ADAPTIVE_ALGORITHMS
 /******************************************************************************
 *  Description : private helper calculates utility of task
 *  Notes       : utility = period / duration
 *  Returns     : utility of task (x 1000)
 ******************************************************************************/
-static U16 calculate_task_utility( const U8 task )
+static U16 calculate_task_utility( struct sim_context_type *ctx, const task_id_type task )
 {
     const U32 UTIL_MOD = 1000;
 
@@ -2954,101 +3637,107 @@ static U16 calculate_task_utility( const U8 task )
 
     U16 utility;
 
-    UTL_divide( (tasks[task]->c_duration * UTIL_MOD),
-                 tasks[task]->period,
+    UTL_divide( (ctx->tasks[task]->c_duration * UTIL_MOD),
+                 ctx->tasks[task]->period,
                  &div);
 
     utility = div.quotient;
 
-    if( utility is_not tasks[task]->task_util )
+    if( utility is_not ctx->tasks[task]->task_util )
     {
         /* task utility changed */
-        MESS_OUT_message_3( (S8*)"Task ",
-                            task,
-                            (S8*)" utility updated from ",
-                            tasks[task]->task_util,
-                            (S8*)" to ",
-                            utility, 
-                            MESSAGE_OP_VERBOSE );
+        MESS_OUT_VERBOSE( MESS_OUT_message_3( (S8*)"Task ",
+                                              task,
+                                              (S8*)" utility updated from ",
+                                              ctx->tasks[task]->task_util,
+                                              (S8*)" to ",
+                                              utility, 
+                                              MESSAGE_OP_VERBOSE ) );
 
         /* update calculated utility */
-        tasks[task]->task_util = utility;
+        ctx->tasks[task]->task_util = utility;
+        update_utility_share( ctx, task );
     }
     return( utility );
 } 
+#endif
 
 /******************************************************************************
 *  Description : private helper - returns total value of estimated
-*                task set utility (x1000) by summing the utility member of 
-*                each task
+*                task set utility (x1000), the sum of the utility shares of
+*                all tasks, kept up to date by update_utility_share()
 ******************************************************************************/
-static U16 get_task_set_utility( void )
+static U16 get_task_set_utility( struct sim_context_type *ctx )
 {
-    task_state_type state;
-    U8 index;
-    U32 task_set_utility = ZERO_CPV;
+    return( (U16)ctx->task_set_util );
+} 
 
-    /* step through all tasks */
-    for( index=ONE_CPV; index<NUM_OF_TASKS; index++ )
-    {
-        /* localise the task state */
-        state = tasks[index]->state;
+/******************************************************************************
+*  Description : private helper - returns TRUE if task is in a state that
+*                counts towards the task set utility
+******************************************************************************/
+static boolean task_has_utility( struct sim_context_type *ctx, const task_id_type task )
+{
+    return( TSK_IN_STATES( ctx->tasks[task]->state, TSK_UTILITY_STATES ) ? TRUE : FALSE );
+} 
 
-        /* select tasks with valid utility */
-        if(
-              (state is TSK_READY)
-              or
-              (state is TSK_RUN)
-              or
-              (state is TSK_SKIPPED)
-              or
-              (state is TSK_IDLE)
-              or
-              (state is TSK_PREMPT)
-          )
+/******************************************************************************
+*  Description : private helper - recalculates the share task contributes to
+*                the task set utility and adjusts the running total by the
+*                difference
+*  Notes       : must be called whenever the task state, utility, period
+*                multiplier or PERIOD_FLEXIBLE member changes. The last shares
+*                its member with the skip counts.
+******************************************************************************/
+static void update_utility_share( struct sim_context_type *ctx, const task_id_type task )
+{
+    U16 share = ZERO_CPV;
+
+    if( task_has_utility( ctx, task ) is TRUE )
+    {
+        if( PERIOD_FLEXIBLE(task) is ONE_CPV )
         {
-            if( PERIOD_FLEXIBLE(index) is ONE_CPV )
-            {
-                /* task period is flexible - check multiplyer */
-                task_set_utility += ( tasks[index]->task_util
-                                  >> tasks[index]->period_multiplyer );
-            }
-            else
-            {
-                /* just add the task utility to the total */
-                task_set_utility += tasks[index]->task_util;
-            }
+            /* task period is flexible - apply multiplyer */
+            share = ctx->tasks[task]->task_util
+                    >> ctx->tasks[task]->period_multiplyer;
+        }
+        else
+        {
+            share = ctx->tasks[task]->task_util;
         }
     }
-    return( task_set_utility );
+
+    ctx->task_set_util = ( ctx->task_set_util - ctx->tasks[task]->util_share ) + share;
+    ctx->tasks[task]->util_share = share;
 } 
 
 /******************************************************************************
 *  Description : private helper - searches removed queue for task with a lower
 *                utility value than util
-*  Parameters  : util - value to compare tasks in removed queue
+*  Parameters  : ctx     - simulation context
+*                util - value to compare tasks in removed queue
 *  Returns     : id of task with lower or equal util, or zero
 ******************************************************************************/
-static U8 removed_queue_has_task_with_lower_utility( const U16 util )
+static task_id_type removed_queue_has_task_with_lower_utility( struct sim_context_type *ctx, const U16 util )
 {
-    U8 q_ptr;
-    U8 return_id;
+    task_id_type q_ptr;
+    task_id_type return_id;
 
-    q_ptr = removed_tasks->q0_next; /* auxiliary pointer */
+    q_ptr = ctx->removed_tasks->q0_next; /* auxiliary pointer */
 
     while(
             (q_ptr is_not ZERO_CPV)
             and
-            (tasks[q_ptr]->task_util > util)
+            (ctx->tasks[q_ptr]->task_util > util)
          )
     {
         return_id = q_ptr;
 
         /* point to next element */
-        q_ptr = tasks[q_ptr]->q0_next;
+        q_ptr = ctx->tasks[q_ptr]->q0_next;
     }
 
-    if( tasks[q_ptr]->task_util <= util )
+    if( ctx->tasks[q_ptr]->task_util <= util )
     {
         /* if task has lower or equal utility to spare then return id */
         return_id = q_ptr;
@@ -3061,52 +3750,49 @@ static U8 removed_queue_has_task_with_lower_utility( const U16 util )
     return( return_id );
 } 
 
+#if SCH_DOUBLING_ALGORITHMS
 /******************************************************************************
 *  Description : private helper - doubles the period of a task by incrementing
 *                period_multiplyer, if period_flexible flag is set
 ******************************************************************************/
-static U8 double_task_period( const U8 task )
+static U8 double_task_period( struct sim_context_type *ctx, const task_id_type task )
 {
-    U32 old_abs_dline;
     task_state_type state;
-    U8 old_multiplyer;
     U8 new_multiplyer;
 
     /* double check that task period extension is enabled for this task */
     if( PERIOD_FLEXIBLE(task) is ONE_CPV )
     {
 		/* report activity */
-		TST_incr_test_report_value( TST_PER_DOUBLES );
-		tasks[task]->per_doubles++;
-
-        /* record value for verbose reporting */
-        old_multiplyer = tasks[task]->period_multiplyer;
+		TST_incr_test_report_value( ctx, TST_PER_DOUBLES );
+		TSK_STATS(task).per_doubles++;
 
         /* increment and localise the multiplier */
-        tasks[task]->period_multiplyer++;
-        new_multiplyer = tasks[task]->period_multiplyer;
+        ctx->tasks[task]->period_multiplyer++;
+        update_utility_share( ctx, task );
+        new_multiplyer = ctx->tasks[task]->period_multiplyer;
 
         /* report period update */
-        MESS_OUT_message_1( (S8*)"Doubled period for task ", 
-                            task, MESSAGE_OP_VERBOSE );
-
-        MESS_OUT_message_3( (S8*)"Task ",
-                            task,
-                            (S8*)" period doubled from ",
-                            tasks[task]->rel_dline << old_multiplyer,
-                            (S8*)" to ",
-                            tasks[task]->rel_dline << new_multiplyer,
-                            MESSAGE_OP_VERBOSE );
-        MESS_OUT_message_3( (S8*)"Task ",
-                            task,
-                            (S8*)" utility halved from ",
-                            tasks[task]->task_util >> old_multiplyer,
-                            (S8*)" to ",
-                            tasks[task]->task_util >> new_multiplyer,
-                            MESSAGE_OP_VERBOSE );
+        MESS_OUT_VERBOSE( MESS_OUT_message_1( (S8*)"Doubled period for task ", 
+                                              task, MESSAGE_OP_VERBOSE ) );
+
+        MESS_OUT_VERBOSE( MESS_OUT_message_3( (S8*)"Task ",
+                                              task,
+                                              (S8*)" period doubled from ",
+                                              ctx->tasks[task]->rel_dline << (new_multiplyer - ONE_CPV),
+                                              (S8*)" to ",
+                                              ctx->tasks[task]->rel_dline << new_multiplyer,
+                                              MESSAGE_OP_VERBOSE ) );
+        MESS_OUT_VERBOSE( MESS_OUT_message_3( (S8*)"Task ",
+                                              task,
+                                              (S8*)" utility halved from ",
+                                              ctx->tasks[task]->task_util >> (new_multiplyer - ONE_CPV),
+                                              (S8*)" to ",
+                                              ctx->tasks[task]->task_util >> new_multiplyer,
+                                              MESSAGE_OP_VERBOSE ) );
 
         /* if the task is ready or running update deadline now */
-        state = tasks[task]->state;
+        state = ctx->tasks[task]->state;
         if(
               (state is TSK_READY)
               or
@@ -3115,81 +3801,77 @@ static U8 double_task_period( const U8 task )
               (state is TSK_PREMPT)
           )
         {
-            /* record for verbose reporting */
-            old_abs_dline = tasks[task]->abs_dline;
-
             /* set the deadline */
-            tasks[task]->abs_dline += (tasks[task]->rel_dline * new_multiplyer);
-
-            MESS_OUT_message_3( (S8*)"Task ",
-                                task,
-                                (S8*)" deadline increased from ",
-                                old_abs_dline,
-                                (S8*)" to ",
-                                tasks[task]->abs_dline, 
-                                MESSAGE_OP_VERBOSE );
+            ctx->tasks[task]->abs_dline += (ctx->tasks[task]->rel_dline * new_multiplyer);
+            q0_key_changed( ctx, task );
+
+            MESS_OUT_VERBOSE( MESS_OUT_message_3( (S8*)"Task ",
+                                                  task,
+                                                  (S8*)" deadline increased from ",
+                                                  ctx->tasks[task]->abs_dline
+                                                  - (ctx->tasks[task]->rel_dline * new_multiplyer),
+                                                  (S8*)" to ",
+                                                  ctx->tasks[task]->abs_dline, 
+                                                  MESSAGE_OP_VERBOSE ) );
         }
     }
-    return( tasks[task]->period_multiplyer );
+    return( ctx->tasks[task]->period_multiplyer );
 } 
+#endif
 
+#if SCH_DOUBLED_QUEUE
 /******************************************************************************
 *  Description : private helper - halves the period of a task
 *  Notes       : It is not safe to shorten the deadline at this stage
 ******************************************************************************/
-static void half_task_period( const U8 task )
+static void half_task_period( struct sim_context_type *ctx, const task_id_type task )
 {
-    U8 old_multiplyer;
-    U8 new_multiplyer;
-
     /* check that task period multiplier has value */
-    if( tasks[task]->period_multiplyer > 0 )
+    if( ctx->tasks[task]->period_multiplyer > 0 )
     {
-        /* remember the old multiplier value for reporting */
-        old_multiplyer = tasks[task]->period_multiplyer;
-
-        /* decrement the multiplier */
-        tasks[task]->period_multiplyer--;
-        new_multiplyer = tasks[task]->period_multiplyer;
+        /* decrement the multiplier, reported against the old value below */
+        ctx->tasks[task]->period_multiplyer--;
+        update_utility_share( ctx, task );
 
        /* report period restoration */
-        MESS_OUT_message_3( (S8*)"Task ",
-                             task,
-                             (S8*)" period halved from ",
-                             tasks[task]->rel_dline << old_multiplyer,
-                             (S8*)" to ",
-                             tasks[task]->rel_dline << new_multiplyer, 
-                             MESSAGE_OP_VERBOSE );
-        MESS_OUT_message_3( (S8*)"Task ",
-                             task,
-                             (S8*)" utility doubled from ",
-                             tasks[task]->task_util >> old_multiplyer,
-                             (S8*)" to ",
-                             tasks[task]->task_util >> new_multiplyer, 
-                             MESSAGE_OP_VERBOSE );
+        MESS_OUT_VERBOSE( MESS_OUT_message_3( (S8*)"Task ",
+                                               task,
+                                               (S8*)" period halved from ",
+                                               ctx->tasks[task]->rel_dline << (ctx->tasks[task]->period_multiplyer + ONE_CPV),
+                                               (S8*)" to ",
+                                               ctx->tasks[task]->rel_dline << ctx->tasks[task]->period_multiplyer, 
+                                               MESSAGE_OP_VERBOSE ) );
+        MESS_OUT_VERBOSE( MESS_OUT_message_3( (S8*)"Task ",
+                                               task,
+                                               (S8*)" utility doubled from ",
+                                               ctx->tasks[task]->task_util >> (ctx->tasks[task]->period_multiplyer + ONE_CPV),
+                                               (S8*)" to ",
+                                               ctx->tasks[task]->task_util >> ctx->tasks[task]->period_multiplyer, 
+                                               MESSAGE_OP_VERBOSE ) );
 
     } /* end if tasks[task]->period_multiplyer > 0 */
 }
+#endif
 
 /******************************************************************************
 *  Description : private helper tests queue
 ******************************************************************************/
 #if(0)
-static void q_dump( const struct task_type *header )
+static void q_dump( struct sim_context_type *ctx, const struct task_type *header )
 {
     U32 q0_next;
 
-    MESS_OUT_message( (S8*)"Q0-DUMP: ", MESSAGE_OP_DEBUG );
+    MESS_OUT_DEBUG( MESS_OUT_message( (S8*)"Q0-DUMP: ", MESSAGE_OP_DEBUG ) );
 
     q0_next = header->q0_next;
 
     while( q0_next is_not 0 )
     {
-        MESS_OUT_message_2( (S8*)"Task", q0_next,
-                            (S8*)" deadline = ", tasks[q0_next]->abs_dline,
-                            MESSAGE_OP_DEBUG);
+        MESS_OUT_DEBUG( MESS_OUT_message_2( (S8*)"Task", q0_next,
+                                            (S8*)" deadline = ", ctx->tasks[q0_next]->abs_dline,
+                                            MESSAGE_OP_DEBUG) );
 
-        q0_next = tasks[q0_next]->q0_next;
+        q0_next = ctx->tasks[q0_next]->q0_next;
     }
 
 } 
@@ -3200,40 +3882,40 @@ static void q_dump( const struct task_type *header )
 *  Description : private helper tests queue 1
 ******************************************************************************/
 #if(0)
-static void q1_dump( const struct task_type *header )
+static void q1_dump( struct sim_context_type *ctx, const struct task_type *header )
 {
     U32 q1_next;
 
-    MESS_OUT_message( (S8*)"Q1-DUMP: ", MESSAGE_OP_DEBUG );
+    MESS_OUT_DEBUG( MESS_OUT_message( (S8*)"Q1-DUMP: ", MESSAGE_OP_DEBUG ) );
 
     q1_next = header->q1_next;
 
     while( q1_next is_not 0 )
     {
-        if( algorithm is ALG_ADAP_06 )
+        if( ctx->algorithm is ALG_ADAP_06 )
         {
-            MESS_OUT_message_4( (S8*)"Task", q1_next,
-                           (S8*)" priority = ", tasks[q1_next]->priority,
-                           (S8*)" q1_next = ", tasks[q1_next]->q1_next,
-                           (S8*)" q1_prev = ", tasks[q1_next]->q1_prev,
-                           MESSAGE_OP_DEBUG );
+            MESS_OUT_DEBUG( MESS_OUT_message_4( (S8*)"Task", q1_next,
+                                           (S8*)" priority = ", ctx->tasks[q1_next]->priority,
+                                           (S8*)" q1_next = ", ctx->tasks[q1_next]->q1_next,
+                                           (S8*)" q1_prev = ", ctx->tasks[q1_next]->q1_prev,
+                                           MESSAGE_OP_DEBUG ) );
         }
-        else if( algorithm is ALG_ADAP_07 )
+        else if( ctx->algorithm is ALG_ADAP_07 )
         {
-            MESS_OUT_message_4( (S8*)"Task", q1_next,
-                           (S8*)" e-priority = ", tasks[q1_next]->e_priority,
-                           (S8*)" q1_next = ", tasks[q1_next]->q1_next,
-                           (S8*)" q1_prev = ", tasks[q1_next]->q1_prev,
-                           MESSAGE_OP_DEBUG );
+            MESS_OUT_DEBUG( MESS_OUT_message_4( (S8*)"Task", q1_next,
+                                           (S8*)" e-priority = ", ctx->tasks[q1_next]->e_priority,
+                                           (S8*)" q1_next = ", ctx->tasks[q1_next]->q1_next,
+                                           (S8*)" q1_prev = ", ctx->tasks[q1_next]->q1_prev,
+                                           MESSAGE_OP_DEBUG ) );
         }
         else
         {
-            MESS_OUT_message_2( (S8*)"Task", q1_next,
-                           (S8*)" priority = ", tasks[q1_next]->priority,
-                           MESSAGE_OP_DEBUG);
+            MESS_OUT_DEBUG( MESS_OUT_message_2( (S8*)"Task", q1_next,
+                                           (S8*)" priority = ", ctx->tasks[q1_next]->priority,
+                                           MESSAGE_OP_DEBUG) );
         }
 
-        q1_next = tasks[q1_next]->q1_next;
+        q1_next = ctx->tasks[q1_next]->q1_next;
     }
 
 } 
@@ -3244,7 +3926,7 @@ static void q1_dump( const struct task_type *header )
 *  Description : private debug helper - dumps task parameters
 ******************************************************************************/
 #if(0)
-static void task_params( void )
+static void task_params( struct sim_context_type *ctx )
 {
     U8 index;
 
@@ -3252,30 +3934,30 @@ static void task_params( void )
     MESS_OUT_message( (S8*)"            ======  ======  ======  ======  ======  ======  ======\n", MESSAGE_OP_INFO );
 
     OPR_task_report( "Abs Dline ",
-                     (U32)tasks[ONE_CPV  ]->abs_dline,
-                     (U32)tasks[TWO_CPV  ]->abs_dline,
-                     (U32)tasks[THREE_CPV]->abs_dline,
-                     (U32)tasks[FOUR_CPV ]->abs_dline,
-                     (U32)tasks[FIVE_CPV ]->abs_dline,
-                     (U32)tasks[SIX_CPV  ]->abs_dline,
-                     (U32)tasks[SEVEN_CPV]->abs_dline );
+                     (U32)ctx->tasks[ONE_CPV  ]->abs_dline,
+                     (U32)ctx->tasks[TWO_CPV  ]->abs_dline,
+                     (U32)ctx->tasks[THREE_CPV]->abs_dline,
+                     (U32)ctx->tasks[FOUR_CPV ]->abs_dline,
+                     (U32)ctx->tasks[FIVE_CPV ]->abs_dline,
+                     (U32)ctx->tasks[SIX_CPV  ]->abs_dline,
+                     (U32)ctx->tasks[SEVEN_CPV]->abs_dline );
 
     OPR_task_report( "q0_prev   ",
-                     (U32)tasks[ONE_CPV  ]->q0_prev,
-                     (U32)tasks[TWO_CPV  ]->q0_prev,
-                     (U32)tasks[THREE_CPV]->q0_prev,
-                     (U32)tasks[FOUR_CPV ]->q0_prev,
-                     (U32)tasks[FIVE_CPV ]->q0_prev,
-                     (U32)tasks[SIX_CPV  ]->q0_prev,
-                     (U32)tasks[SEVEN_CPV]->q0_prev );
+                     (U32)ctx->tasks[ONE_CPV  ]->q0_prev,
+                     (U32)ctx->tasks[TWO_CPV  ]->q0_prev,
+                     (U32)ctx->tasks[THREE_CPV]->q0_prev,
+                     (U32)ctx->tasks[FOUR_CPV ]->q0_prev,
+                     (U32)ctx->tasks[FIVE_CPV ]->q0_prev,
+                     (U32)ctx->tasks[SIX_CPV  ]->q0_prev,
+                     (U32)ctx->tasks[SEVEN_CPV]->q0_prev );
 
     OPR_task_report( "q0_next   ",
-                     (U32)tasks[ONE_CPV  ]->q0_next,
-                     (U32)tasks[TWO_CPV  ]->q0_next,
-                     (U32)tasks[THREE_CPV]->q0_next,
-                     (U32)tasks[FOUR_CPV ]->q0_next,
-                     (U32)tasks[FIVE_CPV ]->q0_next,
-                     (U32)tasks[SIX_CPV  ]->q0_next,
-                     (U32)tasks[SEVEN_CPV]->q0_next );
+                     (U32)ctx->tasks[ONE_CPV  ]->q0_next,
+                     (U32)ctx->tasks[TWO_CPV  ]->q0_next,
+                     (U32)ctx->tasks[THREE_CPV]->q0_next,
+                     (U32)ctx->tasks[FOUR_CPV ]->q0_next,
+                     (U32)ctx->tasks[FIVE_CPV ]->q0_next,
+                     (U32)ctx->tasks[SIX_CPV  ]->q0_next,
+                     (U32)ctx->tasks[SEVEN_CPV]->q0_next );
 } 
 #endif
@@ -23,6 +23,15 @@
 * 25-06-05 |JRO| Added ALG_ADAP_01 & ALG_ADAP_02 scheduler                    *
 * 26-06-05 |JRO| Added ALG_ADAP_03 & ALG_ADAP_04 scheduler                    *
 * 15-07-05 |JRO| Added ALG_ADAP_05 & ALG_ADAP_06 scheduler                    *
+* 17-10-26 |JRO| Added SCH_next_event()                                       *
+* 17-10-26 |JRO| Entry points take a simulation context                       *
+* 17-10-26 |JRO| Added SCH_toggle_ready_queue() and SCH_close()               *
+* 17-10-26 |JRO| Added SCH_toggle_release_queues()                            *
+* 17-10-26 |JRO| Added SCH_muf_urgency()                                      *
+* 17-10-26 |JRO| Added SCH_utility_stale()                                    *
+* 17-10-26 |JRO| Added SCH_SINGLE_ALGORITHM single algorithm build            *
+* 17-10-26 |JRO| Added SCH_PROFILE phase profiling build option               *
+* 17-10-26 |JRO| Added SCH_queue_task() and SCH_algorithm_supported()         *
 *          |   |                                                              *
 *                                                                             *
 ******************************************************************************/
@@ -31,45 +40,160 @@
 
 #include "messages_out.h"
 
+/* algorithm numbers, for the preprocessor */
+#define SCH_NUM_CYC         0
+#define SCH_NUM_RR          1
+#define SCH_NUM_RM          2
+#define SCH_NUM_IRM         3
+#define SCH_NUM_DRM         4
+#define SCH_NUM_EDF         5
+#define SCH_NUM_SPT         6
+#define SCH_NUM_LLF         7
+#define SCH_NUM_MLLF        8
+#define SCH_NUM_MUF         9
+#define SCH_NUM_MMUF        10
+#define SCH_NUM_MMMUF       11
+#define SCH_NUM_D_STAR      12
+#define SCH_NUM_DD_STAR     13
+#define SCH_NUM_D_OVER      14
+#define SCH_NUM_RM_RTO      15
+#define SCH_NUM_EDF_RTO     16
+#define SCH_NUM_EDF_BWP     17
+#define SCH_NUM_ADAP_01     18
+#define SCH_NUM_ADAP_02     19
+#define SCH_NUM_ADAP_03     20
+#define SCH_NUM_ADAP_04     21
+#define SCH_NUM_ADAP_05     22
+#define SCH_NUM_ADAP_06     23
+#define SCH_NUM_ADAP_07     24
+
 /* scheduler algorithms */
 typedef enum
 {
-	ALG_CYC,     /* cyclic executive                        */
-	ALG_RR,      /* round robin                             */
-	ALG_RM,      /* rate monotonic                          */
-	ALG_IRM,     /* intelligent rate monotonic              */
-	ALG_DRM,     /* delayed rate monotonic                  */
-	ALG_EDF,     /* earliest deadline first                 */
-	ALG_SPT,     /* shortest processing time                */
-	ALG_LLF,     /* least laxity first                      */
-	ALG_MLLF,    /* modified leat laxity first              */
-	ALG_MUF,     /* maximum urgency first                   */
-	ALG_MMUF,    /* modified maximum urgency first          */
-	ALG_MMMUF,   /* modified modified maximum urgency first */
-	ALG_D_STAR,  /* D* algorithm                            */
-	ALG_DD_STAR, /* DD* algorithm                           */
-	ALG_D_OVER,  /* Dover algorithm                         */
-	ALG_RM_RTO,  /* RM red task only                        */
-	ALG_EDF_RTO, /* EDF red task only                       */
-	ALG_EDF_BWP, /* EDF blue when possible                  */
-	ALG_ADAP_01, /* Adaptive algorithm Number One           */
-	ALG_ADAP_02, /* Adaptive algorithm Number Two           */
-	ALG_ADAP_03, /* Adaptive algorithm Number Three         */
-	ALG_ADAP_04, /* Adaptive algorithm Number Four          */
-	ALG_ADAP_05, /* Adaptive algorithm Number Five          */
-	ALG_ADAP_06, /* Adaptive algorithm Number Six           */
-	ALG_ADAP_07, /* Adaptive algorithm Number Seven         */
+	ALG_CYC = SCH_NUM_CYC,         /* cyclic executive                        */
+	ALG_RR = SCH_NUM_RR,           /* round robin                             */
+	ALG_RM = SCH_NUM_RM,           /* rate monotonic                          */
+	ALG_IRM = SCH_NUM_IRM,         /* intelligent rate monotonic              */
+	ALG_DRM = SCH_NUM_DRM,         /* delayed rate monotonic                  */
+	ALG_EDF = SCH_NUM_EDF,         /* earliest deadline first                 */
+	ALG_SPT = SCH_NUM_SPT,         /* shortest processing time                */
+	ALG_LLF = SCH_NUM_LLF,         /* least laxity first                      */
+	ALG_MLLF = SCH_NUM_MLLF,       /* modified leat laxity first              */
+	ALG_MUF = SCH_NUM_MUF,         /* maximum urgency first                   */
+	ALG_MMUF = SCH_NUM_MMUF,       /* modified maximum urgency first          */
+	ALG_MMMUF = SCH_NUM_MMMUF,     /* modified modified maximum urgency first */
+	ALG_D_STAR = SCH_NUM_D_STAR,   /* D* algorithm                            */
+	ALG_DD_STAR = SCH_NUM_DD_STAR, /* DD* algorithm                           */
+	ALG_D_OVER = SCH_NUM_D_OVER,   /* Dover algorithm                         */
+	ALG_RM_RTO = SCH_NUM_RM_RTO,   /* RM red task only                        */
+	ALG_EDF_RTO = SCH_NUM_EDF_RTO, /* EDF red task only                       */
+	ALG_EDF_BWP = SCH_NUM_EDF_BWP, /* EDF blue when possible                  */
+	ALG_ADAP_01 = SCH_NUM_ADAP_01, /* Adaptive algorithm Number One           */
+	ALG_ADAP_02 = SCH_NUM_ADAP_02, /* Adaptive algorithm Number Two           */
+	ALG_ADAP_03 = SCH_NUM_ADAP_03, /* Adaptive algorithm Number Three         */
+	ALG_ADAP_04 = SCH_NUM_ADAP_04, /* Adaptive algorithm Number Four          */
+	ALG_ADAP_05 = SCH_NUM_ADAP_05, /* Adaptive algorithm Number Five          */
+	ALG_ADAP_06 = SCH_NUM_ADAP_06, /* Adaptive algorithm Number Six           */
+	ALG_ADAP_07 = SCH_NUM_ADAP_07, /* Adaptive algorithm Number Seven         */
 	ALG_MAX_ALG
 } algorithm_type;
 
-void SCH_init( void );
-void SCH_soft_reset( void );
-void SCH_start( const U32 timeval );
-void SCH_add_task( const U8 task_id, const U8 test_task_id );
-void SCH_set_algorithm( const algorithm_type alg );
+/* Single algorithm build. SCH_SINGLE_ALGORITHM may be set on the command
+   line to one of the SCH_NUM_ values, e.g. -DSCH_SINGLE_ALGORITHM=SCH_NUM_EDF,
+   and the scheduler is then built for that algorithm alone: the policy is
+   a constant, and queues only other algorithms use are left out. */
+#ifdef SCH_SINGLE_ALGORITHM
+    #define SCH_ALG_BUILT(n)   ( (n) == SCH_SINGLE_ALGORITHM )
+#else
+    #define SCH_ALG_BUILT(n)   ( 1 )
+#endif
+
+/* doubled periods queue, used by adaptive algorithms 2 to 7 */
+#define SCH_DOUBLED_QUEUE  (    SCH_ALG_BUILT(SCH_NUM_ADAP_02)     \
+                             || SCH_ALG_BUILT(SCH_NUM_ADAP_03)     \
+                             || SCH_ALG_BUILT(SCH_NUM_ADAP_04)     \
+                             || SCH_ALG_BUILT(SCH_NUM_ADAP_05)     \
+                             || SCH_ALG_BUILT(SCH_NUM_ADAP_06)     \
+                             || SCH_ALG_BUILT(SCH_NUM_ADAP_07) )
+
+/* least slack time queue, used by adaptive algorithms 5 and 6 */
+#define SCH_LST_QUEUE      (    SCH_ALG_BUILT(SCH_NUM_ADAP_05)     \
+                             || SCH_ALG_BUILT(SCH_NUM_ADAP_06) )
+
+/* Phase profiling. Build with -DSCH_PROFILE=1 to time each phase of
+   SCH_start() and count its queue inserts and extracts, reported at the
+   end of test. Left at 0 the profiling is not compiled in at all. */
+#ifndef SCH_PROFILE
+    #define SCH_PROFILE  0
+#endif
+
+#if SCH_PROFILE
+/* SCH_start() phases */
+typedef enum
+{
+    SCH_PHASE_WAITING,      /* process_waiting_tasks()          */
+    SCH_PHASE_COMPLETED,    /* process_completed_tasks()        */
+    SCH_PHASE_REMOVED,      /* process_removed_tasks()          */
+    SCH_PHASE_DOUBLED,      /* policy doubled periods step      */
+    SCH_PHASE_SKIPPED,      /* policy skipped tasks step        */
+    SCH_PHASE_IDLE,         /* process_idle_tasks()             */
+    SCH_PHASE_READY,        /* process_ready_tasks(), dispatch  */
+    SCH_PHASE_OTHER,        /* outside SCH_start(), task loads  */
+    SCH_PHASE_MAX
+}sch_prof_phase_type;
+
+/* scheduler queues */
+typedef enum
+{
+    SCH_QUEUE_READY,
+    SCH_QUEUE_IDLE,
+    SCH_QUEUE_WAITING,
+    SCH_QUEUE_SKIPPED,
+    SCH_QUEUE_REMOVED,
+    SCH_QUEUE_DOUBLED,
+    SCH_QUEUE_LST,
+    SCH_QUEUE_MAX
+}sch_queue_type;
+
+/* profile of one phase */
+struct sch_phase_profile_type
+{
+    U32 calls;                      /* times the phase ran            */
+    U32 time;                       /* total time, CLK_ clock units   */
+    U32 inserts[SCH_QUEUE_MAX];     /* queue inserts                  */
+    U32 extracts[SCH_QUEUE_MAX];    /* queue extracts                 */
+};
+
+/* profile of a simulation run */
+struct sch_profile_type
+{
+    struct sch_phase_profile_type phases[SCH_PHASE_MAX];
+    sch_prof_phase_type phase;      /* phase running                  */
+};
+#endif /* SCH_PROFILE */
+
+/* simulation context, see context.h */
+struct sim_context_type;
+
+void SCH_init( struct sim_context_type *ctx );
+void SCH_soft_reset( struct sim_context_type *ctx );
+void SCH_start( struct sim_context_type *ctx, const U32 timeval );
+void SCH_add_task( struct sim_context_type *ctx, const task_id_type task_id, const U8 test_task_id );
+void SCH_queue_task( struct sim_context_type *ctx, const task_id_type task_id );
+void SCH_set_algorithm( struct sim_context_type *ctx, const algorithm_type alg );
+boolean SCH_algorithm_supported( const algorithm_type alg );
 void SCH_report_algorithm( const algorithm_type a, const message_class class );
-void SCH_what_algorithm( const message_class class );
-algorithm_type SCH_get_algorithm( void );
-void SCH_reset_queues( void );
+void SCH_what_algorithm( struct sim_context_type *ctx, const message_class class );
+algorithm_type SCH_get_algorithm( struct sim_context_type *ctx );
+void SCH_reset_queues( struct sim_context_type *ctx );
+U32 SCH_next_event( struct sim_context_type *ctx, const U32 timeval );
+void SCH_toggle_ready_queue( struct sim_context_type *ctx );
+void SCH_toggle_release_queues( struct sim_context_type *ctx );
+U32 SCH_muf_urgency( struct sim_context_type *ctx, const task_id_type task, const U32 laxity );
+void SCH_utility_stale( struct sim_context_type *ctx, const task_id_type task );
+void SCH_close( struct sim_context_type *ctx );
+#if SCH_PROFILE
+void SCH_profile_report( struct sim_context_type *ctx );
+#endif
 
 #endif /* _SCHEDULER_H_ */
@@ -0,0 +1,308 @@
+/******************************************************************************
+*                                                                             *
+*                                                                             *
+*                                                                             *
+*******************************************************************************
+*                                                                             *
+* Project     :   SCHEDULER SIMULATOR
+*                                                                             *
+* File Name   :  sweep.c                                                      *
+*                                                                             *
+* Description :  Parallel sweep of a range of test cases (PC build only).     *
+*                Test cases are dealt round robin onto the job queues of a    *
+*                pool of worker threads. A worker takes jobs from the front   *
+*                of its own queue, and once that is empty steals from the     *
+*                back of the other queues, so long test cases do not hold up  *
+*                the whole sweep. Each test case runs in its own simulation   *
+*                context and writes its own "Test case nnn.txt" trace. When   *
+*                all workers have finished, the end of test reports are       *
+*                merged, in test case order, into one results file.          *
+*                                                                             *
+*******************************************************************************
+* Modification record:                                                        *
+*                                                                             *
+* Date     |Who| Description                                                  *
+* 17-10-26 |JRO| Created                                                      *
+* 17-10-26 |JRO| Task tables freed once the reports are merged                *
+* 17-10-26 |JRO| Follows the terminal's ready queue selection                 *
+* 17-10-26 |JRO| Follows the terminal's idle and waiting queue selection      *
+*          |   |                                                              *
+*                                                                             *
+******************************************************************************/
+#include "globals.h"
+#include "messages_out.h"
+#include "task.h"          /* task object                   */
+#include "scheduler.h"     /* main scheduler                */
+#include "test.h"          /* test manager                  */
+#include "test_case.h"     /* test case container           */
+#include "context.h"       /* simulation context            */
+#include "sweep.h"         /* interface file                */
+
+#ifndef DEV_SYSTEM
+	/*lint -e85 has dimension 0 */
+    #include <stdio.h>     /* gcc output libraries          */
+	/*lint +e85 has dimension 0 */
+    #include <pthread.h>   /* worker threads                */
+
+/* job queue, one per worker */
+struct job_queue_type
+{
+    pthread_mutex_t lock;                    /* protects the queue        */
+    U8              jobs[MAX_TEST_CASES];    /* test case numbers         */
+    U32             head;                    /* next job for owner        */
+    U32             tail;                    /* one past the last job     */
+};
+
+static const S8* sweep_name = (S8*)"Sweep results.txt";
+
+static struct job_queue_type   job_queues[SWP_NUM_WORKERS];
+static struct sim_context_type sweep_contexts[MAX_TEST_CASES];
+static U32                     worker_ids[SWP_NUM_WORKERS];
+
+/******************************************************************************
+*  PRIVATE FUNCTION PROTOTYPES
+******************************************************************************/
+static void *worker( void *arg );
+static boolean get_job( const U32 worker_id, U8 *test_case );
+static void run_test_case( const U8 test_case );
+static void merge_reports( const U8 start_test_case, const U8 stop_test_case );
+
+#endif /* DEV_SYSTEM */
+
+
+/******************************************************************************
+*                              PUBLIC FUNCTIONS
+******************************************************************************/
+
+
+/******************************************************************************
+*  Function    : SWP_sweep
+*  Description : runs test cases start_test_case up to (but not including)
+*                stop_test_case on the worker pool, then writes the merged
+*                report
+*  Parameters  : start_test_case - first test case
+*                stop_test_case  - test case to stop at
+*  Returns     : none
+******************************************************************************/
+void SWP_sweep( const U8 start_test_case, const U8 stop_test_case )
+{
+#ifndef DEV_SYSTEM
+    pthread_t threads[SWP_NUM_WORKERS];
+    U32 index;
+    U32 started;
+    U8  test_case;
+
+    MESS_OUT_message_2( (S8*)"Sweeping test cases from", start_test_case,
+                        (S8*)"to", stop_test_case - ONE_CPV,
+                        MESSAGE_OP_LOG );
+
+    /* deal the test cases round robin onto the job queues */
+    for( index=ZERO_CPV; index<SWP_NUM_WORKERS; index++ )
+    {
+        (void)pthread_mutex_init( &job_queues[index].lock, NULL );
+        job_queues[index].head = ZERO_CPV;
+        job_queues[index].tail = ZERO_CPV;
+        worker_ids[index]      = index;
+    }
+
+    index = ZERO_CPV;
+    for( test_case=start_test_case; test_case<stop_test_case; test_case++ )
+    {
+        job_queues[index].jobs[job_queues[index].tail] = test_case;
+        job_queues[index].tail++;
+
+        index = (index + ONE_CPV) % SWP_NUM_WORKERS;
+    }
+
+    /* start the pool */
+    started = ZERO_CPV;
+    for( index=ZERO_CPV; index<SWP_NUM_WORKERS; index++ )
+    {
+        if( pthread_create( &threads[index], NULL, worker, &worker_ids[index] ) is ZERO_CPV )
+        {
+            started++;
+        }
+        else
+        {
+            MESS_OUT_message_1( (S8*)"SWP_sweep(): unable to start worker",
+                                index,
+                                MESSAGE_OP_ERROR );
+        }
+    }
+
+    if( started is ZERO_CPV )
+    {
+        /* no pool - run the lot on this thread */
+        (void)worker( &worker_ids[ZERO_CPV] );
+    }
+
+    /* wait for the pool to drain */
+    for( index=ZERO_CPV; index<started; index++ )
+    {
+        (void)pthread_join( threads[index], NULL );
+    }
+
+    for( index=ZERO_CPV; index<SWP_NUM_WORKERS; index++ )
+    {
+        (void)pthread_mutex_destroy( &job_queues[index].lock );
+    }
+
+    merge_reports( start_test_case, stop_test_case );
+
+    for( test_case=start_test_case; test_case<stop_test_case; test_case++ )
+    {
+        TSK_close( &sweep_contexts[test_case] );
+        SCH_close( &sweep_contexts[test_case] );
+    }
+
+    MESS_OUT_message_S2( (S8*)"Sweep complete, results in",
+                         sweep_name,
+                         MESSAGE_OP_LOG );
+#endif
+
+} /* SWP_sweep() */
+
+
+/******************************************************************************
+*                            PRIVATE FUNCTIONS
+******************************************************************************/
+
+#ifndef DEV_SYSTEM
+
+/******************************************************************************
+*  Function    : worker
+*  Description : private helper - worker thread, runs test cases until there
+*                are no jobs left on any queue
+*  Parameters  : arg - pointer to worker id
+*  Returns     : NULL
+******************************************************************************/
+static void *worker( void *arg )
+{
+    const U32 worker_id = *(U32*)arg;
+    U8 test_case;
+
+    while( get_job( worker_id, &test_case ) is TRUE )
+    {
+        run_test_case( test_case );
+    }
+
+    return( NULL );
+
+} /* worker() */
+
+
+/******************************************************************************
+*  Function    : get_job
+*  Description : private helper - takes the next job from the front of the
+*                worker's own queue, or failing that steals one from the
+*                back of another worker's queue
+*  Parameters  : worker_id - worker looking for a job
+*                test_case - returned test case number
+*  Returns     : TRUE if a job was found, FALSE once all queues are empty
+******************************************************************************/
+static boolean get_job( const U32 worker_id, U8 *test_case )
+{
+    struct job_queue_type *queue;
+    boolean found = FALSE;
+    U32 count;
+
+    /* own queue first, then the others in turn */
+    for( count=ZERO_CPV; (count<SWP_NUM_WORKERS)and(found is FALSE); count++ )
+    {
+        queue = &job_queues[(worker_id + count) % SWP_NUM_WORKERS];
+
+        (void)pthread_mutex_lock( &queue->lock );
+
+        if( queue->head < queue->tail )
+        {
+            if( count is ZERO_CPV )
+            {
+                /* own queue - take from the front */
+                *test_case = queue->jobs[queue->head];
+                queue->head++;
+            }
+            else
+            {
+                /* steal from the back */
+                queue->tail--;
+                *test_case = queue->jobs[queue->tail];
+            }
+            found = TRUE;
+        }
+
+        (void)pthread_mutex_unlock( &queue->lock );
+    }
+
+    return( found );
+
+} /* get_job() */
+
+
+/******************************************************************************
+*  Function    : run_test_case
+*  Description : private helper - loads and runs one test case in its own
+*                simulation context, writing the trace to the test case
+*                results file
+*  Parameters  : test_case - test case number
+*  Returns     : none
+******************************************************************************/
+static void run_test_case( const U8 test_case )
+{
+    struct sim_context_type *ctx = &sweep_contexts[test_case];
+    S8 file_name[MAX_NAME_LEN];
+
+    /* queues as selected at the terminal, set before the reset */
+    ctx->ready_q_kind   = sim_context.ready_q_kind;
+    ctx->release_q_kind = sim_context.release_q_kind;
+
+    /* fresh context */
+    TST_new_test( ctx, test_case );
+
+    /* follow the terminal's simulation settings */
+    ctx->event_mode = sim_context.event_mode;
+
+    /* results file is per thread */
+    sprintf( file_name, "Test case %03d.txt", test_case );
+    MESS_OUT_rename_results_file( file_name );
+
+    MESS_OUT_message( (S8*)"Test case:", MESSAGE_OP_RESULTS );
+    TSC_report_test_case( test_case, MESSAGE_OP_RESULTS );
+
+    TSK_start_of_test( ctx );       /* warn task object             */
+
+    TST_run_simulation( ctx );      /* run to the end of the test   */
+
+    TSK_end_of_test( ctx );         /* end of test reports          */
+
+} /* run_test_case() */
+
+
+/******************************************************************************
+*  Function    : merge_reports
+*  Description : private helper - writes the end of test reports of all the
+*                swept test cases to the sweep results file, in test case
+*                order
+*  Parameters  : start_test_case - first test case
+*                stop_test_case  - test case to stop at
+*  Returns     : none
+******************************************************************************/
+static void merge_reports( const U8 start_test_case, const U8 stop_test_case )
+{
+    U8 test_case;
+
+    /* start a new file */
+    (void)remove( sweep_name );
+    MESS_OUT_rename_results_file( sweep_name );
+
+    for( test_case=start_test_case; test_case<stop_test_case; test_case++ )
+    {
+        MESS_OUT_message( (S8*)"\n\nTest case:", MESSAGE_OP_RESULTS );
+        TSC_report_test_case( test_case, MESSAGE_OP_RESULTS );
+        TSC_report_test_case_notes( test_case );
+
+        TSK_end_of_test( &sweep_contexts[test_case] );
+    }
+
+} /* merge_reports() */
+
+#endif /* DEV_SYSTEM */
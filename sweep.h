@@ -0,0 +1,28 @@
+/******************************************************************************
+*                                                                             *
+*                                                                             *
+*                                                                             *
+*******************************************************************************
+*                                                                             *
+* Project     :   SCHEDULER SIMULATOR
+*                                                                             *
+* File Name   :  sweep.h                                                      *
+*                                                                             *
+* Description :  Interface file for sweep.c                                   *
+*                                                                             *
+*******************************************************************************
+* Modification record:                                                        *
+*                                                                             *
+* Date     |Who| Description                                                  *
+* 17-10-26 |JRO| Created                                                      *
+*          |   |                                                              *
+*                                                                             *
+******************************************************************************/
+#ifndef _SWEEP_H_
+#define _SWEEP_H_
+
+#define SWP_NUM_WORKERS     4     /* worker threads in the sweep pool */
+
+void SWP_sweep( const U8 start_test_case, const U8 stop_test_case );
+
+#endif /* _SWEEP_H_ */
@@ -28,6 +28,15 @@
 * 25-06-05 |JRO| Added ALG_ADAP_01 & ALG_ADAP_02 scheduler                    *
 * 26-06-05 |JRO| Added ALG_ADAP_03 & ALG_ADAP_04 scheduler                    *
 * 15-07-05 |JRO| Added ALG_ADAP_05 & ALG_ADAP_06 scheduler                    *
+* 17-10-26 |JRO| Added TSK_run_task_cycles() for event driven time advance    *
+* 17-10-26 |JRO| Task table sized per test case, reports loop over N tasks    *
+* 17-10-26 |JRO| Task ids widened to task_id_type                             *
+* 17-10-26 |JRO| Calculated duration change marks task utility stale          *
+* 17-10-26 |JRO| Statistics and spare constants moved to ctx->task_stats[]    *
+* 17-10-26 |JRO| Results and log files written out at the end of test         *
+* 17-10-26 |JRO| Task report codes shared with the binary trace, see trace.c  *
+* 17-10-26 |JRO| Debug and verbose messages through MESS_OUT_DEBUG/VERBOSE    *
+* 17-10-26 |JRO| Added TSK_set_task() to load a task from any task data       *
 *          |   |                                                              *
 *                                                                             *
 ******************************************************************************/
@@ -38,16 +47,18 @@
 #include "rt_clock.h"           /* real time clock timer        */
 #include "test.h" 
 
+#ifndef DEV_SYSTEM
+#include <stdlib.h>             /* task table allocation        */
+#endif
+
 #ifdef DEV_SYSTEM    /* CONDITIONAL COMPILE - Keil Development System */
 #include "led_controller.h"     /* led output                   */
 #endif  /* DEV_SYSTEM */
 
+#include "trace.h"              /* trace formats                */
 #include "task.h"				/* interface file               */
 #include "task_data.h"    		/* task data base               */
-
-U8 running_task_id;
-
-static boolean task_error; 
+#include "context.h"            /* simulation context           */
 
 #if(0)
 /* initialisation of test task data array */
@@ -186,17 +197,51 @@ static struct task_type test_tasks[MAX_TEST_TASKS] =
 };
 #endif
 
-/* initialisation of running tasks data array */
-struct task_type *tasks[NUM_OF_TASKS];
-static struct task_type task_array[NUM_OF_TASKS];     
+#ifdef DEV_SYSTEM
+/* fixed task table storage for the development system */
+static struct task_type  dev_task_array[NUM_OF_TASKS];
+static struct task_type *dev_tasks[NUM_OF_TASKS];
+static struct task_stats_type dev_task_stats[NUM_OF_TASKS];
+static S8                dev_report_line[(NUM_OF_TASKS * TSK_REPORT_WORD_SIZE) + ONE_CPV];
+#endif
+
+/* task report table rows */
+typedef enum
+{
+    RPT_PRIORITY,
+    RPT_RELEASE,
+    RPT_DURATION,
+    RPT_DEADLINE,
+    RPT_PERIOD,
+    RPT_PREEMPT,
+    RPT_SKIP_GAP,
+    RPT_MUF_CRITICAL,
+    RPT_PERIOD_FLEXIBLE,
+    RPT_UTIL,
+    RPT_DLINES_MET,
+    RPT_DLINES_MISSED,
+    RPT_PER_DOUBLES,
+    RPT_PRE_COUNT,
+    RPT_TOTAL_SKIPS,
+    RPT_VALUE
+}report_row_type;
 
 /* private function prototypes */
-static void send_report( const U32 timeval );
-static void build_task_report_word( const U32 timeval,
-                                    const U8 task_num,
-                                    S8 *r_word ); 
+static void send_report( struct sim_context_type *ctx, const U32 timeval );
+static U8 task_report_code( struct sim_context_type *ctx, const U32 timeval,
+                            const U32 task_num );
 static void reset_task_parameters( struct task_type* task );
+static void reset_task_stats( struct task_stats_type* stats );
 static void reset_task_computed_parameters( void );
+static void report_header( const S8 *indent, const U32 first, const U32 last );
+static void report_row( struct sim_context_type *ctx, const S8 *param,
+                        const report_row_type row,
+                        const U32 first, const U32 last );
+static U32 report_value( struct sim_context_type *ctx, const U32 task,
+                         const report_row_type row );
+#ifndef DEV_SYSTEM
+static boolean grow_task_table( struct sim_context_type *ctx, const U32 slots );
+#endif
 
  
 /******************************************************************************
@@ -207,24 +252,44 @@ static void reset_task_computed_parameters( void );
 /******************************************************************************
 *  Function    : TSK_init
 *  Description : initialises task object
-*  Parameters  : none
+*  Parameters  : ctx - simulation context
 *  Returns     : none
 ******************************************************************************/
-void TSK_init( void )
+void TSK_init( struct sim_context_type *ctx )
 {
+    #ifdef DEV_SYSTEM
     U16 index;
-    
+    #endif
+
     /* clear running task id */
-    running_task_id = ZERO_CPV;
+    ctx->running_task_id = ZERO_CPV;
 
-	/* dereference the task structure pointers */
-	for( index=0; index<NUM_OF_TASKS; index++ )
-	{
-		tasks[index] = &task_array[index];
-	}
+    /* first use of the context - set up the default task table */
+    if( ctx->task_array is NULL )
+    {
+        #ifdef DEV_SYSTEM
+        ctx->task_array  = dev_task_array;
+        ctx->tasks       = dev_tasks;
+        ctx->task_stats  = dev_task_stats;
+        ctx->report_line = dev_report_line;
+        ctx->max_tasks   = NUM_OF_TASKS - ONE_CPV;
+
+        /* dereference the task structure pointers */
+        for( index=0; index<NUM_OF_TASKS; index++ )
+        {
+            ctx->tasks[index] = &ctx->task_array[index];
+            reset_task_parameters( ctx->tasks[index] );
+            reset_task_stats( &ctx->task_stats[index] );
+        }
+        #else
+        (void)grow_task_table( ctx, NUM_OF_TASKS );
+        #endif
+
+        ctx->num_tasks = NUM_OF_TASKS - ONE_CPV;
+    }
 
     /* clear task error flag */
-    task_error = FALSE;
+    ctx->task_error = FALSE;
 
 } /* TSK_init() */
 
@@ -235,24 +300,89 @@ void TSK_init( void )
 *  Parameters  : none
 *  Returns     : none
 ******************************************************************************/
-void TSK_close( void )
+void TSK_close( struct sim_context_type *ctx )
 {
+    #ifndef DEV_SYSTEM
+    free( ctx->task_array );
+    free( ctx->tasks );
+    free( ctx->task_stats );
+    free( ctx->report_line );
+
+    ctx->task_array  = NULL;
+    ctx->tasks       = NULL;
+    ctx->task_stats  = NULL;
+    ctx->report_line = NULL;
+    ctx->max_tasks   = ZERO_CPV;
+    ctx->num_tasks   = ZERO_CPV;
+    #endif
 
 } /* TSK_close() */
 
 
+/******************************************************************************
+*  Function    : TSK_size_task_table
+*  Description : sizes the task table for a task set of num_tasks tasks,
+*                growing it if needed, and clears all the task slots.
+*                Slot 0 is kept as the empty task, so tasks are numbered
+*                1 to num_tasks.
+*  Parameters  : ctx       - simulation context
+*                num_tasks - number of tasks in the task set
+*  Returns     : TRUE if the table is sized, FALSE if too many tasks
+******************************************************************************/
+boolean TSK_size_task_table( struct sim_context_type *ctx, const U32 num_tasks )
+{
+    boolean sized = TRUE;
+    U32 index;
+
+    if( num_tasks > TSK_MAX_TASKS )
+    {
+        MESS_OUT_message_2( (S8*)"TSK_size_task_table(): tasks requested",
+                            num_tasks,
+                            (S8*)"maximum",
+                            TSK_MAX_TASKS,
+                            MESSAGE_OP_ERROR );
+        sized = FALSE;
+    }
+    else if( num_tasks > ctx->max_tasks )
+    {
+        #ifndef DEV_SYSTEM
+        sized = grow_task_table( ctx, num_tasks + ONE_CPV );
+        #else
+        MESS_OUT_message_1( (S8*)"TSK_size_task_table(): too many tasks ",
+                            num_tasks,
+                            MESSAGE_OP_ERROR );
+        sized = FALSE;
+        #endif
+    }
+
+    if( sized is TRUE )
+    {
+        ctx->num_tasks = num_tasks;
+
+        for( index=ZERO_CPV; index<=num_tasks; index++ )
+        {
+            reset_task_parameters( ctx->tasks[index] );
+            reset_task_stats( &ctx->task_stats[index] );
+        }
+    }
+
+    return( sized );
+
+} /* TSK_size_task_table() */
+
+
 /******************************************************************************
 *  Function    : TSK_soft_reset
 *  Description : Soft reset of task object
-*  Parameters  : none
+*  Parameters  : ctx - simulation context
 *  Returns     : none
 ******************************************************************************/
-void TSK_soft_reset( void )
+void TSK_soft_reset( struct sim_context_type *ctx )
 {
     reset_task_computed_parameters();
 
     /* clear running task id */
-    running_task_id = ZERO_CPV;
+    ctx->running_task_id = ZERO_CPV;
 
 } /* TSK_soft_reset() */
 
@@ -262,32 +392,19 @@ void TSK_soft_reset( void )
 *  Description : Imports task data into local structure
 *  Parameters  : test_task_id  - test task index
 *				 pointer to task or NULL
+*                pointer to task statistics
 *  Returns     : None 
 ******************************************************************************/
-void TSK_add_task( const U8 task_id, struct task_type* task )
+void TSK_add_task( const U8 task_id, struct task_type* task, struct task_stats_type* stats )
 {
     /* sanity check on args */
     if( task_id < MAX_TEST_TASKS )
     {
-		 MESS_OUT_message_1( (S8*)"TSK_add_task(): loading test task ", 
-							 task_id,
-							 MESSAGE_OP_DEBUG );
-
-		 /* purge the structure */
-		 reset_task_parameters( task );	  
-
-		 /* load data */ 
-		 task->id        = stored_task_data[task_id].id;       
-		 task->release   = stored_task_data[task_id].release;     
-		 task->duration  = stored_task_data[task_id].duration; 
-		 task->rel_dline = stored_task_data[task_id].rel_dline;
-		 task->period    = stored_task_data[task_id].period;   
-		 task->priority  = stored_task_data[task_id].priority; 
-		 task->preempt   = stored_task_data[task_id].preempt;  
-		 task->spare_1   = stored_task_data[task_id].spare_1;  
-		 task->spare_2   = stored_task_data[task_id].spare_2;  
-		 task->spare_3   = stored_task_data[task_id].spare_3;  
-		 task->spare_4   = stored_task_data[task_id].spare_4;  
+		 MESS_OUT_DEBUG( MESS_OUT_message_1( (S8*)"TSK_add_task(): loading test task ", 
+							                 task_id,
+							                 MESSAGE_OP_DEBUG ) );
+
+		 TSK_set_task( &stored_task_data[task_id], task, stats );
     }
     else
     {
@@ -299,21 +416,53 @@ void TSK_add_task( const U8 task_id, struct task_type* task )
 } /* TSK_add_task() */
 
 
+/******************************************************************************
+*  Function    : TSK_set_task
+*  Description : Loads task data into local structure. Used for the stored
+*                test tasks, and for task sets made up at run time.
+*  Parameters  : data  - task data
+*				 pointer to task
+*                pointer to task statistics
+*  Returns     : None 
+******************************************************************************/
+void TSK_set_task( const struct stored_task_data_type *data, struct task_type* task, struct task_stats_type* stats )
+{
+    /* purge the structure */
+    reset_task_parameters( task );
+    reset_task_stats( stats );
+
+    /* load data */
+    task->id        = data->id;
+    stats->release  = data->release;
+    stats->duration = data->duration;
+    task->rel_dline = data->rel_dline;
+    task->period    = data->period;
+    task->priority  = data->priority;
+    stats->preempt  = data->preempt;
+    task->spare_1   = data->spare_1;
+    task->spare_2   = data->spare_2;
+    stats->spare_3  = data->spare_3;
+    stats->spare_4  = data->spare_4;
+
+} /* TSK_set_task() */
+
+
 /******************************************************************************
 *  Function    : TSK_add_task
 *  Description : Imports task data into local structure
-*  Parameters  : task_id       - working task index
+*  Parameters  : ctx     - simulation context
+*                task_id       - working task index
 *                test_task_id  - test task index
 *  Returns     : pointer to task or NULL
 ******************************************************************************/
-struct task_type *TSK_load_task( const U8 task_id, const U8 test_task_id )
+struct task_type *TSK_load_task( struct sim_context_type *ctx, const task_id_type task_id, const U8 test_task_id )
 {
-	if( (task_id < NUM_OF_TASKS) and (test_task_id < MAX_TEST_TASKS) )
+	if( (task_id <= ctx->num_tasks) and (test_task_id < MAX_TEST_TASKS) )
 	{
 #if(0)   
-		tasks[task_id] = &test_tasks[test_task_id];  /* copy pointer */
+		ctx->tasks[task_id] = &test_tasks[test_task_id];  /* copy pointer */
 #endif
-		return( tasks[task_id] );             /* return pointer */
+		return( ctx->tasks[task_id] );             /* return pointer */
 	}
 	else
 	{
@@ -321,7 +470,7 @@ struct task_type *TSK_load_task( const U8 task_id, const U8 test_task_id )
 			test_task_id, 
 			MESSAGE_OP_ERROR );
 
-		return( tasks[0] );             /* return pointer */
+		return( ctx->tasks[0] );             /* return pointer */
 	}
 
 } /* TSK_add_task() */
@@ -330,15 +479,17 @@ struct task_type *TSK_load_task( const U8 task_id, const U8 test_task_id )
 /******************************************************************************
 *  Function    : TSK_start_of_test
 *  Description : At start of test, prints headers, also for re-starting
-*  Parameters  : none
+*  Parameters  : ctx - simulation context
 *  Returns     : none
 ******************************************************************************/
-void TSK_start_of_test( void )
+void TSK_start_of_test( struct sim_context_type *ctx )
 {
-    /* print results header */
+    /* print results header, one column per task */
     MESS_OUT_message( (S8*)"\n\n", MESSAGE_OP_RESULTS );
-    MESS_OUT_message( (S8*)"TIME   TASK-1  TASK-2  TASK-3  TASK-4  TASK-5  TASK-6  TASK-7  TICKS   Err", MESSAGE_OP_RESULTS );
-    MESS_OUT_message( (S8*)"=====  ======  ======  ======  ======  ======  ======  ======  =====   ===", MESSAGE_OP_RESULTS );
+    MESS_OUT_task_header( (S8*)"TIME   ", ONE_CPV, ctx->num_tasks,
+                          (S8*)"  TICKS   Err", FALSE );
+    MESS_OUT_task_header( (S8*)"=====  ", ONE_CPV, ctx->num_tasks,
+                          (S8*)"  =====   ===", TRUE );
 
 } /* TSK_start_of_test() */
 
@@ -347,25 +498,26 @@ void TSK_start_of_test( void )
 *  Function    : TSK_run_task_cycle
 *  Description : executes a task, simulating work done by decrementing task
 *                time_left member
-*  Parameters  : timeval - system time, passes on to helper functions
+*  Parameters  : ctx     - simulation context
+*                timeval - system time, passes on to helper functions
 *  Returns     : none
 ******************************************************************************/
-void TSK_run_task_cycle( const U32 timeval )
+void TSK_run_task_cycle( struct sim_context_type *ctx, const U32 timeval )
 {
 
-    if( (running_task_id > ZERO_CPV) and (running_task_id < NUM_OF_TASKS) )
+    if( (ctx->running_task_id > ZERO_CPV) and (ctx->running_task_id <= ctx->num_tasks) )
     {
-        if( tasks[running_task_id]->time_left > ZERO_CPV )
+        if( ctx->tasks[ctx->running_task_id]->time_left > ZERO_CPV )
         {
-            tasks[running_task_id]->time_left --;  /* decrement running time */
-            tasks[running_task_id]->net_value ++;  /* increment net value    */
-            tasks[running_task_id]->time_taken ++; /* increment time taken   */
+            ctx->tasks[ctx->running_task_id]->time_left --; /* decrement running time */
+            ctx->tasks[ctx->running_task_id]->net_value ++; /* increment net value    */
+            ctx->tasks[ctx->running_task_id]->time_taken ++; /* increment time taken   */
         }
     }
-    else if( running_task_id >= NUM_OF_TASKS )
+    else if( ctx->running_task_id > ctx->num_tasks )
     {
         MESS_OUT_message_1( (S8*)"TSK_run_task_cycle() bad task number: ",
-                            running_task_id, 
+                            ctx->running_task_id, 
                             MESSAGE_OP_ERROR );
     }
     else
@@ -374,30 +526,79 @@ void TSK_run_task_cycle( const U32 timeval )
     }
 
     /* increment the time history */
-    TST_incr_test_report_value( TST_DURATION );
+    TST_incr_test_report_value( ctx, TST_DURATION );
 
     /* report task states to output */
-    send_report( timeval );
+    send_report( ctx, timeval );
 
 } /* TSK_run_task_cycle() */
 
 
+/******************************************************************************
+*  Function    : TSK_run_task_cycles
+*  Description : executes the running task for a number of ticks in one go,
+*                crediting time_left, time_taken and net_value in bulk. Used
+*                by the event driven simulation, which only calls this up to
+*                the next scheduling event so the task never runs past
+*                completion.
+*  Parameters  : ctx     - simulation context
+*                timeval - system time at the end of the run
+*                ticks   - number of ticks executed
+*  Returns     : none
+******************************************************************************/
+void TSK_run_task_cycles( struct sim_context_type *ctx, const U32 timeval, const U32 ticks )
+{
+    U32 run;
+
+    if( (ctx->running_task_id > ZERO_CPV) and (ctx->running_task_id <= ctx->num_tasks) )
+    {
+        /* clip the run to the work remaining */
+        run = ticks;
+        if( run > ctx->tasks[ctx->running_task_id]->time_left )
+        {
+            run = ctx->tasks[ctx->running_task_id]->time_left;
+        }
+
+        ctx->tasks[ctx->running_task_id]->time_left  -= run; /* decrement running time */
+        ctx->tasks[ctx->running_task_id]->net_value  += run; /* increment net value    */
+        ctx->tasks[ctx->running_task_id]->time_taken += run; /* increment time taken   */
+    }
+    else if( ctx->running_task_id > ctx->num_tasks )
+    {
+        MESS_OUT_message_1( (S8*)"TSK_run_task_cycles() bad task number: ",
+                            ctx->running_task_id, 
+                            MESSAGE_OP_ERROR );
+    }
+    else
+    {
+        /* do nothing */
+    }
+
+    /* increment the time history */
+    TST_add_test_report_value( ctx, TST_DURATION, ticks );
+
+    /* report task states at the event to output */
+    send_report( ctx, timeval );
+
+} /* TSK_run_task_cycles() */
+
+
 /******************************************************************************
 *  Function    : TSK_end_of_test
 *  Description : At middle of test loop, calls next test,
 *                at end of test, calls reports and does any clearing up
-*  Parameters  : none
+*  Parameters  : ctx - simulation context
 *  Returns     : none
 ******************************************************************************/
-void TSK_end_of_test( void )
+void TSK_end_of_test( struct sim_context_type *ctx )
 {
     /* report algorithm */
     MESS_OUT_message( (S8*)"\nAlgorithm:", MESSAGE_OP_RESULTS );
-    SCH_what_algorithm( MESSAGE_OP_RESULTS );
+    SCH_what_algorithm( ctx, MESSAGE_OP_RESULTS );
 
-    TSK_task_report();                   /* task report              */ 
-    TSK_task_results();                  /* task results             */
-    TST_test_report();                   /* request for test results */
+    TSK_task_report( ctx );              /* task report              */ 
+    TSK_task_results( ctx );             /* task results             */
+    TST_test_report( ctx );              /* request for test results */
 
     #ifndef DEV_SYSTEM
         /* report clock ticks per second*/
@@ -406,6 +607,9 @@ void TSK_end_of_test( void )
                             MESSAGE_OP_RESULTS );
     #endif
 
+    /* write out the buffered results */
+    MESS_OUT_flush();
+
 } /* TSK_end_of_test() */
 
 
@@ -413,148 +617,71 @@ void TSK_end_of_test( void )
 *  Function    : TSK_task_report
 *  Description : prints loaded task status
 *                calculates and stores task set utility
-*  Parameters  : none
+*  Parameters  : ctx - simulation context
 *  Returns     : none
 ******************************************************************************/
-void TSK_task_report( void )
+void TSK_task_report( struct sim_context_type *ctx )
 {
 	U32 total_util;
-	U8 index;
+	U32 index;
+	U32 first;
+	U32 last;
 	algorithm_type algorithm;
 
 	/* get the algorithm in use */
-	algorithm = SCH_get_algorithm();
+	algorithm = SCH_get_algorithm( ctx );
 	MESS_OUT_message_1( (S8*)"Algorithm is ", (U32)algorithm, MESSAGE_OP_RESULTS );
 
 	/* print results header */
 	MESS_OUT_message( (S8*)"\nTask Parameters", MESSAGE_OP_RESULTS );
 	MESS_OUT_message( (S8*)  "===============", MESSAGE_OP_RESULTS );
-	MESS_OUT_message( (S8*)"            TASK-1  TASK-2  TASK-3  TASK-4  TASK-5  TASK-6  TASK-7", MESSAGE_OP_RESULTS );
-	MESS_OUT_message( (S8*)"            ======  ======  ======  ======  ======  ======  ======", MESSAGE_OP_RESULTS );
-
-	MESS_OUT_task_report( (S8*)"Priority    ",
-		(U32)tasks[ONE_CPV  ]->priority,
-		(U32)tasks[TWO_CPV  ]->priority,
-		(U32)tasks[THREE_CPV]->priority,
-		(U32)tasks[FOUR_CPV ]->priority,
-		(U32)tasks[FIVE_CPV ]->priority,
-		(U32)tasks[SIX_CPV  ]->priority,
-		(U32)tasks[SEVEN_CPV]->priority );
-
-	MESS_OUT_task_report( (S8*)"Release     ",
-		(U32)tasks[ONE_CPV  ]->release,
-		(U32)tasks[TWO_CPV  ]->release,
-		(U32)tasks[THREE_CPV]->release,
-		(U32)tasks[FOUR_CPV ]->release,
-		(U32)tasks[FIVE_CPV ]->release,
-		(U32)tasks[SIX_CPV  ]->release,
-		(U32)tasks[SEVEN_CPV]->release );
-
-	MESS_OUT_task_report( (S8*)"Duration    ",
-		(U32)tasks[ONE_CPV  ]->duration,
-		(U32)tasks[TWO_CPV  ]->duration,
-		(U32)tasks[THREE_CPV]->duration,
-		(U32)tasks[FOUR_CPV ]->duration,
-		(U32)tasks[FIVE_CPV ]->duration,
-		(U32)tasks[SIX_CPV  ]->duration,
-		(U32)tasks[SEVEN_CPV]->duration );
-
-	MESS_OUT_task_report( (S8*)"Deadline    ",
-		(U32)tasks[ONE_CPV  ]->rel_dline,
-		(U32)tasks[TWO_CPV  ]->rel_dline,
-		(U32)tasks[THREE_CPV]->rel_dline,
-		(U32)tasks[FOUR_CPV ]->rel_dline,
-		(U32)tasks[FIVE_CPV ]->rel_dline,
-		(U32)tasks[SIX_CPV  ]->rel_dline,
-		(U32)tasks[SEVEN_CPV]->rel_dline );
-
-	MESS_OUT_task_report( (S8*)"Period      ",
-		(U32)tasks[ONE_CPV  ]->period,
-		(U32)tasks[TWO_CPV  ]->period,
-		(U32)tasks[THREE_CPV]->period,
-		(U32)tasks[FOUR_CPV ]->period,
-		(U32)tasks[FIVE_CPV ]->period,
-		(U32)tasks[SIX_CPV  ]->period,
-		(U32)tasks[SEVEN_CPV]->period );
-
-	MESS_OUT_task_report( (S8*)"Pre-empt    ",
-		(U32)tasks[ONE_CPV  ]->preempt,
-		(U32)tasks[TWO_CPV  ]->preempt,
-		(U32)tasks[THREE_CPV]->preempt,
-		(U32)tasks[FOUR_CPV ]->preempt,
-		(U32)tasks[FIVE_CPV ]->preempt,
-		(U32)tasks[SIX_CPV  ]->preempt,
-		(U32)tasks[SEVEN_CPV]->preempt );
-
-	if(  (algorithm is ALG_RM_RTO) or (algorithm is ALG_EDF_RTO) 
-		or (algorithm is ALG_EDF_BWP)   )
-	{
-		MESS_OUT_task_report( (S8*)"Skip Gap    ",
-			(U32)SKIP_GAP(ONE_CPV  ),
-			(U32)SKIP_GAP(TWO_CPV  ),
-			(U32)SKIP_GAP(THREE_CPV),
-			(U32)SKIP_GAP(FOUR_CPV ),
-			(U32)SKIP_GAP(FIVE_CPV ),
-			(U32)SKIP_GAP(SIX_CPV  ),
-			(U32)SKIP_GAP(SEVEN_CPV) );
-	}
-
-	#if(0)
-	if( 0 )
-	{
-		MESS_OUT_task_report( (S8*)"Elasticity  ",
-			(U32)tasks[ONE_CPV  ]->elastic,
-			(U32)tasks[TWO_CPV  ]->elastic,
-			(U32)tasks[THREE_CPV]->elastic,
-			(U32)tasks[FOUR_CPV ]->elastic,
-			(U32)tasks[FIVE_CPV ]->elastic,
-			(U32)tasks[SIX_CPV  ]->elastic,
-			(U32)tasks[SEVEN_CPV]->elastic );
-	}
-	#endif
-
-	if(  (algorithm is ALG_MUF) or (algorithm is ALG_MMUF) 
-		or (algorithm is ALG_MMMUF)   )
-	{
-		MESS_OUT_task_report( (S8*)"MUF Crit    ",
-			MUF_CRITICAL(ONE_CPV  ),
-			MUF_CRITICAL(TWO_CPV  ),
-			MUF_CRITICAL(THREE_CPV),
-			MUF_CRITICAL(FOUR_CPV ),
-			MUF_CRITICAL(FIVE_CPV ),
-			MUF_CRITICAL(SIX_CPV  ),
-			MUF_CRITICAL(SEVEN_CPV) );
-	}
 
-	if(    (algorithm is ALG_ADAP_01) or (algorithm is ALG_ADAP_02) 
-		or (algorithm is ALG_ADAP_03) or (algorithm is ALG_ADAP_04)   
-		or (algorithm is ALG_ADAP_05) or (algorithm is ALG_ADAP_06)   
-		or (algorithm is ALG_ADAP_07)    )
+	/* one table for each block of report columns */
+	for( first=ONE_CPV; first<=ctx->num_tasks; first+=TSK_REPORT_COLUMNS )
 	{
-		MESS_OUT_task_report( (S8*)"Flex period ",
-			(U32)PERIOD_FLEXIBLE(ONE_CPV  ),
-			(U32)PERIOD_FLEXIBLE(TWO_CPV  ),
-			(U32)PERIOD_FLEXIBLE(THREE_CPV),
-			(U32)PERIOD_FLEXIBLE(FOUR_CPV ),
-			(U32)PERIOD_FLEXIBLE(FIVE_CPV ),
-			(U32)PERIOD_FLEXIBLE(SIX_CPV  ),
-			(U32)PERIOD_FLEXIBLE(SEVEN_CPV) );
+		last = first + TSK_REPORT_COLUMNS - ONE_CPV;
+		if( last > ctx->num_tasks )
+		{
+			last = ctx->num_tasks;
+		}
+
+		report_header( (S8*)"            ", first, last );
+
+		report_row( ctx, (S8*)"Priority    ", RPT_PRIORITY, first, last );
+		report_row( ctx, (S8*)"Release     ", RPT_RELEASE,  first, last );
+		report_row( ctx, (S8*)"Duration    ", RPT_DURATION, first, last );
+		report_row( ctx, (S8*)"Deadline    ", RPT_DEADLINE, first, last );
+		report_row( ctx, (S8*)"Period      ", RPT_PERIOD,   first, last );
+		report_row( ctx, (S8*)"Pre-empt    ", RPT_PREEMPT,  first, last );
+
+		if(  (algorithm is ALG_RM_RTO) or (algorithm is ALG_EDF_RTO) 
+			or (algorithm is ALG_EDF_BWP)   )
+		{
+			report_row( ctx, (S8*)"Skip Gap    ", RPT_SKIP_GAP, first, last );
+		}
+
+		if(  (algorithm is ALG_MUF) or (algorithm is ALG_MMUF) 
+			or (algorithm is ALG_MMMUF)   )
+		{
+			report_row( ctx, (S8*)"MUF Crit    ", RPT_MUF_CRITICAL, first, last );
+		}
+
+		if(    (algorithm is ALG_ADAP_01) or (algorithm is ALG_ADAP_02) 
+			or (algorithm is ALG_ADAP_03) or (algorithm is ALG_ADAP_04)   
+			or (algorithm is ALG_ADAP_05) or (algorithm is ALG_ADAP_06)   
+			or (algorithm is ALG_ADAP_07)    )
+		{
+			report_row( ctx, (S8*)"Flex period ", RPT_PERIOD_FLEXIBLE, first, last );
+		}
+
+		report_row( ctx, (S8*)"Util x 1000 ", RPT_UTIL, first, last );
 	}
 
-	MESS_OUT_task_report( (S8*)"Util x 1000 ",
-		(U32)tasks[ONE_CPV  ]->task_util,
-		(U32)tasks[TWO_CPV  ]->task_util,
-		(U32)tasks[THREE_CPV]->task_util,
-		(U32)tasks[FOUR_CPV ]->task_util,
-		(U32)tasks[FIVE_CPV ]->task_util,
-		(U32)tasks[SIX_CPV  ]->task_util,
-		(U32)tasks[SEVEN_CPV]->task_util );
-
 	/* sum task utility values */
 	total_util = ZERO_CPV;
-	for( index=ONE_CPV; index<NUM_OF_TASKS; index++ )
+	for( index=ONE_CPV; index<=ctx->num_tasks; index++ )
 	{
-		total_util += tasks[index]->task_util;
+		total_util += ctx->tasks[index]->task_util;
 	}
 
 	/* report task set utility */
@@ -568,70 +695,36 @@ void TSK_task_report( void )
 /******************************************************************************
 *  Function    : TSK_task_results
 *  Description : prints loaded task results
-*  Parameters  : none
+*  Parameters  : ctx - simulation context
 *  Returns     : none
 ******************************************************************************/
-void TSK_task_results( void )
+void TSK_task_results( struct sim_context_type *ctx )
 {
+    U32 first;
+    U32 last;
+
     /* print results header */
     MESS_OUT_message( (S8*)"\nTask Test Report", MESSAGE_OP_RESULTS );
     MESS_OUT_message( (S8*)   "================", MESSAGE_OP_RESULTS );
-    MESS_OUT_message( (S8*)"                 TASK-1  TASK-2  TASK-3  TASK-4  TASK-5  TASK-6  TASK-7", MESSAGE_OP_RESULTS );
-    MESS_OUT_message( (S8*)"                 ======  ======  ======  ======  ======  ======  ======", MESSAGE_OP_RESULTS );
-
-    MESS_OUT_task_report(   (S8*)"Met Deadlines    ",
-							(U32)tasks[ONE_CPV  ]->dlines_met,
-							(U32)tasks[TWO_CPV  ]->dlines_met,
-							(U32)tasks[THREE_CPV]->dlines_met,
-							(U32)tasks[FOUR_CPV ]->dlines_met,
-							(U32)tasks[FIVE_CPV ]->dlines_met,
-							(U32)tasks[SIX_CPV  ]->dlines_met,
-							(U32)tasks[SEVEN_CPV]->dlines_met );
-
-    MESS_OUT_task_report(   (S8*)"Missed Deadlines ",
-							(U32)tasks[ONE_CPV  ]->dlines_missed,
-							(U32)tasks[TWO_CPV  ]->dlines_missed,
-							(U32)tasks[THREE_CPV]->dlines_missed,
-							(U32)tasks[FOUR_CPV ]->dlines_missed,
-							(U32)tasks[FIVE_CPV ]->dlines_missed,
-							(U32)tasks[SIX_CPV  ]->dlines_missed,
-							(U32)tasks[SEVEN_CPV]->dlines_missed );
-
-    MESS_OUT_task_report(   (S8*)"Periods Doubled  ",
-							(U32)tasks[ONE_CPV  ]->per_doubles,
-							(U32)tasks[TWO_CPV  ]->per_doubles,
-							(U32)tasks[THREE_CPV]->per_doubles,
-							(U32)tasks[FOUR_CPV ]->per_doubles,
-							(U32)tasks[FIVE_CPV ]->per_doubles,
-							(U32)tasks[SIX_CPV  ]->per_doubles,
-							(U32)tasks[SEVEN_CPV]->per_doubles );
-
-    MESS_OUT_task_report(   (S8*)"Pre-emptions     ",
-							(U32)tasks[ONE_CPV  ]->pre_count,
-							(U32)tasks[TWO_CPV  ]->pre_count,
-							(U32)tasks[THREE_CPV]->pre_count,
-							(U32)tasks[FOUR_CPV ]->pre_count,
-							(U32)tasks[FIVE_CPV ]->pre_count,
-							(U32)tasks[SIX_CPV  ]->pre_count,
-							(U32)tasks[SEVEN_CPV]->pre_count );
-
-    MESS_OUT_task_report(   (S8*)"Skips/Removals   ",
-							(U32)TOTAL_SKIPS(ONE_CPV  ),
-							(U32)TOTAL_SKIPS(TWO_CPV  ),
-							(U32)TOTAL_SKIPS(THREE_CPV),
-							(U32)TOTAL_SKIPS(FOUR_CPV ),
-							(U32)TOTAL_SKIPS(FIVE_CPV ),
-							(U32)TOTAL_SKIPS(SIX_CPV  ),
-							(U32)TOTAL_SKIPS(SEVEN_CPV) );
-
-    MESS_OUT_task_report(   (S8*)"Value            ",
-							(U32)tasks[ONE_CPV  ]->value,
-							(U32)tasks[TWO_CPV  ]->value,
-							(U32)tasks[THREE_CPV]->value,
-							(U32)tasks[FOUR_CPV ]->value,
-							(U32)tasks[FIVE_CPV ]->value,
-							(U32)tasks[SIX_CPV  ]->value,
-							(U32)tasks[SEVEN_CPV]->value );
+
+    /* one table for each block of report columns */
+    for( first=ONE_CPV; first<=ctx->num_tasks; first+=TSK_REPORT_COLUMNS )
+    {
+        last = first + TSK_REPORT_COLUMNS - ONE_CPV;
+        if( last > ctx->num_tasks )
+        {
+            last = ctx->num_tasks;
+        }
+
+        report_header( (S8*)"                 ", first, last );
+
+        report_row( ctx, (S8*)"Met Deadlines    ", RPT_DLINES_MET,    first, last );
+        report_row( ctx, (S8*)"Missed Deadlines ", RPT_DLINES_MISSED, first, last );
+        report_row( ctx, (S8*)"Periods Doubled  ", RPT_PER_DOUBLES,   first, last );
+        report_row( ctx, (S8*)"Pre-emptions     ", RPT_PRE_COUNT,     first, last );
+        report_row( ctx, (S8*)"Skips/Removals   ", RPT_TOTAL_SKIPS,   first, last );
+        report_row( ctx, (S8*)"Value            ", RPT_VALUE,         first, last );
+    }
 
 } /* TSK_task_results() */
 
@@ -643,47 +736,49 @@ void TSK_task_results( void )
 *                increments deadlines as met or missed.
 *                if a deadline is met, its value is its duration, else, if
 *                it misses then its value is zero.
-*  Parameters  : task number (1-7)
+*  Parameters  : ctx     - simulation context
+*                task number (1-7)
 *                time
 *  Returns     : none
 ******************************************************************************/
-void TSK_task_completed( const U8 task, const U32 timeval )
+void TSK_task_completed( struct sim_context_type *ctx, const task_id_type task, const U32 timeval )
 {
-    if( tasks[task]->abs_dline >= timeval )
+    if( ctx->tasks[task]->abs_dline >= timeval )
     {
         /* completed by deadline: increment deadlines met counters */
-        tasks[task]->dlines_met++;
-        TST_incr_test_report_value( TST_DEADLN_MET );
+        TSK_STATS(task).dlines_met++;
+        TST_incr_test_report_value( ctx, TST_DEADLN_MET );
 
         /* add value to report arrays */
-        tasks[task]->value += tasks[task]->net_value;
-        TST_add_test_report_value( TST_VALUE, tasks[task]->net_value );
+        TSK_STATS(task).value += ctx->tasks[task]->net_value;
+        TST_add_test_report_value( ctx, TST_VALUE, ctx->tasks[task]->net_value );
     }
     else
     {
         /* task over-ran its deadline increment deadlines missed counters */
-        tasks[task]->dlines_missed++;
-        TST_incr_test_report_value( TST_DEADLN_MIS );
+        TSK_STATS(task).dlines_missed++;
+        TST_incr_test_report_value( ctx, TST_DEADLN_MIS );
 
-        MESS_OUT_message_1( (S8*)"Overrun for task ", 
-                            task, MESSAGE_OP_VERBOSE );
+        MESS_OUT_VERBOSE( MESS_OUT_message_1( (S8*)"Overrun for task ", 
+                                              task, MESSAGE_OP_VERBOSE ) );
     }
 
     /* check if duration overran */
-    if( tasks[task]->time_taken > tasks[task]->c_duration )
+    if( ctx->tasks[task]->time_taken > ctx->tasks[task]->c_duration )
     {
         /* duration overran - update calculated duration */
         /* report task duration update */
-        MESS_OUT_message_3( (S8*)"Task ", task,
-                            (S8*)" duration updated from ", tasks[task]->c_duration,
-                            (S8*)" to ", tasks[task]->time_taken,
-                            MESSAGE_OP_VERBOSE );
-        tasks[task]->c_duration = tasks[task]->time_taken;
+        MESS_OUT_VERBOSE( MESS_OUT_message_3( (S8*)"Task ", task,
+                                              (S8*)" duration updated from ", ctx->tasks[task]->c_duration,
+                                              (S8*)" to ", ctx->tasks[task]->time_taken,
+                                              MESSAGE_OP_VERBOSE ) );
+        ctx->tasks[task]->c_duration = ctx->tasks[task]->time_taken;
+        SCH_utility_stale( ctx, task );
 
     }
 
-    tasks[task]->time_taken = ZERO_CPV;  /* reset time_taken        */
-    tasks[task]->net_value  = ZERO_CPV;  /* reset net value counter */
+    ctx->tasks[task]->time_taken = ZERO_CPV; /* reset time_taken        */
+    ctx->tasks[task]->net_value  = ZERO_CPV; /* reset net value counter */
 
 } /* TSK_task_completed() */
 
@@ -701,194 +796,295 @@ void TSK_task_completed( const U8 task, const U32 timeval )
 
 /******************************************************************************
 *  Function    : send_report
-*  Description : private helper that send a report to output object
-*  Parameters  : timeval - system time
+*  Description : private helper that send a report to output object. The
+*                text trace gets a line of task report words, the binary
+*                trace just the task report codes
+*  Parameters  : ctx     - simulation context
+*                timeval - system time
 *  Returns     : none
 ******************************************************************************/
-static void send_report( const U32 timeval )
+static void send_report( struct sim_context_type *ctx, const U32 timeval )
 {
-    #define word_size  12
-
-    S8 task_1[word_size];
-    S8 task_2[word_size];
-    S8 task_3[word_size];
-    S8 task_4[word_size];
-    S8 task_5[word_size];
-    S8 task_6[word_size];
-    S8 task_7[word_size];
+    U8 *codes = (U8*)ctx->report_line;
+    U32 index;
     U32 sched_time;
-    S8 overrun[word_size];
+    boolean overrun;
 
-    /* build the task state words */
-    build_task_report_word(timeval, ONE_CPV  , task_1 );
-    build_task_report_word(timeval, TWO_CPV  , task_2 );
-    build_task_report_word(timeval, THREE_CPV, task_3 );
-    build_task_report_word(timeval, FOUR_CPV , task_4 );
-    build_task_report_word(timeval, FIVE_CPV , task_5 );
-    build_task_report_word(timeval, SIX_CPV  , task_6 );
-    build_task_report_word(timeval, SEVEN_CPV, task_7 );
+    if( MESS_OUT_trace_mode() is TRC_MODE_TEXT )
+    {
+        /* build the task state words into the report line */
+        ctx->report_line[ZERO_CPV] = '\0';
+        for( index=ONE_CPV; index<=ctx->num_tasks; index++ )
+        {
+            UTL_string_copy( &ctx->report_line[(index - ONE_CPV) * TSK_REPORT_WORD_SIZE],
+                             TRC_word( task_report_code( ctx, timeval, index ) ) );
+        }
+    }
+    else
+    {
+        /* the report line holds the codes */
+        for( index=ONE_CPV; index<=ctx->num_tasks; index++ )
+        {
+            codes[index - ONE_CPV] = task_report_code( ctx, timeval, index );
+        }
+    }
 
     /* get the timer value */
     sched_time = CLK_end_timer();
 
     /* report error */
-    if( task_error )
+    overrun = ctx->task_error;
+    ctx->task_error = FALSE;
+
+    if( MESS_OUT_trace_mode() is TRC_MODE_TEXT )
     {
-        UTL_string_copy( overrun, (S8*)"OVERRUN" );
-        task_error = FALSE;
+        MESS_OUT_scheduler_report(  timeval,
+                                    ctx->report_line,
+                                    (U32)sched_time,
+                                    (overrun is TRUE) ? (S8*)"OVERRUN" : (S8*)"" );
     }
     else
     {
-        UTL_string_copy( overrun, (S8*)"" );
+        MESS_OUT_scheduler_trace( timeval, codes, ctx->num_tasks, (U32)sched_time,
+                                  (U32)ctx->running_task_id, overrun );
     }
 
-    MESS_OUT_scheduler_report(  timeval,
-								task_1,
-								task_2,
-								task_3,
-								task_4,
-								task_5,
-								task_6,
-								task_7,
-								(U32)sched_time,
-								overrun );
-
 } /* send_report() */
 
 
 /******************************************************************************
-*  Function    : build_task_report_word
-*  Description : private helper that builds a word for send_report(). Stores
-*                result in r_word
-*  Parameters  : timeval  - system time
+*  Function    : task_report_code
+*  Description : private helper that works out a task report code for
+*                send_report(), see trace.h. Sets the task error flag if
+*                the task has overrun its deadline
+*  Parameters  : ctx      - simulation context
+*                timeval  - system time
 *                task_num - number of task
-*                r_word   - report word
-*  Returns     : none
+*  Returns     : task report code
 ******************************************************************************/
-static void build_task_report_word( const U32 timeval,
-                                    const U8 task_num,
-                                    S8 *r_word )
+static U8 task_report_code( struct sim_context_type *ctx, const U32 timeval,
+                            const U32 task_num )
 {
-    switch (tasks[task_num]->state)
+    const struct task_type *task = ctx->tasks[task_num];
+    U8 code;
+
+    code = (U8)task->state;
+
+    switch( task->state )
     {
         case TSK_RUN:
+        case TSK_READY:
+        case TSK_PREMPT:
             /* check for deadline */
-            if( tasks[task_num]->abs_dline is timeval )
+            if( task->abs_dline is timeval )
             {
-               UTL_string_copy( r_word, (S8*)"<-DDDD->" );
+               code |= TRC_DEADLINE;
             }
-            else if( tasks[task_num]->time_left > (tasks[task_num]->abs_dline - timeval) )
+            else if( task->time_left > (task->abs_dline - timeval) )
             {
                /* running late */
-               UTL_string_copy( r_word, (S8*)"  LATE  " );
+               code |= TRC_LATE;
             }
-            else if( tasks[task_num]->abs_dline < timeval )
+            else if( task->abs_dline < timeval )
             {
                /* deadline overrun */
-               UTL_string_copy( r_word, (S8*)"  OVER  " );
+               code |= TRC_OVER;
 
                /* set task error flag */
-               task_error = TRUE;
+               ctx->task_error = TRUE;
             }
             else
             {
-               /* task running */
-               UTL_string_copy( r_word, (S8*)"  ++++  " );
+               /* on time */
             }
             break;
 
-        case TSK_READY:
+        case TSK_IDLE:
+        case TSK_SKIPPED:
             /* check for deadline */
-            if( tasks[task_num]->abs_dline is timeval )
-            {
-               UTL_string_copy( r_word, (S8*)"<-DDDD->" );
-            }
-            else if( tasks[task_num]->time_left > (tasks[task_num]->abs_dline - timeval) )
+            if( task->abs_dline is timeval )
             {
-               /* late */
-               UTL_string_copy( r_word, (S8*)"  RL..  " );
+               code |= TRC_DEADLINE;
             }
-            else if( tasks[task_num]->abs_dline < timeval )
-            {
-               /* deadline exceeded */
-               UTL_string_copy( r_word, (S8*)"  RO..  " );
+            break;
 
-               /* set task error flag */
-               task_error = TRUE;
-            }
-            else
-            {
-               UTL_string_copy( r_word, (S8*)"  r...  " );
-            }
+        case TSK_WAITING:
+        case TSK_REMOVED:
+        case TSK_SLEEP:
+        default:
             break;
+    }
 
+    return( code );
 
-        case TSK_PREMPT:
-            /* check for deadline */
-            if( tasks[task_num]->abs_dline is timeval )
-            {
-               UTL_string_copy( r_word, (S8*)"<-DDDD->" );
-            }
-            else if( tasks[task_num]->time_left > (tasks[task_num]->abs_dline - timeval) )
-            {
-               /* late */
-               UTL_string_copy( r_word, (S8*)"  PL..  " );
-            }
-            else if( tasks[task_num]->abs_dline < timeval )
-            {
-               /* deadline exceeded */
-               UTL_string_copy( r_word, (S8*)"  PO..  " );
+} /* task_report_code() */
 
-               /* set task error flag */
-               task_error = TRUE;
-            }
-            else
-            {
-               /* pre-empted */
-               UTL_string_copy( r_word, (S8*)"  p...  " );
-            }
-            break;
 
+/******************************************************************************
+*  Function    : report_header
+*  Description : private helper - prints the task number header of a task
+*                report table for tasks first to last
+*  Parameters  : indent - spaces over the row titles
+*                first  - first task in the table
+*                last   - last task in the table
+*  Returns     : none
+******************************************************************************/
+static void report_header( const S8 *indent, const U32 first, const U32 last )
+{
+    /* blank line between tables */
+    if( first > ONE_CPV )
+    {
+        MESS_OUT_message( (S8*)"", MESSAGE_OP_RESULTS );
+    }
 
-        case TSK_WAITING:
-               UTL_string_copy( r_word, (S8*)"  wait  " );
-            break;
+    MESS_OUT_task_header( indent, first, last, (S8*)"", FALSE );
+    MESS_OUT_task_header( indent, first, last, (S8*)"", TRUE );
 
-        case TSK_IDLE:
-            /* check for deadline */
-            if( tasks[task_num]->abs_dline is timeval )
-            {
-               UTL_string_copy( r_word, (S8*)"<-DDDD->" );
-            }
-            else
-            {
-               UTL_string_copy( r_word, (S8*)"  i...  " );
-            }
-            break;
+} /* report_header() */
 
-        case TSK_SKIPPED:
-            /* check for deadline */
-            if( tasks[task_num]->abs_dline is timeval )
-            {
-               UTL_string_copy( r_word, (S8*)"<-DDDD->" );
-            }
-            else
-            {
-               UTL_string_copy( r_word, (S8*)"  sk..  " );
-            }
-            break;
 
-        case TSK_REMOVED:
-               UTL_string_copy( r_word, (S8*)"  rm..  " );
-            break;
+/******************************************************************************
+*  Function    : report_row
+*  Description : private helper - prints one row of a task report table
+*  Parameters  : ctx   - simulation context
+*                param - row title
+*                row   - task parameter reported
+*                first - first task in the table
+*                last  - last task in the table
+*  Returns     : none
+******************************************************************************/
+static void report_row( struct sim_context_type *ctx, const S8 *param,
+                        const report_row_type row,
+                        const U32 first, const U32 last )
+{
+    U32 values[TSK_REPORT_COLUMNS];
+    U32 index;
 
-        case TSK_SLEEP:
-        default:
-            UTL_string_copy( r_word, (S8*)"  s...  " );
-            break;
+    for( index=first; index<=last; index++ )
+    {
+        values[index - first] = report_value( ctx, index, row );
+    }
+
+    MESS_OUT_task_report( param, values, last - first + ONE_CPV );
+
+} /* report_row() */
+
+
+/******************************************************************************
+*  Function    : report_value
+*  Description : private helper - gets a task parameter for the task reports
+*  Parameters  : ctx  - simulation context
+*                task - task number
+*                row  - task parameter reported
+*  Returns     : parameter value
+******************************************************************************/
+static U32 report_value( struct sim_context_type *ctx, const U32 task,
+                         const report_row_type row )
+{
+    U32 value;
+
+    switch( row )
+    {
+        case RPT_PRIORITY:        value = (U32)ctx->tasks[task]->priority;      break;
+        case RPT_RELEASE:         value = (U32)TSK_STATS(task).release;         break;
+        case RPT_DURATION:        value = (U32)TSK_STATS(task).duration;        break;
+        case RPT_DEADLINE:        value = (U32)ctx->tasks[task]->rel_dline;     break;
+        case RPT_PERIOD:          value = (U32)ctx->tasks[task]->period;        break;
+        case RPT_PREEMPT:         value = (U32)TSK_STATS(task).preempt;         break;
+        case RPT_SKIP_GAP:        value = (U32)SKIP_GAP(task);                  break;
+        case RPT_MUF_CRITICAL:    value = (U32)MUF_CRITICAL(task);              break;
+        case RPT_PERIOD_FLEXIBLE: value = (U32)PERIOD_FLEXIBLE(task);           break;
+        case RPT_UTIL:            value = (U32)ctx->tasks[task]->task_util;     break;
+        case RPT_DLINES_MET:      value = (U32)TSK_STATS(task).dlines_met;      break;
+        case RPT_DLINES_MISSED:   value = (U32)TSK_STATS(task).dlines_missed;   break;
+        case RPT_PER_DOUBLES:     value = (U32)TSK_STATS(task).per_doubles;     break;
+        case RPT_PRE_COUNT:       value = (U32)ctx->tasks[task]->pre_count;     break;
+        case RPT_TOTAL_SKIPS:     value = (U32)TOTAL_SKIPS(task);               break;
+        case RPT_VALUE:           value = (U32)TSK_STATS(task).value;           break;
+        default:                  value = ZERO_CPV;                             break;
     }
 
-} /* build_task_report_word() */
+    return( value );
+
+} /* report_value() */
+
+
+#ifndef DEV_SYSTEM
+/******************************************************************************
+*  Function    : grow_task_table
+*  Description : private helper - grows the task table, task pointers, task
+*                statistics and report line to hold slots task slots. The pointers are
+*                rebuilt as the table may move.
+*  Parameters  : ctx   - simulation context
+*                slots - task slots needed, including slot 0
+*  Returns     : TRUE if the table was grown
+******************************************************************************/
+static boolean grow_task_table( struct sim_context_type *ctx, const U32 slots )
+{
+    struct task_type  *task_array;
+    struct task_type **tasks;
+    struct task_stats_type *task_stats;
+    S8                *report_line;
+    boolean grown = FALSE;
+    U32 index;
+
+    task_array  = (struct task_type*)realloc( ctx->task_array,
+                                              slots * sizeof( struct task_type ) );
+    if( task_array is_not NULL )
+    {
+        ctx->task_array = task_array;
+    }
+
+    tasks = (struct task_type**)realloc( ctx->tasks,
+                                         slots * sizeof( struct task_type* ) );
+    if( tasks is_not NULL )
+    {
+        ctx->tasks = tasks;
+    }
+
+    task_stats = (struct task_stats_type*)realloc( ctx->task_stats,
+                                                   slots * sizeof( struct task_stats_type ) );
+    if( task_stats is_not NULL )
+    {
+        ctx->task_stats = task_stats;
+    }
+
+    report_line = (S8*)realloc( ctx->report_line,
+                                (slots * TSK_REPORT_WORD_SIZE) + ONE_CPV );
+    if( report_line is_not NULL )
+    {
+        ctx->report_line = report_line;
+    }
+
+    if( (task_array is NULL) or (tasks is NULL) or (task_stats is NULL) or (report_line is NULL) )
+    {
+        MESS_OUT_message_1( (S8*)"grow_task_table(): out of memory for tasks ",
+                            slots - ONE_CPV,
+                            MESSAGE_OP_ERROR );
+    }
+    else
+    {
+        /* dereference the task structure pointers */
+        for( index=ZERO_CPV; index<slots; index++ )
+        {
+            ctx->tasks[index] = &ctx->task_array[index];
+        }
+
+        /* clear the new slots */
+        for( index=ctx->max_tasks + ONE_CPV; index<slots; index++ )
+        {
+            reset_task_parameters( ctx->tasks[index] );
+            reset_task_stats( &ctx->task_stats[index] );
+        }
+
+        ctx->max_tasks = slots - ONE_CPV;
+        grown = TRUE;
+    }
+
+    return( grown );
+
+} /* grow_task_table() */
+#endif
 
 
 /******************************************************************************
@@ -900,21 +1096,15 @@ static void build_task_report_word( const U32 timeval,
 static void reset_task_parameters( struct task_type* task )
 {
 	task->id                = ZERO_CPV;             
-	task->release           = ZERO_CPV;        
-	task->duration          = ZERO_CPV;       
 	task->rel_dline         = ZERO_CPV;      
 	task->period            = ZERO_CPV;         
 	task->task_util         = ZERO_CPV;      
 	task->priority          = ZERO_CPV;       
-	task->preempt           = ZERO_CPV;        
 	task->spare_1           = ZERO_CPV;        
 	task->spare_2           = ZERO_CPV;        
-	task->spare_3           = ZERO_CPV;        
-	task->spare_4           = ZERO_CPV;
 	task->time_left         = ZERO_CPV;
 	task->time_taken        = ZERO_CPV;
 	task->abs_dline         = ZERO_CPV;
-	task->laxity            = ZERO_CPV;
 	task->c_duration        = ZERO_CPV;
 	task->task_util         = ZERO_CPV;
 	task->pre_count         = ZERO_CPV;
@@ -927,14 +1117,36 @@ static void reset_task_parameters( struct task_type* task )
 	task->q1_prev           = ZERO_CPV;
 	task->q1_next           = ZERO_CPV;			 	
 	task->q2_next           = ZERO_CPV;
-	task->per_doubles       = ZERO_CPV;
-	task->dlines_missed     = ZERO_CPV;
-	task->dlines_met        = ZERO_CPV;
+	task->q0_pos            = ZERO_CPV;
+	task->q0_seq            = ZERO_CPV;
+	task->q0_key            = ZERO_CPV;
 	task->net_value         = ZERO_CPV;
-	task->value             = ZERO_CPV;
+	task->util_share        = ZERO_CPV;
+	task->util_stale        = FALSE;
 
 } /* reset_task_parameters() */
 
+
+/******************************************************************************
+*  Function    : reset_task_stats
+*  Description : private helper - initialises task statistics
+*  Parameters  : pointer to task statistics
+*  Returns     : none
+******************************************************************************/
+static void reset_task_stats( struct task_stats_type* stats )
+{
+	stats->release          = ZERO_CPV;
+	stats->duration         = ZERO_CPV;
+	stats->spare_3          = ZERO_CPV;
+	stats->spare_4          = ZERO_CPV;
+	stats->preempt          = ZERO_CPV;
+	stats->per_doubles      = ZERO_CPV;
+	stats->dlines_missed    = ZERO_CPV;
+	stats->dlines_met       = ZERO_CPV;
+	stats->value            = ZERO_CPV;
+
+} /* reset_task_stats() */
+
 /******************************************************************************
 *  Function    : reset_task_computed_parameters
 *  Description : private helper - initialises computed generated parameters
@@ -953,7 +1165,6 @@ static void reset_task_computed_parameters( void )
         test_tasks[index].time_left         = ZERO_CPV;
         test_tasks[index].time_taken        = ZERO_CPV;
         test_tasks[index].abs_dline         = ZERO_CPV;
-        test_tasks[index].laxity            = ZERO_CPV;
         test_tasks[index].c_duration        = ZERO_CPV;
         test_tasks[index].task_util         = ZERO_CPV;
         test_tasks[index].pre_count         = ZERO_CPV;
@@ -965,6 +1176,11 @@ static void reset_task_computed_parameters( void )
         test_tasks[index].q1_next           = ZERO_CPV;
         test_tasks[index].q2_prev           = ZERO_CPV;
         test_tasks[index].q2_next           = ZERO_CPV;
+        test_tasks[index].q0_pos            = ZERO_CPV;
+        test_tasks[index].q0_seq            = ZERO_CPV;
+        test_tasks[index].q0_key            = ZERO_CPV;
+        test_tasks[index].util_share        = ZERO_CPV;
+        test_tasks[index].util_stale        = FALSE;
         test_tasks[index].total_skips       = ZERO_CPV;
         test_tasks[index].per_doubles       = ZERO_CPV;
         test_tasks[index].dlines_missed     = ZERO_CPV;
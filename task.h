@@ -23,22 +23,47 @@
 * 17-04-05 |JRO| Added screen control for development system                  *
 * 18-06-05 |JRO| Added pre-caluclated utility * 1000 member                   *
 * 26-06-05 |JRO| Added data for ALG_ADAP_03 & ALG_ADAP_04 scheduler           *
+* 17-10-26 |JRO| Added TSK_run_task_cycles()                                  *
+* 17-10-26 |JRO| Task data moved to simulation context (context.h)            *
+* 17-10-26 |JRO| Added TSK_size_task_table() for task sets of any size        *
+* 17-10-26 |JRO| Queue links and task ids widened to task_id_type             *
+* 17-10-26 |JRO| Added queue 0 heap position and insert order                 *
+* 17-10-26 |JRO| Laxity read from a time-relative key, laxity member removed  *
+* 17-10-26 |JRO| Added task set utility share and stale flag                  *
+* 17-10-26 |JRO| Statistics and spare constants split into task_stats_type    *
+* 17-10-26 |JRO| Added task state set masks                                   *
+* 17-10-26 |JRO| Added TSK_set_task()                                         *
 *          |   |                                                              *
 *                                                                             *
 ******************************************************************************/
 #ifndef _TASK_H_
 #define _TASK_H_
 
+#define TSK_MAX_TASKS  MAX_TASK_ID  /* largest task set, see TASK_ID_BITS  */
+#define TSK_REPORT_COLUMNS     7    /* tasks per task report table        */
+#define TSK_REPORT_WORD_SIZE   8    /* characters per scheduler report word */
+
 /* macros to redefined constant data, using spare members */
-#define MUF_CRITICAL(x)        tasks[(x)]->spare_1 /* MUF tasks: 37-40 */																  
-#define MUF_URGENCY(x)         tasks[(x)]->spare_4																  
-#define ELASTIC_COEFFICIENT(x) tasks[(x)]->spare_1																  
-#define PERIOD_FLEXIBLE(x)     tasks[(x)]->spare_2													  
-#define SKIP_GAP(x)            tasks[(x)]->spare_1 /* Skip tasks: 41-44 */													  
-#define NOT_SKIPPED(x)         tasks[(x)]->spare_2 /* NOT YET SET UP */													  
-#define TOTAL_SKIPS(x)         tasks[(x)]->spare_2 /* NOT YET SET UP */													  
+/* (expects the simulation context pointer ctx in scope)  */
+#define MUF_CRITICAL(x)        ctx->tasks[(x)]->spare_1 /* MUF tasks: 37-40 */																  
+#define ELASTIC_COEFFICIENT(x) ctx->tasks[(x)]->spare_1																  
+#define PERIOD_FLEXIBLE(x)     PERIOD_FLEXIBLE_OF( ctx->tasks[(x)] )
+#define SKIP_GAP(x)            ctx->tasks[(x)]->spare_1 /* Skip tasks: 41-44 */													  
+#define NOT_SKIPPED(x)         ctx->tasks[(x)]->spare_2 /* NOT YET SET UP */													  
+#define TOTAL_SKIPS(x)         ctx->tasks[(x)]->spare_2 /* NOT YET SET UP */													  
+
+/* PERIOD_FLEXIBLE through a task pointer, for sweeps over the task table */
+#define PERIOD_FLEXIBLE_OF(t)  (t)->spare_2
 
-extern U8 running_task_id;
+/* laxity key - deadline less the work remaining. It only moves when the task
+   is released or runs, so the laxity at time t is read from it directly
+   rather than being recalculated for every task on every tick */
+#define LAXITY_KEY(x)   ( (ctx->tasks[(x)]->abs_dline > ctx->tasks[(x)]->time_left) ? \
+                          (ctx->tasks[(x)]->abs_dline - ctx->tasks[(x)]->time_left) : ZERO_CPV )
+#define LAXITY(x, t)    ( (LAXITY_KEY(x) > (t)) ? (LAXITY_KEY(x) - (t)) : ZERO_CPV )
+
+/* simulation context, see context.h */
+struct sim_context_type;
 
 #ifndef DEV_SYSTEM
 /* stored task data array */
@@ -73,63 +98,92 @@ typedef enum
    TSK_RUN       /* task is running               */
 }task_state_type;
 
+/* task state sets - a task is tested against several states with one mask
+   test rather than a chain of compares */
+#define TSK_STATE_BIT(s)        ( (U32)ONE_CPV << (U32)(s) )
+#define TSK_IN_STATES(s, set)   ( (TSK_STATE_BIT(s) & (set)) is_not ZERO_CPV )
+#define TSK_ACTIVE_STATES       ( TSK_STATE_BIT(TSK_READY) | TSK_STATE_BIT(TSK_RUN) | \
+                                  TSK_STATE_BIT(TSK_IDLE)  | TSK_STATE_BIT(TSK_PREMPT) )
+#define TSK_UTILITY_STATES      ( TSK_ACTIVE_STATES | TSK_STATE_BIT(TSK_SKIPPED) )
+
 
-/* individual task data type */
+/* individual task data type - the fields the scheduler reads on every
+   pass, kept small so queue walks and task sweeps stay in cache. Words and
+   enums come first, then the U16s, the queue links, whose width is set by
+   TASK_ID_BITS, and the bytes, so no member is padded. The deadline,
+   period, spares, id and priority are loaded with the task, the rest are
+   worked out as it runs */
 struct task_type
-{                                /* CONSTANTS                       */
-                                 /* =========                       */
-    U8          id;              /* task id                         */
-    U32         release;         /* task release time               */
-    U32         duration;        /* task execution time             */
-    U32         rel_dline;       /* relative task deadline          */
-    U32         period;          /* task period                     */
-    U8          priority;        /* priority level, one is highest  */
-    U8          preempt;         /* true if task can be pre-empted  */
-    U32         spare_1;         /* spare constant data             */
-    U32         spare_2;         /* spare constant data             */
-    U32         spare_3;         /* spare constant data             */
-    U32         spare_4;         /* spare constant data             */
-                                       /*                                               */
-                                       /* CALCULATED                                    */
-                                       /* ==========                                    */
+{
+    U32         rel_dline;             /* relative task deadline                        */
+    U32         period;                /* task period                                   */
+    U32         spare_1;               /* spare constant data                           */
+    U32         spare_2;               /* spare constant data                           */
+    U32         abs_dline;             /* absolute task deadline                        */
     U32         time_left;             /* duration remaining                            */
     U32         time_taken;            /* actual time taken by task to complete         */
-    U32         abs_dline;             /* absolute task deadline                        */
-    U32         laxity;                /* laxity of task                                */
     U32         c_duration;            /* calculated duration                           */
+    U32         q0_seq;                /* queue 0 heap insert order, breaks ties        */
+    U32         q0_key;                /* queue 0 heap key, taken on insert             */
+    U32         net_value;             /* net value of task                             */
+    task_state_type state;             /* state of task                                 */
+    boolean     util_stale;            /* c_duration changed since task_util worked out */
     U16         task_util;             /* calculated task set utility                   */
+    U16         util_share;            /* utility counted in the task set total         */
+    task_id_type q0_prev;              /* pointer to queue 0 previous task              */
+    task_id_type q0_next;              /* pointer to queue 0 next task                  */
+    task_id_type q1_prev;              /* pointer to queue 1 previous task              */
+    task_id_type q1_next;              /* pointer to queue 1 next task                  */
+    task_id_type q2_prev;              /* pointer to queue 2 previous task              */
+    task_id_type q2_next;              /* pointer to queue 2 next task                  */
+    task_id_type q0_pos;               /* queue 0 heap slot + 1, 0 if not in a heap     */
+    U8          id;                    /* task id                                       */
+    U8          priority;              /* priority level, one is highest                */
     U8          pre_count;             /* count of pre-emptions                         */
     U8          e_priority;            /* enhanced priority                             */
     U8          period_multiplyer;     /* number of times period multiplied             */
-    task_state_type state;             /* state of task                                 */
-    U8          q0_prev;               /* pointer to queue 0 previous task              */
-    U8          q0_next;               /* pointer to queue 0 next task                  */
-    U8          q1_prev;               /* pointer to queue 1 previous task              */
-    U8          q1_next;               /* pointer to queue 1 next task                  */
-    U8          q2_prev;               /* pointer to queue 2 previous task              */
-    U8          q2_next;               /* pointer to queue 2 next task                  */
+};
+
+/* task statistics and parameters only read when a task is loaded, completes
+   or is reported. Held in ctx->task_stats[], indexed by task id */
+struct task_stats_type
+{                                      /* CONSTANTS                                     */
+                                       /* =========                                     */
+    U32         release;               /* task release time                             */
+    U32         duration;              /* task execution time                           */
+    U32         spare_3;               /* spare constant data                           */
+    U32         spare_4;               /* spare constant data                           */
                                        /*                                               */
                                        /* REPORT PARAMETERS                             */
                                        /* =================                             */
     U32         per_doubles;           /* times period doubled                          */
     U32         dlines_missed;         /* deadlines missed by task                      */
     U32         dlines_met;            /* deadlines achieved by task                    */
-    U32         net_value;             /* net value of task                             */
     U32         value;                 /* total value of task                           */
+                                       /*                                               */
+                                       /* CONSTANTS, BYTES LAST                         */
+                                       /* =====================                         */
+    U8          preempt;               /* true if task can be pre-empted                */
 };
 
+/* statistics of task x (expects the simulation context pointer ctx in scope) */
+#define TSK_STATS(x)    ( ctx->task_stats[(x)] )
+
 
 
-void TSK_init( void );
-void TSK_close( void );
-void TSK_soft_reset( void );
-struct task_type *TSK_load_task( const U8 task_id, const U8 test_task_id );
-void TSK_add_task( const U8 test_task_id, struct task_type* task );
-void TSK_start_of_test( void );
-void TSK_run_task_cycle( const U32 timeval );
-void TSK_end_of_test( void );
-void TSK_task_report( void );
-void TSK_task_results( void );
-void TSK_task_completed( const U8 task, const U32 timeval );
+void TSK_init( struct sim_context_type *ctx );
+void TSK_close( struct sim_context_type *ctx );
+boolean TSK_size_task_table( struct sim_context_type *ctx, const U32 num_tasks );
+void TSK_soft_reset( struct sim_context_type *ctx );
+struct task_type *TSK_load_task( struct sim_context_type *ctx, const task_id_type task_id, const U8 test_task_id );
+void TSK_add_task( const U8 test_task_id, struct task_type* task, struct task_stats_type* stats );
+void TSK_set_task( const struct stored_task_data_type *data, struct task_type* task, struct task_stats_type* stats );
+void TSK_start_of_test( struct sim_context_type *ctx );
+void TSK_run_task_cycle( struct sim_context_type *ctx, const U32 timeval );
+void TSK_run_task_cycles( struct sim_context_type *ctx, const U32 timeval, const U32 ticks );
+void TSK_end_of_test( struct sim_context_type *ctx );
+void TSK_task_report( struct sim_context_type *ctx );
+void TSK_task_results( struct sim_context_type *ctx );
+void TSK_task_completed( struct sim_context_type *ctx, const task_id_type task, const U32 timeval );
 
 #endif /* _TASK_H_ */
@@ -15,6 +15,7 @@
 *                                                                             *
 * date     |Aut| Description                                                  *
 * 13-09-05 |JRO| Created                                                      *
+* 17-10-26 |JRO| Debug and verbose messages through MESS_OUT_DEBUG/VERBOSE    *
 *          |   |                                                              *
 *                                                                             *
 ******************************************************************************/
@@ -73,16 +74,16 @@ void TASK_FILE_dump_tasks( void )
 	if( open_file() is TRUE )
 	{
 		/* step through each line of the task file */
-		MESS_OUT_message( "Starting task file dump\n", MESSAGE_OP_DEBUG );
+		MESS_OUT_DEBUG( MESS_OUT_message( "Starting task file dump\n", MESSAGE_OP_DEBUG ) );
  		while( fgets( buffer, (BUFFSIZE-1), task_file_ptr ) )
 		{
 			printf("step\n");
 			
-			MESS_OUT_message( buffer, MESSAGE_OP_DEBUG );
+			MESS_OUT_DEBUG( MESS_OUT_message( buffer, MESSAGE_OP_DEBUG ) );
 
 		  /*	parse_line( buffer ); */
 		}  	
-		MESS_OUT_message( "Ended task file dump\n", MESSAGE_OP_DEBUG );
+		MESS_OUT_DEBUG( MESS_OUT_message( "Ended task file dump\n", MESSAGE_OP_DEBUG ) );
 		
 		close_file();
 	}
@@ -127,7 +128,7 @@ static boolean open_file( void )
 
 	if( task_file_ptr is_not NULL )
 	{
-		MESS_OUT_message( "task_data_file opened\n", MESSAGE_OP_DEBUG );
+		MESS_OUT_DEBUG( MESS_OUT_message( "task_data_file opened\n", MESSAGE_OP_DEBUG ) );
 		result = TRUE;
 	}
 	else
@@ -153,7 +154,7 @@ static void close_file( void )
 	{
 		fclose( task_file_ptr );
 		task_file_ptr = NULL;
-		MESS_OUT_message( "task_data_file closed\n", MESSAGE_OP_DEBUG );
+		MESS_OUT_DEBUG( MESS_OUT_message( "task_data_file closed\n", MESSAGE_OP_DEBUG ) );
 	} 
 
 } /* close_file() */
@@ -16,6 +16,12 @@
 * date     |who| description                                                  *
 * 17-04-05 |JRO| Created                                                      *
 * 10-07-05 |JRO| Added user options to menu                                   *
+* 17-10-26 |JRO| Added ME option - event driven simulation toggle             *
+* 17-10-26 |JRO| Drives simulation through sim_context                        *
+* 17-10-26 |JRO| Added MP option - parallel sweep of test cases               *
+* 17-10-26 |JRO| Added MH option - heap ready queue toggle                    *
+* 17-10-26 |JRO| Added MW option - timing wheel idle/waiting queue toggle     *
+* 17-10-26 |JRO| Debug and verbose messages through MESS_OUT_DEBUG/VERBOSE    *
 *          |   |                                                              *
 *                                                                             *
 ******************************************************************************/
@@ -45,8 +51,10 @@
 #endif
 
 #include "test.h"          /* test manager                  */
+#include "context.h"       /* simulation context            */
 #include "test_case.h"     /* test case container           */
 #include "initialise.h"    /* initialisation functions      */
+#include "sweep.h"         /* parallel test case sweep      */
 #include "term.h"          /* interface file                */
 
 static boolean continuous_loop = FALSE;
@@ -64,6 +72,8 @@ static void update_algorithm( const S8 *line );
 static void update_duration( const S8 *line );
 static void display_test( void );
 static void set_up_loop_run( const S8 *line );
+static void set_up_sweep( const S8 *line );
+static void get_test_case_range( const S8 *line, U8 *start, U8 *stop );
 static void loop_through_all_test_cases( void );
 static void print_welcome_screen( void );
 static void print_menu( void );
@@ -175,9 +185,9 @@ void TRM_end_of_test( void )
 ******************************************************************************/
 static void process_input( const S8 *line )
 {
-	MESS_OUT_message_S2( (S8*)"process_input() data: ", 
-	                     line, 
-	                     MESSAGE_OP_DEBUG );
+	MESS_OUT_DEBUG( MESS_OUT_message_S2( (S8*)"process_input() data: ", 
+	                                     line, 
+	                                     MESSAGE_OP_DEBUG ) );
 
     switch( line[ZERO_CPV] )
     {
@@ -273,7 +283,7 @@ static void process_input( const S8 *line )
         case 'a':
         case 'A':
             /* Abort back to main() */
-            mode = MODE_ABORT;
+            sim_context.mode = MODE_ABORT;
             break;
         #endif
 
@@ -321,6 +331,32 @@ static void process_input( const S8 *line )
                     set_up_loop_run( line );
                     break;
 
+                #ifndef DEV_SYSTEM
+                case 'p':
+                case 'P':
+                    /* run the test cases on the worker pool */
+                    set_up_sweep( line );
+                    break;
+                #endif
+
+                case 'e':
+                case 'E':
+                    /* toggle event driven simulation */
+                    TST_toggle_event_mode( &sim_context );
+                    break;
+
+                case 'h':
+                case 'H':
+                    /* toggle heap ready queue */
+                    SCH_toggle_ready_queue( &sim_context );
+                    break;
+
+                case 'w':
+                case 'W':
+                    /* toggle timing wheel idle and waiting queues */
+                    SCH_toggle_release_queues( &sim_context );
+                    break;
+
                 case 'c':
                 case 'C':
                     /* calendar info */
@@ -365,9 +401,9 @@ static void load_test_case( const S8 *line )
 {
     U8 input;
 
-    MESS_OUT_message_S2( (S8*)"load_test_case() data: ", 
-                         line,
-                         MESSAGE_OP_DEBUG );
+    MESS_OUT_DEBUG( MESS_OUT_message_S2( (S8*)"load_test_case() data: ", 
+                                         line,
+                                         MESSAGE_OP_DEBUG ) );
 
     /* get the user input */
     input = (U8)get_numeric_input( line, ONE_CPV, ZERO_CPV, MAX_TEST_CASES );
@@ -377,16 +413,16 @@ static void load_test_case( const S8 *line )
         /* request a soft reset */
         INIT_soft_reset();
 
-        test_num = input;
+        sim_context.test_num = input;
 
         /* load test case */
-        TST_load_test( test_num );
+        TST_load_test( &sim_context, sim_context.test_num );
 
         /* display test setup */
         display_test();	
 
         /* report to screen */
-        MESS_OUT_message_1( (S8*)"Loaded test case ", test_num, MESSAGE_OP_LOG );
+        MESS_OUT_message_1( (S8*)"Loaded test case ", sim_context.test_num, MESSAGE_OP_LOG );
     }
     else
     {
@@ -411,9 +447,9 @@ static void load_and_run_test_case( const S8 *line )
 {
     U8 input;
 
-    MESS_OUT_message_S2( (S8*)"load_and_run_test_case() called with: ", 
-                         line,
-                         MESSAGE_OP_DEBUG );
+    MESS_OUT_DEBUG( MESS_OUT_message_S2( (S8*)"load_and_run_test_case() called with: ", 
+                                         line,
+                                         MESSAGE_OP_DEBUG ) );
 
     /* get the user input */
     input = (U8)get_numeric_input( line, ONE_CPV, ZERO_CPV, MAX_TEST_CASES );
@@ -423,10 +459,10 @@ static void load_and_run_test_case( const S8 *line )
         /* request a soft reset */
         INIT_soft_reset();
 
-        test_num = input;
+        sim_context.test_num = input;
 
         /* load test case */
-        TST_load_test( test_num );
+        TST_load_test( &sim_context, sim_context.test_num );
 
         /* now run the test case */
         run_test_case();
@@ -448,30 +484,30 @@ static void load_and_run_test_case( const S8 *line )
 *****************************************************************************/
 static void run_test_case( void )
 {
-    MESS_OUT_message( (S8*)"run_test_case() called", MESSAGE_OP_DEBUG );
+    MESS_OUT_DEBUG( MESS_OUT_message( (S8*)"run_test_case() called", MESSAGE_OP_DEBUG ) );
 
     MESS_OUT_message( (S8*)"\n\n\n", MESSAGE_OP_INFO );
 
-    if( test_num > ZERO_CPV )
+    if( sim_context.test_num > ZERO_CPV )
     {
         /* report to screen */
-        MESS_OUT_message_1( (S8*)"Running test case ", test_num, MESSAGE_OP_LOG );
+        MESS_OUT_message_1( (S8*)"Running test case ", sim_context.test_num, MESSAGE_OP_LOG );
 
-        rename_output_file( test_num ); /* rename output file           */
+        rename_output_file( sim_context.test_num ); /* rename output file           */
 
         display_test();                 /* report test conditions       */
 
-        TSK_start_of_test();            /* warn task object             */
+        TSK_start_of_test( &sim_context ); /* warn task object             */
 
         /* start the timer */
         #ifdef DEV_SYSTEM
             TIM_start_simulation();     /* start simulation             */
         #else
-            TST_start_simulation();     /* start simulation             */
+            TST_start_simulation( &sim_context ); /* start simulation             */
         #endif
 
         /* change mode to simulation */
-        mode = MODE_SIMULATION;         /* change mode                  */
+        sim_context.mode = MODE_SIMULATION; /* change mode                  */
     }
     else
     {
@@ -492,9 +528,9 @@ static void update_algorithm( const S8  *line )
 {
     U8 filtered_input;
 
-    MESS_OUT_message_S2( (S8*)"update_algorithm() called with",
-                          line,
-                          MESSAGE_OP_DEBUG );
+    MESS_OUT_DEBUG( MESS_OUT_message_S2( (S8*)"update_algorithm() called with",
+                                          line,
+                                          MESSAGE_OP_DEBUG ) );
 
     /* update algorithm */
     filtered_input = (U8)get_numeric_input( line, TWO_CPV, ONE_CPV, (U32)ALG_MAX_ALG );
@@ -502,11 +538,11 @@ static void update_algorithm( const S8  *line )
     if( filtered_input > ZERO_CPV )
     {
         /* update algorithm */
-        SCH_set_algorithm( (algorithm_type)(filtered_input-1) );
+        SCH_set_algorithm( &sim_context, (algorithm_type)(filtered_input-1) );
 
         /* display updated algorithm */
         MESS_OUT_message( (S8*)"\n", MESSAGE_OP_INFO );
-        SCH_what_algorithm( MESSAGE_OP_INFO );
+        SCH_what_algorithm( &sim_context, MESSAGE_OP_INFO );
         MESS_OUT_message( (S8*)"\n", MESSAGE_OP_INFO );
     }
     else
@@ -533,18 +569,18 @@ static void update_duration( const S8* const line )
     const U16 max_duration = 0xffff;
     U16 input;
 
-    MESS_OUT_message_S2( (S8*)"update_duration() called with",
-                          line,
-                          MESSAGE_OP_DEBUG );
+    MESS_OUT_DEBUG( MESS_OUT_message_S2( (S8*)"update_duration() called with",
+                                          line,
+                                          MESSAGE_OP_DEBUG ) );
 
     /* update test tick duration of test */
     /* get the test number */
     input = (U16)get_numeric_input( line, TWO_CPV, ONE_CPV, max_duration );
     if( input > ZERO_CPV )
     {
-        test_duration = input;  /* update test duration */
+        sim_context.test_duration = input; /* update test duration */
         MESS_OUT_message_1( (S8*)"New duration = ", 
-                            test_duration, 
+                            sim_context.test_duration, 
                             MESSAGE_OP_LOG );
     }
     else
@@ -567,28 +603,28 @@ static void update_duration( const S8* const line )
 ******************************************************************************/
 static void display_test( void )
 {
-    MESS_OUT_message( (S8*)"display_test() called", MESSAGE_OP_DEBUG );
+    MESS_OUT_DEBUG( MESS_OUT_message( (S8*)"display_test() called", MESSAGE_OP_DEBUG ) );
 
-    if( test_num > ZERO_CPV )
+    if( sim_context.test_num > ZERO_CPV )
     {
         /* test case */
 
 		/* report to results */
         MESS_OUT_message( (S8*)"Test case:", MESSAGE_OP_RESULTS );
-        TSC_report_test_case( test_num, MESSAGE_OP_RESULTS );
-		TSC_report_test_case_notes( test_num );
+        TSC_report_test_case( sim_context.test_num, MESSAGE_OP_RESULTS );
+		TSC_report_test_case_notes( sim_context.test_num );
 
         /* report algorithm */
         MESS_OUT_message( (S8*)"Algorithm:", MESSAGE_OP_RESULTS );
-        SCH_what_algorithm( MESSAGE_OP_RESULTS );
+        SCH_what_algorithm( &sim_context, MESSAGE_OP_RESULTS );
 
         /* test duration */
         MESS_OUT_message_1( (S8*)"Test duration:", 
-                            test_duration, 
+                            sim_context.test_duration, 
                             MESSAGE_OP_RESULTS );
 
         /* report task parameters */
-        TSK_task_report();
+        TSK_task_report( &sim_context );
 
         /* report system status */
         MESS_OUT_report_status( MESSAGE_OP_RESULTS );
@@ -611,46 +647,88 @@ static void display_test( void )
 ******************************************************************************/
 static void set_up_loop_run( const S8  *line )
 {
-    U8 input;
+    MESS_OUT_DEBUG( MESS_OUT_message_S2( (S8*)"set_up_loop_run() data: ", 
+                                         line,
+                                         MESSAGE_OP_DEBUG ) );
+
+    get_test_case_range( line, &start_test_case, &stop_test_case );
+
+    MESS_OUT_DEBUG( MESS_OUT_message_2( (S8*)"start: ", start_test_case,
+                                        (S8*)"stop: ",  stop_test_case,
+                                        MESSAGE_OP_DEBUG ) );
+
+    continuous_loop = TRUE;
+    loop_through_all_test_cases();
+
+} /* set_up_loop_run() */
+
+
+/******************************************************************************
+*  Function    : set_up_sweep
+*  Description : private helper - sets up a parallel sweep of the test
+*                cases. Takes the same parameters as the loop run, but
+*                fans the test cases out to the sweep worker pool and
+*                merges the results into one report
+*  Parameters  : pointer to user line input 
+*  Returns     : none
+******************************************************************************/
+static void set_up_sweep( const S8  *line )
+{
+    U8 start;
+    U8 stop;
+
+    MESS_OUT_DEBUG( MESS_OUT_message_S2( (S8*)"set_up_sweep() data: ", 
+                                         line,
+                                         MESSAGE_OP_DEBUG ) );
+
+    get_test_case_range( line, &start, &stop );
 
-    MESS_OUT_message_S2( (S8*)"set_up_loop_run() data: ", 
-                         line,
-                         MESSAGE_OP_DEBUG );
+    SWP_sweep( start, stop );
+
+} /* set_up_sweep() */
+
+
+/******************************************************************************
+*  Function    : get_test_case_range
+*  Description : private helper - reads the first and last test case
+*                numbers of a loop run or sweep from the user line input,
+*                defaulting to all the test cases
+*  Parameters  : line  - pointer to user line input
+*                start - returned first test case number
+*                stop  - returned test case number to stop at
+*  Returns     : none
+******************************************************************************/
+static void get_test_case_range( const S8 *line, U8 *start, U8 *stop )
+{
+    U8 input;
 
     /* get the first user input */
     input = (U8)get_numeric_input( line, THREE_CPV, ZERO_CPV, MAX_TEST_CASES );
 
     if( input > ZERO_CPV )
     {
-        start_test_case = input;
+        *start = input;
 
         /* get second user input */
         input = (U8)get_numeric_input( line, FIVE_CPV, ZERO_CPV, MAX_TEST_CASES );
-        if( (input > start_test_case) )
+        if( (input > *start) )
         {
-            stop_test_case  = input;
+            *stop  = input;
         }
         else
         {
             /* no valid stop number - set default */
-            stop_test_case  = MAX_TEST_CASES;
+            *stop  = MAX_TEST_CASES;
         }
     }
     else
     {
         /* no valid numbers - set defaults */
-        start_test_case = ONE_CPV;
-        stop_test_case  = MAX_TEST_CASES;
+        *start = ONE_CPV;
+        *stop  = MAX_TEST_CASES;
     }
 
-    MESS_OUT_message_2( (S8*)"start: ", start_test_case,
-                        (S8*)"stop: ",  stop_test_case,
-                        MESSAGE_OP_DEBUG );
-
-    continuous_loop = TRUE;
-    loop_through_all_test_cases();
-
-} /* set_up_loop_run() */
+} /* get_test_case_range() */
 
 
 /******************************************************************************
@@ -677,10 +755,10 @@ static void loop_through_all_test_cases( void )
         INIT_soft_reset();
 
         /* set the test case number global */
-        test_num = test_case_number;
+        sim_context.test_num = test_case_number;
 
         /* load next test case */
-        TST_load_test( test_num );
+        TST_load_test( &sim_context, sim_context.test_num );
 
         /* run the test case */
         run_test_case();
@@ -689,7 +767,7 @@ static void loop_through_all_test_cases( void )
     {
         test_case_number = 0;
         continuous_loop  = FALSE;
-        test_num         = 0;
+        sim_context.test_num         = 0;
     }
 
 } /* simulation_loop_report() */
@@ -895,6 +973,12 @@ static void print_maintenance_menu( void )
     MESS_OUT_message( (S8*)"=   MD  - Debug mode                 =", MESSAGE_OP_INFO );
     MESS_OUT_message( (S8*)"=   MC  - Compile date & time        =", MESSAGE_OP_INFO );
     MESS_OUT_message( (S8*)"=   MR  - Run all test cases         =", MESSAGE_OP_INFO );
+    MESS_OUT_message( (S8*)"=   ME  - Event driven simulation    =", MESSAGE_OP_INFO );
+    MESS_OUT_message( (S8*)"=   MH  - Heap ready queue           =", MESSAGE_OP_INFO );
+    MESS_OUT_message( (S8*)"=   MW  - Wheel idle/waiting queues  =", MESSAGE_OP_INFO );
+#ifndef DEV_SYSTEM
+    MESS_OUT_message( (S8*)"=   MP  - Parallel sweep of cases    =", MESSAGE_OP_INFO );
+#endif
     MESS_OUT_message( (S8*)"=                                    =", MESSAGE_OP_INFO );
     MESS_OUT_message( (S8*)"======================================", MESSAGE_OP_INFO );
 
@@ -22,6 +22,13 @@
 * 15-04-05 |JRO| Added MUF scheduler                                          *
 * 16-04-05 |JRO| Added RTO skip scheduler                                     *
 * 17-04-05 |JRO| Added screen control for development system                  *
+* 17-10-26 |JRO| Added event driven time advance to simulation loop           *
+* 17-10-26 |JRO| Added TST_run_simulation() for the parallel sweep            *
+* 17-10-26 |JRO| Added TST_new_test() for sweep and batch runs                *
+* 17-10-26 |JRO| Debug and verbose messages through MESS_OUT_DEBUG/VERBOSE    *
+* 17-10-26 |JRO| Scheduler time histogram in the test case report             *
+* 17-10-26 |JRO| SCH_start() phase profile in the test case report            *
+* 17-10-26 |JRO| Added TST_reset_test() for task sets made up at run time     *
 *          |   |                                                              *
 *                                                                             *
 ******************************************************************************/
@@ -40,26 +47,15 @@
 #include "term.h"
 #include "test_case.h"
 #include "test.h"
+#include "latency.h"
+#include "context.h"
 
-#ifndef DEV_SYSTEM
-static U32 timeval;
-#endif
-
-/* globally shared test variables */
-mode_type mode;
-U32 test_duration;
-U8  test_num;
+/* simulation context driven by the terminal */
+struct sim_context_type sim_context;
 
-/* test case report variable array */
-struct test_case_report_values_type
-{
-    S8   name[MAX_LINE_LEN];   /* name of parameter  */
-    U32  value;                /* value of parameter */
-};
-
-static struct test_case_report_values_type test_case_report_values[TST_MAX_TST];
-static U32 calculate_utility_value( void );
-static void reset_report_values( void );
+static U32 calculate_utility_value( struct sim_context_type *ctx );
+static void reset_report_values( struct sim_context_type *ctx );
+static void simulation_step( struct sim_context_type *ctx );
 
 
 /******************************************************************************
@@ -70,22 +66,29 @@ static void reset_report_values( void );
 /******************************************************************************
 *  Function    : TST_init
 *  Description : Initialised test object
-*  Parameters  : none
+*  Parameters  : ctx - simulation context
 *  Returns     : none
 ******************************************************************************/
-void TST_init( void )
+void TST_init( struct sim_context_type *ctx )
 {
-    UTL_string_copy( test_case_report_values[ZERO_CPV ].name, (S8*)"Test Duration    : " );
-    UTL_string_copy( test_case_report_values[ONE_CPV  ].name, (S8*)"Pre-emptions     : " );
-    UTL_string_copy( test_case_report_values[TWO_CPV  ].name, (S8*)"Skips            : " );
-    UTL_string_copy( test_case_report_values[THREE_CPV].name, (S8*)"Removed tasks    : " );
-    UTL_string_copy( test_case_report_values[FOUR_CPV ].name, (S8*)"Doubled periods  : " );
-    UTL_string_copy( test_case_report_values[FIVE_CPV ].name, (S8*)"Missed deadlines : " );
-    UTL_string_copy( test_case_report_values[SIX_CPV  ].name, (S8*)"Met deadlines    : " );
-    UTL_string_copy( test_case_report_values[SEVEN_CPV].name, (S8*)"Value            : " );
-    UTL_string_copy( test_case_report_values[EIGHT_CPV].name, (S8*)"Achieved util (%): " );
-
-    reset_report_values();
+    UTL_string_copy( ctx->test_case_report_values[ZERO_CPV ].name, (S8*)"Test Duration    : " );
+    UTL_string_copy( ctx->test_case_report_values[ONE_CPV  ].name, (S8*)"Pre-emptions     : " );
+    UTL_string_copy( ctx->test_case_report_values[TWO_CPV  ].name, (S8*)"Skips            : " );
+    UTL_string_copy( ctx->test_case_report_values[THREE_CPV].name, (S8*)"Removed tasks    : " );
+    UTL_string_copy( ctx->test_case_report_values[FOUR_CPV ].name, (S8*)"Doubled periods  : " );
+    UTL_string_copy( ctx->test_case_report_values[FIVE_CPV ].name, (S8*)"Missed deadlines : " );
+    UTL_string_copy( ctx->test_case_report_values[SIX_CPV  ].name, (S8*)"Met deadlines    : " );
+    UTL_string_copy( ctx->test_case_report_values[SEVEN_CPV].name, (S8*)"Value            : " );
+    UTL_string_copy( ctx->test_case_report_values[EIGHT_CPV].name, (S8*)"Achieved util (%): " );
+
+    /* default simulation settings */
+    ctx->timeval       = ZERO_CPV;
+    ctx->mode          = MODE_TERMINAL;
+    ctx->test_duration = TEN_CPV;
+    ctx->test_num      = ZERO_CPV;
+    ctx->event_mode    = TRUE;
+
+    reset_report_values( ctx );
 
 } /* TST_init() */
 
@@ -93,12 +96,12 @@ void TST_init( void )
 /******************************************************************************
 *  Function    : TST_soft_reset
 *  Description : Soft reset of test object
-*  Parameters  : none
+*  Parameters  : ctx - simulation context
 *  Returns     : none
 ******************************************************************************/
-void TST_soft_reset( void )
+void TST_soft_reset( struct sim_context_type *ctx )
 {
-    reset_report_values();
+    reset_report_values( ctx );
 
 } /* TST_init() */
 
@@ -109,10 +112,10 @@ void TST_soft_reset( void )
 *                main program loop. Conditionally compiles
 *                When development system enters main loop, control is handed
 *                over to serial and timer interrupt handlers.
-*  Parameters  : none
+*  Parameters  : ctx - simulation context
 *  Returns     : none
 ******************************************************************************/
-void TST_test( void )
+void TST_test( struct sim_context_type *ctx )
 {
     #ifndef DEV_SYSTEM
 	    /* request welcome screen from terminal */
@@ -140,9 +143,9 @@ void TST_test( void )
         /********************************/
 
         /* main program loop (pc compile) */
-        while( mode is_not MODE_ABORT )
+        while( ctx->mode is_not MODE_ABORT )
         {
-            if( mode is MODE_TERMINAL )
+            if( ctx->mode is MODE_TERMINAL )
             {
                 MESS_OUT_message( (S8*)"\nEnter an option... ", MESSAGE_OP_INFO_NOCR );
 
@@ -160,18 +163,13 @@ void TST_test( void )
             else
             {
                 /* simulation mode - run scheduler */
+                simulation_step( ctx );
 
-                timeval++;                      /* increment timer       */
-
-                TSK_run_task_cycle( timeval );  /* run task              */
-
-                SCH_start( timeval );           /* call scheduler        */
-
-                if( timeval > test_duration )
+                if( ctx->timeval > ctx->test_duration )
                 {
-                    mode = MODE_TERMINAL;       /* end test              */
+                    ctx->mode = MODE_TERMINAL;  /* end test              */
 
-                    TSK_end_of_test();          /* inform task object    */
+                    TSK_end_of_test( ctx );     /* inform task object    */
 
                     TRM_end_of_test();          /* inform term object    */
                 }
@@ -187,63 +185,155 @@ void TST_test( void )
 *  Function    : TST_start_simulation
 *  Description : Starts the scheduler simulation
 *  Notes       : Conditional compilation
-*  Parameters  : none
+*  Parameters  : ctx - simulation context
 *  Returns     : none
 ******************************************************************************/
-void TST_start_simulation( void )
+void TST_start_simulation( struct sim_context_type *ctx )
 {
-    MESS_OUT_message( (S8*)"Entering TST_start_simulation()", 
-                      MESSAGE_OP_DEBUG );
+    MESS_OUT_DEBUG( MESS_OUT_message( (S8*)"Entering TST_start_simulation()", 
+                                      MESSAGE_OP_DEBUG ) );
 
     #ifndef DEV_SYSTEM
-    timeval = 0;     /* reset timer    */
-    SCH_start( 0 );  /* run scheduler  */
+    ctx->timeval = 0; /* reset timer    */
+    SCH_start( ctx, 0 ); /* run scheduler  */
     #endif
 
 } /* TST_start_simulation() */
 
 
+/******************************************************************************
+*  Function    : TST_new_test
+*  Description : initialises a simulation context from scratch and loads a
+*                test case into it, ready for TST_run_simulation()
+*  Parameters  : ctx - simulation context
+*                num - test case number
+*  Returns     : none
+******************************************************************************/
+void TST_new_test( struct sim_context_type *ctx, const U8 num )
+{
+    TST_reset_test( ctx );
+
+    TST_load_test( ctx, num );
+
+} /* TST_new_test() */
+
+
+/******************************************************************************
+*  Function    : TST_reset_test
+*  Description : initialises a simulation context from scratch, with no task
+*                set loaded
+*  Parameters  : ctx - simulation context
+*  Returns     : none
+******************************************************************************/
+void TST_reset_test( struct sim_context_type *ctx )
+{
+    TSK_init( ctx );
+    TST_init( ctx );
+    SCH_init( ctx );
+    TST_soft_reset( ctx );
+    TSK_soft_reset( ctx );
+    SCH_soft_reset( ctx );
+
+} /* TST_reset_test() */
+
+
+/******************************************************************************
+*  Function    : TST_run_simulation
+*  Description : runs a loaded test case through to the end of the test
+*                without returning to the terminal. Used by the parallel
+*                sweep, where each worker thread owns its own context.
+*  Parameters  : ctx - simulation context
+*  Returns     : none
+******************************************************************************/
+void TST_run_simulation( struct sim_context_type *ctx )
+{
+    #ifndef DEV_SYSTEM
+    TST_start_simulation( ctx );        /* start simulation      */
+
+    ctx->mode = MODE_SIMULATION;
+
+    while( ctx->timeval <= ctx->test_duration )
+    {
+        simulation_step( ctx );
+    }
+
+    ctx->mode = MODE_TERMINAL;          /* end test              */
+    #endif
+
+} /* TST_run_simulation() */
+
+
 /******************************************************************************
 *  Function    : TST_continue_simulation
 *  Description : continues the scheduler simulation
-*  Parameters  : None
+*  Parameters  : ctx - simulation context
 *  Returns     : none
 ******************************************************************************/
-void TST_continue_simulation( void )
+void TST_continue_simulation( struct sim_context_type *ctx )
 {
     #ifndef DEV_SYSTEM
-        SCH_start( timeval );   /* run scheduler  */
+        SCH_start( ctx, ctx->timeval ); /* run scheduler  */
     #endif
 
 } /* TST_continue_simulation() */
 
 
+/******************************************************************************
+*  Function    : TST_toggle_event_mode
+*  Description : toggles between event driven and tick by tick simulation.
+*                Event driven runs only report the ticks at which the
+*                scheduler acts; tick by tick gives the full trace.
+*  Parameters  : ctx - simulation context
+*  Returns     : none
+******************************************************************************/
+void TST_toggle_event_mode( struct sim_context_type *ctx )
+{
+    #ifndef DEV_SYSTEM
+    if( ctx->event_mode is FALSE )
+    {
+        MESS_OUT_message( (S8*)"Event driven simulation ON", MESSAGE_OP_LOG );
+        ctx->event_mode = TRUE;
+    }
+    else
+    {
+        MESS_OUT_message( (S8*)"Event driven simulation OFF", MESSAGE_OP_LOG );
+        ctx->event_mode = FALSE;
+    }
+    #endif
+
+} /* TST_toggle_event_mode() */
+
+
 /******************************************************************************
 *  Function    : TSK_load_test
 *  Description : loads a test sequence
-*  Parameters  : test_num - number of test run
+*  Parameters  : ctx     - simulation context
+*                test_num - number of test run
 *  Returns     : none
 ******************************************************************************/
-void TST_load_test( const U8 num )
+void TST_load_test( struct sim_context_type *ctx, const U8 num )
 {
     struct test_case_type test_case;
     struct test_case_type *test_case_ptr;
+    U32 index;
 
-	MESS_OUT_message_1( (S8*)"TST_load_test(): called with ", 
-						 num, MESSAGE_OP_DEBUG );
+	MESS_OUT_DEBUG( MESS_OUT_message_1( (S8*)"TST_load_test(): called with ", 
+						                 num, MESSAGE_OP_DEBUG ) );
 
     test_case_ptr = &test_case;                       /* dereference pointer */
     test_case_ptr = TSC_get_test_case( num );         /* get test case       */
-    test_num      = test_case_ptr->id;                /* test case number    */
-    test_duration = test_case_ptr->length;            /* test length         */
-    SCH_set_algorithm( test_case_ptr->algorithm );    /* algorithm           */
-    SCH_add_task( ONE_CPV  , test_case_ptr->task_1 ); /* load task           */
-    SCH_add_task( TWO_CPV  , test_case_ptr->task_2 ); /* load task           */
-    SCH_add_task( THREE_CPV, test_case_ptr->task_3 ); /* load task           */
-    SCH_add_task( FOUR_CPV , test_case_ptr->task_4 ); /* load task           */
-    SCH_add_task( FIVE_CPV , test_case_ptr->task_5 ); /* load task           */
-    SCH_add_task( SIX_CPV  , test_case_ptr->task_6 ); /* load task           */
-    SCH_add_task( SEVEN_CPV, test_case_ptr->task_7 ); /* load task           */
+    ctx->test_num      = test_case_ptr->id;           /* test case number    */
+    ctx->test_duration = test_case_ptr->length;       /* test length         */
+    SCH_set_algorithm( ctx, test_case_ptr->algorithm ); /* algorithm           */
+
+    /* size the task table for the task set */
+    if( TSK_size_task_table( ctx, test_case_ptr->num_tasks ) is TRUE )
+    {
+        for( index=ZERO_CPV; index<test_case_ptr->num_tasks; index++ )
+        {
+            SCH_add_task( ctx, index + ONE_CPV, test_case_ptr->task_list[index] );
+        }
+    }
 
 } /* TST_load_test() */
 
@@ -251,12 +341,13 @@ void TST_load_test( const U8 num )
 /******************************************************************************
 *  Function    : TST_incr_test_report_value
 *  Description : increments parameter in test case report values array
-*  Parameters  : parm  - index in report value array
+*  Parameters  : ctx     - simulation context
+*                parm  - index in report value array
 *  Returns     : none
 ******************************************************************************/
-void TST_incr_test_report_value( const test_case_parm_index_type parm )
+void TST_incr_test_report_value( struct sim_context_type *ctx, const test_case_parm_index_type parm )
 {
-    test_case_report_values[parm].value++;
+    ctx->test_case_report_values[parm].value++;
 
 } /* TST_incr_test_report_value() */
 
@@ -264,14 +355,15 @@ void TST_incr_test_report_value( const test_case_parm_index_type parm )
 /******************************************************************************
 *  Function    : TST_add_test_report_value
 *  Description : adds parameter in test case report values array
-*  Parameters  : parm  - index in report value array
+*  Parameters  : ctx     - simulation context
+*                parm  - index in report value array
 *                val   - value to be added to value array
 *  Returns     : none
 ******************************************************************************/
-void TST_add_test_report_value( const test_case_parm_index_type parm,
+void TST_add_test_report_value( struct sim_context_type *ctx, const test_case_parm_index_type parm,
                                 const U32 val )
 {
-    test_case_report_values[parm].value += val;
+    ctx->test_case_report_values[parm].value += val;
 
 } /* TST_add_test_report_value() */
 
@@ -279,14 +371,15 @@ void TST_add_test_report_value( const test_case_parm_index_type parm,
 /******************************************************************************
 *  Function    : TST_set_test_report_value
 *  Description : sets parameter in test case report values array
-*  Parameters  : parm  - index in report value array
+*  Parameters  : ctx     - simulation context
+*                parm  - index in report value array
 *                val   - value to be set to value array
 *  Returns     : none
 ******************************************************************************/
-void TST_set_test_report_value( const test_case_parm_index_type parm,
+void TST_set_test_report_value( struct sim_context_type *ctx, const test_case_parm_index_type parm,
                                 const U32 val )
 {
-    test_case_report_values[parm].value = val;
+    ctx->test_case_report_values[parm].value = val;
 
 } /* TST_add_test_report_value() */
 
@@ -294,10 +387,10 @@ void TST_set_test_report_value( const test_case_parm_index_type parm,
 /******************************************************************************
 *  Function    : TST_test_report
 *  Description : reports test case results at end of test
-*  Parameters  : none
+*  Parameters  : ctx - simulation context
 *  Returns     : none
 ******************************************************************************/
-void TST_test_report( void )
+void TST_test_report( struct sim_context_type *ctx )
 {
     U32 index;
 	U32 utility;
@@ -306,32 +399,79 @@ void TST_test_report( void )
     MESS_OUT_message( (S8*)  "================", MESSAGE_OP_RESULTS );
 
 	/* calculate the utility value */
-	utility = calculate_utility_value(); 
-	TST_set_test_report_value( TST_UTILITY, utility );
+	utility = calculate_utility_value( ctx ); 
+	TST_set_test_report_value( ctx, TST_UTILITY, utility );
 
     for( index=ZERO_CPV; index<(U32)TST_MAX_TST; index++ )
     {
-        MESS_OUT_message_1( (S8*)test_case_report_values[index].name,
-                            test_case_report_values[index].value, 
+        MESS_OUT_message_1( (S8*)ctx->test_case_report_values[index].name,
+                            ctx->test_case_report_values[index].value, 
                             MESSAGE_OP_RESULTS );
     }
 
+    /* scheduler time percentiles and slowest calls */
+    LAT_report( &ctx->latency );
+
+#if SCH_PROFILE
+    /* where the scheduler time went */
+    SCH_profile_report( ctx );
+#endif
+
 } /* TST_test_report() */
 
 
+/******************************************************************************
+*  Function    : simulation_step
+*  Description : private helper - advances the simulation by one tick, or
+*                in event mode to the next scheduling event, then runs the
+*                scheduler
+*  Parameters  : ctx - simulation context
+*  Returns     : none
+******************************************************************************/
+static void simulation_step( struct sim_context_type *ctx )
+{
+    U32 next_event;
+
+    if( ctx->event_mode is TRUE )
+    {
+        /* jump to the next scheduling event, but not past */
+        /* the end of the test                             */
+        next_event = SCH_next_event( ctx, ctx->timeval );
+        if( next_event > (ctx->test_duration + ONE_CPV) )
+        {
+            next_event = ctx->test_duration + ONE_CPV;
+        }
+
+        /* run task up to the event */
+        TSK_run_task_cycles( ctx, next_event, next_event - ctx->timeval );
+
+        ctx->timeval = next_event;      /* advance timer         */
+    }
+    else
+    {
+        ctx->timeval++;                 /* increment timer       */
+
+        TSK_run_task_cycle( ctx, ctx->timeval ); /* run task     */
+    }
+
+    SCH_start( ctx, ctx->timeval );     /* call scheduler        */
+
+} /* simulation_step() */
+
+
 /******************************************************************************
 *  Function    : calculate_utility_value
 *  Description : private helper used by TST_test_report to calculate the
 *                achieved task set utility value
-*  Parameters  : none
+*  Parameters  : ctx - simulation context
 *  Returns     : none
 ******************************************************************************/
-static U32 calculate_utility_value( void )
+static U32 calculate_utility_value( struct sim_context_type *ctx )
 {
 	struct UTL_div_type UTL_div; 
 	
-	UTL_divide( (test_case_report_values[TST_VALUE].value * ONE_HUNDRED_CPV), 
-			    test_case_report_values[TST_DURATION].value, 
+	UTL_divide( (ctx->test_case_report_values[TST_VALUE].value * ONE_HUNDRED_CPV), 
+			    ctx->test_case_report_values[TST_DURATION].value, 
 			    &UTL_div );
 
 	return( UTL_div.quotient );    
@@ -342,17 +482,19 @@ static U32 calculate_utility_value( void )
 /******************************************************************************
 *  Function    : reset_report_values
 *  Description : Resets values in the report array
-*  Parameters  : none
+*  Parameters  : ctx - simulation context
 *  Returns     : none
 ******************************************************************************/
-void reset_report_values( void )
+void reset_report_values( struct sim_context_type *ctx )
 {
     U32 index;
 
     /* initialise test report */
     for( index=ZERO_CPV; index<(U32)TST_MAX_TST; index++ )
     {
-        test_case_report_values[index].value = ZERO_CPV;
+        ctx->test_case_report_values[index].value = ZERO_CPV;
     }
 
+    LAT_reset( &ctx->latency );
+
 } /* reset_report_values() */
@@ -16,6 +16,10 @@
 * date     |Aut| Description                                                  *
 * 10-03-05 |JRO| Created                                                      *
 * 17-04-05 |JRO| Added screen control for development system                  *
+* 17-10-26 |JRO| Added TST_toggle_event_mode()                                *
+* 17-10-26 |JRO| Entry points take a simulation context                       *
+* 17-10-26 |JRO| Added TST_run_simulation() & TST_new_test()                  *
+* 17-10-26 |JRO| Added TST_reset_test()                                       *
 *          |   |                                                              *
 *                                                                             *
 ******************************************************************************/
@@ -38,20 +42,26 @@ typedef enum
     TST_MAX_TST
 }test_case_parm_index_type;
 
+/* simulation context, see context.h */
+struct sim_context_type;
 
-void TST_init( void );
-void TST_soft_reset( void );
-void TST_test( void );
-void TST_start_simulation( void );
-void TST_continue_simulation( void );
-void TST_abort( void );
-void TST_load_test( const U8 num );
-void TST_get_test_loop( const U8 num );
-void TST_incr_test_report_value( const test_case_parm_index_type parm );
-void TST_set_test_report_value( const test_case_parm_index_type parm,
+void TST_init( struct sim_context_type *ctx );
+void TST_soft_reset( struct sim_context_type *ctx );
+void TST_test( struct sim_context_type *ctx );
+void TST_start_simulation( struct sim_context_type *ctx );
+void TST_continue_simulation( struct sim_context_type *ctx );
+void TST_run_simulation( struct sim_context_type *ctx );
+void TST_new_test( struct sim_context_type *ctx, const U8 num );
+void TST_reset_test( struct sim_context_type *ctx );
+void TST_toggle_event_mode( struct sim_context_type *ctx );
+void TST_abort( struct sim_context_type *ctx );
+void TST_load_test( struct sim_context_type *ctx, const U8 num );
+void TST_get_test_loop( struct sim_context_type *ctx, const U8 num );
+void TST_incr_test_report_value( struct sim_context_type *ctx, const test_case_parm_index_type parm );
+void TST_set_test_report_value( struct sim_context_type *ctx, const test_case_parm_index_type parm,
                                 const U32 val );
-void TST_add_test_report_value( const test_case_parm_index_type parm,
+void TST_add_test_report_value( struct sim_context_type *ctx, const test_case_parm_index_type parm,
                                 const U32 value );
-void TST_test_report( void );
+void TST_test_report( struct sim_context_type *ctx );
 
 #endif /* _TEST_H_ */
@@ -18,6 +18,7 @@
 * 25-06-05 |JRO| Added ALG_ADAP_01 & ALG_ADAP_02 scheduler                    *
 * 26-06-05 |JRO| Added ALG_ADAP_03 & ALG_ADAP_04 scheduler                    *
 * 15-07-05 |JRO| Added ALG_ADAP_05 & ALG_ADAP_06 scheduler                    *
+* 17-10-26 |JRO| Debug and verbose messages through MESS_OUT_DEBUG/VERBOSE    *
 *          |   |                                                              *
 *                                                                             *
 ******************************************************************************/
@@ -284,9 +285,9 @@ void TSC_report_test_case_notes( const U8 test_case )
 		init_notes();
 	}
 
-    MESS_OUT_message_1( (S8*)"TSC_report_note() called with ",
-				        test_case,
-                        MESSAGE_OP_DEBUG );
+    MESS_OUT_DEBUG( MESS_OUT_message_1( (S8*)"TSC_report_note() called with ",
+				                        test_case,
+                                        MESSAGE_OP_DEBUG ) );
 	
 	if( test_case < MAX_TEST_CASES )
 	{  
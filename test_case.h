@@ -15,6 +15,7 @@
 *                                                                             *
 * date     |who| description                                                  *
 * 26-04-05 |JRO| Created                                                      *
+* 17-10-26 |JRO| Fixed seven tasks replaced by a task list                    *
 *          |   |                                                              *
 *                                                                             *
 ******************************************************************************/
@@ -27,15 +28,13 @@ struct test_case_type
     const U8             id;            /* id of test case     */
     const U32            length;        /* length of test      */
     const algorithm_type algorithm;     /* scheduler algorithm */
-    const U8             task_1;        /* test task           */
-    const U8             task_2;        /* test task           */
-    const U8             task_3;        /* test task           */
-    const U8             task_4;        /* test task           */
-    const U8             task_5;        /* test task           */
-    const U8             task_6;        /* test task           */
-    const U8             task_7;        /* test task           */
+    const U32            num_tasks;     /* tasks in the list   */
+    const U8     * const task_list;     /* test task ids       */
 };
 
+/* fills num_tasks and task_list from a task id array */
+#define TASK_LIST(x)    (U32)(sizeof(x) / sizeof((x)[0])), (x)
+
 struct test_case_type *TSC_get_test_case( const U8 case_no );
 void TSC_report_test_case( const U8 c, const message_class class );
 void TSC_report_test_case_notes( const U8 test_case );
@@ -23,6 +23,7 @@
 * 10-03-05 |JRO| Ported from Keil uVision/ARM development tools               *
 * 11-03-05 |JRO| changed C++ comments to please pclint.                       *
 * 17-04-05 |JRO| Added screen control for development system                  *
+* 17-10-26 |JRO| Drives simulation through sim_context                        *
 *          |   |                                                              *
 *                                                                             *
 ******************************************************************************/
@@ -40,6 +41,7 @@
 #include "rt_clock.h"
 #include "scheduler.h"
 #include "term.h"
+#include "context.h"
 
 static volatile U32 timeval;
 
@@ -138,7 +140,7 @@ void TIM_start( void )
 void TIM_start_simulation( void )
 {
     timeval = 0;     /* reset timer      */
-    SCH_start( 0 );  /* run scheduler    */
+    SCH_start( &sim_context, 0 ); /* run scheduler    */
     TIM_start();     /* start the timer  */
 
 } /* TIM_start_simulation() */
@@ -166,7 +168,7 @@ void TIM_start_simulation( void )
 ******************************************************************************/
 void TIM_continue_simulation( void )
 {
-    SCH_start( timeval );                  /* run scheduler    */
+    SCH_start( &sim_context, timeval );    /* run scheduler    */
 
 } /* TIM_continue_simulation() */
 
@@ -206,18 +208,18 @@ void TIM_continue_simulation( void )
 ******************************************************************************/
 void tc0( void )
 { 
-    if( mode is MODE_SIMULATION )
+    if( sim_context.mode is MODE_SIMULATION )
     {
         timeval++;                      /* increment timer       */
 
-        TSK_run_task_cycle( timeval );  /* run task              */
+        TSK_run_task_cycle( &sim_context, timeval ); /* run task              */
 
-        SCH_start( timeval );           /* call scheduler        */
+        SCH_start( &sim_context, timeval ); /* call scheduler        */
 
-        if( timeval > test_duration )
+        if( timeval > sim_context.test_duration )
         {
-            mode = MODE_TERMINAL;       /* end test              */
-            TSK_end_of_test();          /* inform task object    */
+            sim_context.mode = MODE_TERMINAL; /* end test              */
+            TSK_end_of_test( &sim_context ); /* inform task object    */
             TRM_end_of_test();          /* inform term object    */
         }
     }
@@ -0,0 +1,394 @@
+/******************************************************************************
+*                                                                             *
+*                                                                             *
+*                                                                             *
+*******************************************************************************
+*                                                                             *
+* Project     :   SCHEDULER SIMULATOR
+*                                                                             *
+* File Name   :  trace.c                                                      *
+*                                                                             *
+* Description :  Results trace formats. Task report codes and the report      *
+*                words they are shown as, the binary trace record layout      *
+*                and the conversion of a binary trace back to the text one.   *
+*                Shared by the simulator and the trace converter, so it       *
+*                uses nothing from the rest of the simulator.                 *
+*                                                                             *
+*******************************************************************************
+* Modification record:                                                        *
+*                                                                             *
+* Date     |Aut| Description                                                  *
+* 17-10-26 |JRO| Created                                                      *
+* 17-10-26 |JRO| Added TRC_repeat(), repeat records expanded by TRC_convert() *
+*          |   |                                                              *
+*                                                                             *
+******************************************************************************/
+#include "globals.h"
+#include "task.h"          /* task states                   */
+#include "trace.h"         /* interface file                */
+
+#ifndef DEV_SYSTEM
+	/*lint -e85 has dimension 0 */
+    #include <stdio.h>     /* gcc output libraries          */
+	/*lint +e85 has dimension 0 */
+    #include <stdlib.h>    /* task code buffer              */
+    #include <string.h>    /* memcmp()                      */
+
+static boolean get_number( FILE *in, U32 *value );
+static boolean copy_text( FILE *in, FILE *out, const U32 length );
+static void put_tick( FILE *out, const U32 time, const U8 *codes,
+                      const U32 tasks, const U32 overhead, const S32 overrun );
+#endif /* DEV_SYSTEM */
+
+
+/******************************************************************************
+*                              PUBLIC FUNCTIONS
+******************************************************************************/
+
+
+/******************************************************************************
+*  Function    : TRC_word
+*  Description : gets the eight character report word of a task report code
+*  Parameters  : code - task report code
+*  Returns     : report word
+******************************************************************************/
+const S8 *TRC_word( const U8 code )
+{
+    const S8 *word;
+
+    if( (code & TRC_DEADLINE) is_not ZERO_CPV )
+    {
+        word = (S8*)"<-DDDD->";
+    }
+    else
+    {
+        switch( (task_state_type)(code & TRC_STATE_MASK) )
+        {
+            case TSK_RUN:
+                word = ((code & TRC_LATE) is_not ZERO_CPV) ? (S8*)"  LATE  " :
+                       ((code & TRC_OVER) is_not ZERO_CPV) ? (S8*)"  OVER  " :
+                                                             (S8*)"  ++++  ";
+                break;
+
+            case TSK_READY:
+                word = ((code & TRC_LATE) is_not ZERO_CPV) ? (S8*)"  RL..  " :
+                       ((code & TRC_OVER) is_not ZERO_CPV) ? (S8*)"  RO..  " :
+                                                             (S8*)"  r...  ";
+                break;
+
+            case TSK_PREMPT:
+                word = ((code & TRC_LATE) is_not ZERO_CPV) ? (S8*)"  PL..  " :
+                       ((code & TRC_OVER) is_not ZERO_CPV) ? (S8*)"  PO..  " :
+                                                             (S8*)"  p...  ";
+                break;
+
+            case TSK_WAITING: word = (S8*)"  wait  "; break;
+            case TSK_IDLE:    word = (S8*)"  i...  "; break;
+            case TSK_SKIPPED: word = (S8*)"  sk..  "; break;
+            case TSK_REMOVED: word = (S8*)"  rm..  "; break;
+            case TSK_SLEEP:
+            default:          word = (S8*)"  s...  "; break;
+        }
+    }
+
+    return( word );
+
+} /* TRC_word() */
+
+
+/******************************************************************************
+*  Function    : TRC_put_number
+*  Description : writes a number into a binary trace buffer
+*  Parameters  : buffer - where the number goes
+*                value  - number
+*  Returns     : bytes written
+******************************************************************************/
+U32 TRC_put_number( U8 *buffer, const U32 value )
+{
+    buffer[ZERO_CPV]  = (U8)(value);
+    buffer[ONE_CPV]   = (U8)(value >> 8);
+    buffer[TWO_CPV]   = (U8)(value >> 16);
+    buffer[THREE_CPV] = (U8)(value >> 24);
+
+    return( FOUR_CPV );
+
+} /* TRC_put_number() */
+
+
+/******************************************************************************
+*  Function    : TRC_tick_head
+*  Description : builds the start of a tick record, the task codes follow
+*  Parameters  : buffer   - TRC_TICK_HEAD_SIZE bytes
+*                time     - system time
+*                overhead - scheduler execution time
+*                running  - running task, 0 if none
+*                overrun  - TRUE if a task has overrun its deadline
+*  Returns     : bytes written
+******************************************************************************/
+U32 TRC_tick_head( U8 *buffer, const U32 time, const U32 overhead,
+                   const U32 running, const boolean overrun )
+{
+    U32 size;
+
+    buffer[ZERO_CPV] = (U8)TRC_REC_TICK;
+    size  = ONE_CPV;
+    size += TRC_put_number( &buffer[size], time );
+    size += TRC_put_number( &buffer[size], overhead );
+    size += TRC_put_number( &buffer[size], running );
+    buffer[size] = (overrun is TRUE) ? ONE_CPV : ZERO_CPV;
+    size++;
+
+    return( size );
+
+} /* TRC_tick_head() */
+
+
+/******************************************************************************
+*  Function    : TRC_repeat
+*  Description : builds a repeat record, for the change only trace
+*  Parameters  : buffer   - TRC_REPEAT_SIZE bytes
+*                ticks    - further ticks the last tick record held for
+*                overhead - total scheduler execution time of those ticks
+*  Returns     : bytes written
+******************************************************************************/
+U32 TRC_repeat( U8 *buffer, const U32 ticks, const U32 overhead )
+{
+    U32 size;
+
+    buffer[ZERO_CPV] = (U8)TRC_REC_REPEAT;
+    size  = ONE_CPV;
+    size += TRC_put_number( &buffer[size], ticks );
+    size += TRC_put_number( &buffer[size], overhead );
+
+    return( size );
+
+} /* TRC_repeat() */
+
+
+/******************************************************************************
+*  Function    : TRC_convert
+*  Description : renders a binary trace as the text trace, line for line
+*                as the simulator would have written it. The repeats of a
+*                change only trace are expanded to a line per tick, each
+*                showing the mean overhead of the repeated ticks
+*  Parameters  : in_name  - binary trace file
+*                out_name - text file, or NULL for the standard output
+*  Returns     : TRUE if the whole trace was converted
+******************************************************************************/
+boolean TRC_convert( const S8 *in_name, const S8 *out_name )
+{
+#ifndef DEV_SYSTEM
+    S8 magic[TRC_MAGIC_SIZE];
+    FILE *in;
+    FILE *out;
+    U8 *codes = NULL;
+    U32 tasks = ZERO_CPV;
+    U32 time = ZERO_CPV;
+    U32 overhead;
+    U32 running;
+    U32 ticks;
+    U32 length;
+    U32 index;
+    S32 type;
+    S32 overrun;
+    boolean valid = TRUE;
+
+    in  = fopen( in_name, (S8*)"rb" );
+    out = (out_name is NULL) ? stdout : fopen( out_name, (S8*)"w" );
+
+    if( (in is NULL) or (out is NULL) )
+    {
+        valid = FALSE;
+    }
+    else if( (fread( magic, ONE_CPV, TRC_MAGIC_SIZE, in ) is_not TRC_MAGIC_SIZE) or
+             (memcmp( magic, TRC_MAGIC, TRC_MAGIC_SIZE ) is_not ZERO_CPV) )
+    {
+        /* not a binary trace */
+        valid = FALSE;
+    }
+    else
+    {
+        while( (valid is TRUE) and ((type = fgetc( in )) is_not EOF) )
+        {
+            switch( type )
+            {
+                case TRC_REC_TEXT:
+                case TRC_REC_LINE:
+                    valid = get_number( in, &length );
+                    if( valid is TRUE )
+                    {
+                        valid = copy_text( in, out, length );
+                    }
+                    if( (valid is TRUE) and (type is TRC_REC_LINE) )
+                    {
+                        (void)fputc( '\n', out );
+                    }
+                    break;
+
+                case TRC_REC_TASKS:
+                    valid = get_number( in, &tasks );
+                    if( valid is TRUE )
+                    {
+                        free( codes );
+                        codes = (U8*)malloc( tasks + ONE_CPV );
+                        valid = (codes is_not NULL) ? TRUE : FALSE;
+                    }
+                    break;
+
+                case TRC_REC_TICK:
+                    if( (codes is NULL) or
+                        (get_number( in, &time ) is FALSE) or
+                        (get_number( in, &overhead ) is FALSE) or
+                        (get_number( in, &running ) is FALSE) or
+                        ((overrun = fgetc( in )) is EOF) or
+                        (fread( codes, ONE_CPV, tasks, in ) is_not tasks) )
+                    {
+                        valid = FALSE;
+                    }
+                    else
+                    {
+                        put_tick( out, time, codes, tasks, overhead, overrun );
+                    }
+                    break;
+
+                case TRC_REC_REPEAT:
+                    if( (codes is NULL) or
+                        (get_number( in, &ticks ) is FALSE) or
+                        (get_number( in, &overhead ) is FALSE) or
+                        (ticks is ZERO_CPV) )
+                    {
+                        valid = FALSE;
+                    }
+                    else
+                    {
+                        /* the held ticks follow on, none overran */
+                        overhead = overhead / ticks;
+                        for( index=ZERO_CPV; index<ticks; index++ )
+                        {
+                            time++;
+                            put_tick( out, time, codes, tasks, overhead, ZERO_CPV );
+                        }
+                    }
+                    break;
+
+                default:
+                    valid = FALSE;
+                    break;
+            }
+        }
+    }
+
+    free( codes );
+
+    if( in is_not NULL )
+    {
+        (void)fclose( in );
+    }
+    if( (out is_not NULL) and (out is_not stdout) )
+    {
+        (void)fclose( out );
+    }
+
+    return( valid );
+#else
+    return( FALSE );
+#endif
+
+} /* TRC_convert() */
+
+
+/******************************************************************************
+*                            PRIVATE FUNCTIONS
+******************************************************************************/
+
+#ifndef DEV_SYSTEM
+
+/******************************************************************************
+*  Function    : get_number
+*  Description : private helper - reads a number from a binary trace
+*  Parameters  : in    - binary trace
+*                value - returned number
+*  Returns     : FALSE at the end of the file
+******************************************************************************/
+static boolean get_number( FILE *in, U32 *value )
+{
+    U8 bytes[FOUR_CPV];
+    boolean valid = FALSE;
+
+    if( fread( bytes, ONE_CPV, FOUR_CPV, in ) is FOUR_CPV )
+    {
+        *value = (U32)bytes[ZERO_CPV]
+               | ((U32)bytes[ONE_CPV]   << 8)
+               | ((U32)bytes[TWO_CPV]   << 16)
+               | ((U32)bytes[THREE_CPV] << 24);
+        valid = TRUE;
+    }
+
+    return( valid );
+
+} /* get_number() */
+
+
+/******************************************************************************
+*  Function    : copy_text
+*  Description : private helper - copies the text of a text record
+*  Parameters  : in     - binary trace
+*                out    - text trace
+*                length - characters to copy
+*  Returns     : FALSE if the trace ends first
+******************************************************************************/
+static boolean copy_text( FILE *in, FILE *out, const U32 length )
+{
+    S8 text[MAX_LINE_LEN];
+    U32 left = length;
+    U32 size;
+    boolean valid = TRUE;
+
+    while( (left > ZERO_CPV) and (valid is TRUE) )
+    {
+        size = (left > MAX_LINE_LEN) ? MAX_LINE_LEN : left;
+
+        if( fread( text, ONE_CPV, size, in ) is size )
+        {
+            (void)fwrite( text, ONE_CPV, size, out );
+            left -= size;
+        }
+        else
+        {
+            valid = FALSE;
+        }
+    }
+
+    return( valid );
+
+} /* copy_text() */
+
+
+/******************************************************************************
+*  Function    : put_tick
+*  Description : private helper - writes a scheduler report line, as
+*                MESS_OUT_scheduler_report() would
+*  Parameters  : out      - text trace
+*                time     - system time
+*                codes    - task report codes
+*                tasks    - number of tasks
+*                overhead - scheduler execution time
+*                overrun  - 1 if a task has overrun its deadline
+*  Returns     : none
+******************************************************************************/
+static void put_tick( FILE *out, const U32 time, const U8 *codes,
+                      const U32 tasks, const U32 overhead, const S32 overrun )
+{
+    U32 index;
+
+    (void)fprintf( out, (S8*)"%05d ", (S32)time );
+    for( index=ZERO_CPV; index<tasks; index++ )
+    {
+        (void)fputs( TRC_word( codes[index] ), out );
+    }
+    (void)fprintf( out, (S8*)" %05d   %s\n", (S32)overhead,
+                   (overrun is ONE_CPV) ? "OVERRUN" : "" );
+
+} /* put_tick() */
+
+#endif /* DEV_SYSTEM */
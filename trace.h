@@ -0,0 +1,66 @@
+/******************************************************************************
+*                                                                             *
+*                                                                             *
+*                                                                             *
+*******************************************************************************
+*                                                                             *
+* Project     :   SCHEDULER SIMULATOR                                         *
+*                                                                             *
+* File Name   :  trace.h                                                      *
+*                                                                             *
+* Description :  Interface file for trace.c                                   *
+*                                                                             *
+*******************************************************************************
+* Modification record:                                                        *
+*                                                                             *
+* Date     |Aut| Description                                                  *
+* 17-10-26 |JRO| Created                                                      *
+* 17-10-26 |JRO| Added change only trace, TRC_REC_REPEAT                      *
+*          |   |                                                              *
+*                                                                             *
+******************************************************************************/
+#ifndef _TRACE_H_
+#define _TRACE_H_
+
+/* results trace formats */
+typedef enum
+{
+    TRC_MODE_TEXT,      /* a text line per tick                  */
+    TRC_MODE_BINARY,    /* a packed record per tick, see below   */
+    TRC_MODE_CHANGES,   /* binary, a record when the tick changes */
+    TRC_MODE_MAX
+}trace_mode_type;
+
+/* task report code - one byte per task per tick, the task state and how
+   it stands against its deadline. Rendered by TRC_word() */
+#define TRC_STATE_MASK      0x07    /* task_state_type                    */
+#define TRC_DEADLINE        0x08    /* deadline falls this tick           */
+#define TRC_LATE            0x10    /* can no longer meet its deadline    */
+#define TRC_OVER            0x20    /* deadline passed                    */
+
+/* binary trace file - TRC_MAGIC, then records, each led by its record
+   type byte. Numbers are four bytes, least significant first */
+#define TRC_MAGIC           "SSTR1"
+#define TRC_MAGIC_SIZE      5
+#define TRC_TICK_HEAD_SIZE  14      /* tick record up to the task codes   */
+#define TRC_REPEAT_SIZE     9       /* repeat record                      */
+
+typedef enum
+{
+    TRC_REC_TEXT = 1,   /* length, text                                    */
+    TRC_REC_LINE,       /* length, text, then end of line                  */
+    TRC_REC_TASKS,      /* task codes in each following tick record        */
+    TRC_REC_TICK,       /* time, overhead, running task, overrun flag byte,
+                           then one code per task                          */
+    TRC_REC_REPEAT      /* ticks, total overhead - the last tick record held
+                           for that many more ticks, change only trace     */
+}trace_record_type;
+
+const S8 *TRC_word( const U8 code );
+U32 TRC_put_number( U8 *buffer, const U32 value );
+U32 TRC_tick_head( U8 *buffer, const U32 time, const U32 overhead,
+                   const U32 running, const boolean overrun );
+U32 TRC_repeat( U8 *buffer, const U32 ticks, const U32 overhead );
+boolean TRC_convert( const S8 *in_name, const S8 *out_name );
+
+#endif /* _TRACE_H_ */
@@ -0,0 +1,67 @@
+/******************************************************************************
+*                                                                             *
+*                                                                             *
+*                                                                             *
+*******************************************************************************
+*                                                                             *
+* Project     :   SCHEDULER SIMULATOR
+*                                                                             *
+* File Name   :  trace_conv.c                                                 *
+*                                                                             *
+* Description :  Trace converter (PC only), built on its own from             *
+*                TraceConv.msp with trace.c. Renders a binary trace, as       *
+*                written by SchedSim -b or -r, as the text trace. The change  *
+*                only trace (-r) is expanded to a line per tick.              *
+*                                                                             *
+*                Usage: TraceConv trace_file [text_file]                      *
+*                  the text goes to the standard output if no text file       *
+*                  is given                                                   *
+*                                                                             *
+*******************************************************************************
+* Modification record:                                                        *
+*                                                                             *
+* Date     |Aut| Description                                                  *
+* 17-10-26 |JRO| Created                                                      *
+* 17-10-26 |JRO| Expands the change only trace                                *
+*          |   |                                                              *
+*                                                                             *
+******************************************************************************/
+#include "globals.h"
+#include "trace.h"         /* trace formats                 */
+
+/*lint -e85 has dimension 0 */
+#include <stdio.h>         /* gcc output libraries          */
+/*lint +e85 has dimension 0 */
+
+/* exit codes */
+#define CONV_EXIT_OK        0     /* trace converted                  */
+#define CONV_EXIT_USAGE     1     /* bad command line                 */
+#define CONV_EXIT_TRACE     2     /* trace could not be converted     */
+
+
+/******************************************************************************
+*  Function    : main
+*  Description : converts the binary trace named on the command line
+*  Parameters  : argc - number of command line arguments
+*                argv - command line arguments
+*  Returns     : CONV_EXIT_OK, CONV_EXIT_USAGE or CONV_EXIT_TRACE
+******************************************************************************/
+S32 main( S32 argc, char *argv[] )
+{
+    S32 status = CONV_EXIT_OK;
+
+    if( (argc < TWO_CPV) or (argc > THREE_CPV) )
+    {
+        (void)fprintf( stderr, "Usage: TraceConv trace_file [text_file]\n" );
+        status = CONV_EXIT_USAGE;
+    }
+    else if( TRC_convert( (S8*)argv[ONE_CPV],
+                          (argc is THREE_CPV) ? (S8*)argv[TWO_CPV] : NULL ) is FALSE )
+    {
+        (void)fprintf( stderr, "TraceConv: %s is not a complete binary trace\n",
+                       argv[ONE_CPV] );
+        status = CONV_EXIT_TRACE;
+    }
+
+    return( status );
+}
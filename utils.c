@@ -18,6 +18,8 @@
 * 30-05-05 |JRO| Added UTL_type_report()                                      *
 * 17-07-05 |JRO| Added UTL_divide()                                           *
 * 12-01-06 |JRO| Fixed terrible bug in divide                                 *
+* 17-10-26 |JRO| UTL_divide() no longer loops once per unit of the quotient   *
+* 17-10-26 |JRO| Added UTL_format_dec() and UTL_format_int()                  *
 *          |   |                                                              *
 *                                                                             *
 ******************************************************************************/
@@ -28,6 +30,28 @@
 #include "test_case.h"
 #include "utils.h"
 
+#define UTL_MAX_DIGITS  10      /* digits in the largest U32 */
+
+/* "00" to "99", so the number formatters take two digits per divide */
+static const S8 digit_pairs[] =
+    "00010203040506070809"
+    "10111213141516171819"
+    "20212223242526272829"
+    "30313233343536373839"
+    "40414243444546474849"
+    "50515253545556575859"
+    "60616263646566676869"
+    "70717273747576777879"
+    "80818283848586878889"
+    "90919293949596979899";
+
+/******************************************************************************
+*  PRIVATE FUNCTION PROTOTYPES
+******************************************************************************/
+static U32 format_digits( S8 *end, U32 num );
+static U32 format_number( S8 *buffer, const U32 magnitude, const boolean negative,
+                          const U32 width, const S8 fill );
+
 
 
 /******************************************************************************
@@ -57,8 +81,11 @@ void UTL_string_copy( S8 *d, const S8 *s )
 
 /******************************************************************************
 *  Function    : UTL_divide
-*  Description : crude interger divide
-*  Notes       : Because Keil gcc does not include DIV or '/'
+*  Description : interger divide, takes the same time whatever the size of
+*                the quotient
+*  Notes       : Keil gcc does not include DIV or '/', so the development
+*                system works out one quotient bit per step by shift and
+*                subtract. The PC build uses the hardware divide.
 *  Parameters  : number  - number to be divided
 *                denom   - interger to divide into number
 *                UTL_div - struct for quotient and remainder
@@ -67,50 +94,99 @@ void UTL_string_copy( S8 *d, const S8 *s )
 ******************************************************************************/
 void UTL_divide( const U32 number, const U32 denom, struct UTL_div_type *UTL_div )
 {
-	U32 sum;
+#ifdef DEV_SYSTEM
+	const U32 UTL_DIV_BITS = 32U;
 
-	sum   = ZERO_CPV;
-	UTL_div->quotient = ZERO_CPV;
+	U32 bit;
+	U32 carry;
+#endif
+
+	UTL_div->quotient  = ZERO_CPV;
+	UTL_div->remainder = ZERO_CPV;
 
 	if( denom > ZERO_CPV )
 	{
-		/* divide denom into number, whilst sum is small enough */
-		do
+#ifdef DEV_SYSTEM
+		/* bring down the bits of number from the top, subtracting denom */
+		/* from the partial remainder whenever it will go                */
+		for( bit=UTL_DIV_BITS; bit>ZERO_CPV; bit-- )
 		{
-			sum += denom;
-			UTL_div->quotient ++;
+			carry = UTL_div->remainder >> (UTL_DIV_BITS - ONE_CPV);
 
-		}while( (sum+denom) <= number );
+			UTL_div->remainder = (UTL_div->remainder << ONE_CPV)
+			                   | ((number >> (bit - ONE_CPV)) & ONE_CPV);
+			UTL_div->quotient <<= ONE_CPV;
 
-		/* check for remainder */
-		if( sum is number )
-		{
-			/* exact divide */
-			UTL_div->remainder = ZERO_CPV;
-		}
-		else if( sum < number )	  
-		{
-			/* find remainder */
-			UTL_div->remainder = number - sum;
-		}
-		else
-		{										  
-			/* sanity check failed */
-			MESS_OUT_message_1( (S8*)"UTL_divide() ", sum, MESSAGE_OP_ERROR ); 
+			if( (carry is_not ZERO_CPV) or (UTL_div->remainder >= denom) )
+			{
+				UTL_div->remainder -= denom;
+				UTL_div->quotient  |= ONE_CPV;
+			}
 		}
+#else
+		UTL_div->quotient  = number / denom;
+		UTL_div->remainder = number % denom;
+#endif
 	}
 	else
 	{
 		/* Division by ZERO */
 		MESS_OUT_message( (S8*)"UTL_divide(): DIVISION BY ZERO", 
 		                  MESSAGE_OP_ERROR );
-		UTL_div->quotient  = ZERO_CPV;
-		UTL_div->remainder = ZERO_CPV;
 	}
 
 } /* UTL_divide() */
 
 
+/******************************************************************************
+*  Function    : UTL_format_dec
+*  Description : writes an unsigned decimal number into a buffer, padded on
+*                the left to the width. Takes the place of sprintf() "%u",
+*                "%5u" and "%05u", which the Keil package does not have.
+*  Parameters  : buffer - where the number goes, at least width + 1 and
+*                         UTL_MAX_DIGITS + 1 characters
+*                num    - number to write
+*                width  - least number of characters, 0 for no padding
+*                fill   - padding character, '0' or ' '
+*  Returns     : characters written, not counting the terminating '\0'
+******************************************************************************/
+U32 UTL_format_dec( S8 *buffer, const U32 num, const U32 width, const S8 fill )
+{
+    return( format_number( buffer, num, FALSE, width, fill ) );
+
+} /* UTL_format_dec() */
+
+
+/******************************************************************************
+*  Function    : UTL_format_int
+*  Description : writes a signed decimal number into a buffer, as sprintf()
+*                "%d", "%6d" or "%05d" would. The sign counts towards the
+*                width and goes before zero padding, after space padding.
+*  Parameters  : buffer - where the number goes, at least width + 1 and
+*                         UTL_MAX_DIGITS + 2 characters
+*                num    - number to write
+*                width  - least number of characters, 0 for no padding
+*                fill   - padding character, '0' or ' '
+*  Returns     : characters written, not counting the terminating '\0'
+******************************************************************************/
+U32 UTL_format_int( S8 *buffer, const S32 num, const U32 width, const S8 fill )
+{
+    U32 written;
+
+    if( num < ZERO_CPV )
+    {
+        written = format_number( buffer, ZERO_CPV - (U32)num, TRUE, width, fill );
+    }
+    else
+    {
+        written = format_number( buffer, (U32)num, FALSE, width, fill );
+    }
+
+    return( written );
+
+} /* UTL_format_int() */
+
+
 /******************************************************************************
 *  Function    : UTL_type_report
 *  Description : private helper - outputs report on type sizes
@@ -134,8 +210,99 @@ void UTL_type_report( void )
     MESS_OUT_message_1( (S8*)"boolean            : ", (U32)sizeof( boolean ), MESSAGE_OP_INFO );
     MESS_OUT_message_1( (S8*)"task_type          : ", (U32)sizeof( struct task_type ), MESSAGE_OP_INFO );
     MESS_OUT_message_1( (S8*)"task_type[]        : ", (U32)sizeof( struct task_type[100] ), MESSAGE_OP_INFO );
+    MESS_OUT_message_1( (S8*)"task_stats_type    : ", (U32)sizeof( struct task_stats_type ), MESSAGE_OP_INFO );
     MESS_OUT_message_1( (S8*)"test_case_type     : ", (U32)sizeof( struct test_case_type ), MESSAGE_OP_INFO );
     MESS_OUT_message_1( (S8*)"test_case_type[]   : ", (U32)sizeof( struct test_case_type[MAX_TEST_CASES] ), MESSAGE_OP_INFO );
     MESS_OUT_message(   (S8*)"\n\n", MESSAGE_OP_INFO );
 
 } /* UTL_type_report() */
+
+
+/******************************************************************************
+*                            PRIVATE FUNCTIONS
+******************************************************************************/
+
+
+/******************************************************************************
+*  Function    : format_digits
+*  Description : private helper - writes the digits of a number backwards
+*                from the end of a buffer, two at a time
+*  Parameters  : end - one past the last digit
+*                num - number to write
+*  Returns     : number of digits
+******************************************************************************/
+static U32 format_digits( S8 *end, U32 num )
+{
+    S8 *next = end;
+    U32 pair;
+
+    while( num >= ONE_HUNDRED_CPV )
+    {
+        pair = (num % ONE_HUNDRED_CPV) * TWO_CPV;
+        num /= ONE_HUNDRED_CPV;
+
+        *--next = digit_pairs[pair + ONE_CPV];
+        *--next = digit_pairs[pair];
+    }
+
+    /* one or two digits left */
+    pair = num * TWO_CPV;
+    *--next = digit_pairs[pair + ONE_CPV];
+    if( num >= TEN_CPV )
+    {
+        *--next = digit_pairs[pair];
+    }
+
+    return( (U32)(end - next) );
+
+} /* format_digits() */
+
+
+/******************************************************************************
+*  Function    : format_number
+*  Description : private helper - pads and writes a number for
+*                UTL_format_dec() and UTL_format_int()
+*  Parameters  : buffer    - where the number goes
+*                magnitude - size of the number
+*                negative  - TRUE to put a minus sign in front
+*                width     - least number of characters
+*                fill      - padding character
+*  Returns     : characters written, not counting the terminating '\0'
+******************************************************************************/
+static U32 format_number( S8 *buffer, const U32 magnitude, const boolean negative,
+                          const U32 width, const S8 fill )
+{
+    S8 digits[UTL_MAX_DIGITS];
+    S8 *next = buffer;
+    U32 count;
+    U32 length;
+    U32 index;
+
+    count  = format_digits( &digits[UTL_MAX_DIGITS], magnitude );
+    length = (negative is TRUE) ? count + ONE_CPV : count;
+
+    /* a minus sign goes before zero padding */
+    if( (negative is TRUE) and (fill is '0') )
+    {
+        *next++ = '-';
+    }
+
+    for( index=length; index<width; index++ )
+    {
+        *next++ = fill;
+    }
+
+    if( (negative is TRUE) and (fill is_not '0') )
+    {
+        *next++ = '-';
+    }
+
+    for( index=UTL_MAX_DIGITS - count; index<UTL_MAX_DIGITS; index++ )
+    {
+        *next++ = digits[index];
+    }
+    *next = '\0';
+
+    return( (U32)(next - buffer) );
+
+} /* format_number() */
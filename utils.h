@@ -16,6 +16,7 @@
 * Date     |Aut| Description                                                  *
 * 18-05-05 |JRO| Created                                                      *
 * 30-05-05 |JRO| Added UTL_type_report()                                      *
+* 17-10-26 |JRO| Added UTL_format_dec() and UTL_format_int()                  *
 *          |   |                                                              *
 *                                                                             *
 ******************************************************************************/
@@ -31,5 +32,7 @@ struct UTL_div_type
 void UTL_string_copy( S8 *d, const S8 *s );
 void UTL_divide( const U32 number, const U32 denom, struct UTL_div_type *UTL_div);
 void UTL_type_report( void );
+U32 UTL_format_dec( S8 *buffer, const U32 num, const U32 width, const S8 fill );
+U32 UTL_format_int( S8 *buffer, const S32 num, const U32 width, const S8 fill );
 
 #endif